@@ -30,16 +30,80 @@ INCLUDEPATH += "$$QTSTEREOSCOPY_SRC"
 # Add C++11 support.
 CONFIG += c++11
 
+# Trace zones are compiled out unless 'CONFIG += qtstereoscopy_trace' is set.
+qtstereoscopy_trace: DEFINES += QTSTEREOSCOPY_TRACE
+
+# Heap allocations are counted per frame if 'CONFIG += qtstereoscopy_allocation_counter' is set. This replaces
+# the global operator new in every binary that links QtStereoscopy, so it is never done implicitly.
+qtstereoscopy_allocation_counter: DEFINES += QTSTEREOSCOPY_ALLOCATION_COUNTER
+
 # Add QtStereoscopy's general header and source files.
 HEADERS +=\
    "$$QTSTEREOSCOPY_SRC/qabstractstereodisplay.h"\
    "$$QTSTEREOSCOPY_SRC/qabstractstereorenderer.h"\
    "$$QTSTEREOSCOPY_SRC/qeye.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereoallocationcounter.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereocompositorlayer.h"\
    "$$QTSTEREOSCOPY_SRC/qstereoeyeparameters.h"\
-   "$$QTSTEREOSCOPY_SRC/qstereowindow.h"
+   "$$QTSTEREOSCOPY_SRC/qstereoframecapture.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframesequence.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframestatistics.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframetiming.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereohistogram.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereolatelatch.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereomirrorwindow.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereooffscreensurface.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereoposepredictor.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereoprojectionsettings.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereorenderloop.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereorenderpolicy.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereoreprojection.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereoresourceloader.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereotaskscheduler.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereotextrenderer.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereotrace.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereovideoencoder.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereowindow.h"\
+   "$$QTSTEREOSCOPY_SRC/qstereowindowgroup.h"
 
 SOURCES +=\
    "$$QTSTEREOSCOPY_SRC/qabstractstereodisplay.cpp"\
    "$$QTSTEREOSCOPY_SRC/qabstractstereorenderer.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qabstractstereorenderer_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoallocationcounter.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereocompositorlayer.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereocompositorlayer_p.cpp"\
    "$$QTSTEREOSCOPY_SRC/qstereoeyeparameters.cpp"\
-   "$$QTSTEREOSCOPY_SRC/qstereoeyeparameters_p.cpp"
+   "$$QTSTEREOSCOPY_SRC/qstereoeyeparameters_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframecapture.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframecapture_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframestatistics.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframestatistics_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframetiming.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoframetiming_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereohistogram.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereohistogram_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereolatelatch.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereolatelatch_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoposepredictor.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoposepredictor_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoprojectionsettings.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoprojectionsettings_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereorenderloop.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereorenderloop_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoreprojection.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoreprojection_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoresourceloader.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereoresourceloader_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereotaskscheduler.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereotaskscheduler_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereotextrenderer.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereotextrenderer_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereotrace.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereotrace_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereomirrorwindow.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereomirrorwindow_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereovideoencoder.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereovideoencoder_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereowindowgroup.cpp"\
+   "$$QTSTEREOSCOPY_SRC/qstereowindowgroup_p.cpp"
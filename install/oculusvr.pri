@@ -67,11 +67,14 @@ INCLUDEPATH += "$$QTSTEREOSCOPY_SRC/oculusvr/"
 
 HEADERS +=\
    "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusrift.h"\
+   "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusriftqualitygovernor.h"\
    "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusriftrenderer.h"
 
 SOURCES +=\
    "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusrift.cpp"\
    "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusrift_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusriftqualitygovernor.cpp"\
+   "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusriftqualitygovernor_p.cpp"\
    "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusriftrenderer.cpp"\
    "$$QTSTEREOSCOPY_SRC/oculusvr/qoculusriftrenderer_p.cpp"
 }
@@ -0,0 +1,38 @@
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2014 Jeremy Othieno.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# Common build configurations.
+include("$$PWD/common.pri")
+
+# The simulated display backend only depends on Qt, and can be built on any machine.
+INCLUDEPATH += "$$QTSTEREOSCOPY_SRC/simulated/"
+
+HEADERS +=\
+   "$$QTSTEREOSCOPY_SRC/simulated/qsimulatedstereodisplay.h"\
+   "$$QTSTEREOSCOPY_SRC/simulated/qsimulatedstereorenderer.h"
+
+SOURCES +=\
+   "$$QTSTEREOSCOPY_SRC/simulated/qsimulatedstereodisplay.cpp"\
+   "$$QTSTEREOSCOPY_SRC/simulated/qsimulatedstereodisplay_p.cpp"\
+   "$$QTSTEREOSCOPY_SRC/simulated/qsimulatedstereorenderer.cpp"\
+   "$$QTSTEREOSCOPY_SRC/simulated/qsimulatedstereorenderer_p.cpp"
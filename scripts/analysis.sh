@@ -123,7 +123,9 @@ then
       && $MAKE $MAKEFLAGS -C "$EXAMPLESDIR"\
       && $QMAKE "$UNITTESTSDIR" -o "$UNITTESTSDIR/Makefile"\
       && $MAKE $MAKEFLAGS -C "$UNITTESTSDIR"\
-      && "$UNITTESTSDIR/oculusvr_testsuite/build/oculusvr_testsuite"
+      && "$UNITTESTSDIR/stereoscopy_testsuite/build/stereoscopy_testsuite"\
+      && "$UNITTESTSDIR/oculusvr_testsuite/build/oculusvr_testsuite"\
+      && "$UNITTESTSDIR/simulated_testsuite/build/simulated_testsuite"
    }
 
    if [[ "$VERBOSE" = false ]]; then do_runtime_tests > /dev/null && echo "done"; else do_runtime_tests; fi
@@ -136,7 +138,8 @@ then
    BENCHMARKDIR="$BASEDIR/test/benchmark"
    $QMAKE "$BENCHMARKDIR" -o "$BENCHMARKDIR/Makefile"\
    && $MAKE $MAKEFLAGS -C "$BENCHMARKDIR"\
-   && "$BENCHMARKDIR/oculusvr_benchmarks/build/oculusvr_benchmarks"
+   && "$BENCHMARKDIR/oculusvr_benchmarks/build/oculusvr_benchmarks"\
+   && "$BENCHMARKDIR/simulated_benchmarks/build/simulated_benchmarks"
 fi
 
 exit 0
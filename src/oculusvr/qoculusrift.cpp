@@ -251,6 +251,36 @@ QOculusRift::headPosition() const
 }
 
 
+QStereoPosePredictor::Pose
+QOculusRift::predictHeadPose(const double& time) const
+{
+   Q_D(const QOculusRift);
+   d->recordHeadPose();
+
+   // Only the degrees of freedom that are currently tracked are predicted.
+   auto pose = d->posePredictor().predict(time);
+   if (!orientationTrackingEnabled())
+   {
+      pose.orientation = QQuaternion(1.0, 0.0, 0.0, 0.0);
+      pose.angularVelocity = QVector3D(0, 0, 0);
+   }
+   if (!positionalTrackingEnabled())
+   {
+      pose.position = QVector3D(0, 0, 0);
+      pose.linearVelocity = QVector3D(0, 0, 0);
+   }
+   return pose;
+}
+
+
+QStereoPosePredictor&
+QOculusRift::posePredictor()
+{
+   Q_D(QOculusRift);
+   return d->posePredictor();
+}
+
+
 QOculusRift::TrackingFrustum
 QOculusRift::positionalTrackingFrustum() const
 {
@@ -348,6 +378,15 @@ QOculusRift::enableLatencyTesting(const bool enable)
 }
 
 
+QString
+QOculusRift::latencyTestResult() const
+{
+   // The SDK returns a null pointer when there is no new result to report.
+   const auto* const result = ovrHmd_GetLatencyTestResult(*this);
+   return result != nullptr ? QString(result) : QString();
+}
+
+
 bool
 QOculusRift::dynamicPredictionEnabled() const
 {
@@ -25,6 +25,7 @@
 #define QOCULUSRIFT_H
 
 #include "qabstractstereodisplay.h"
+#include "qstereoposepredictor.h"
 #include <OVR_CAPI.h>
 
 
@@ -80,6 +81,9 @@ public:
    QVector3D headPosition() const Q_DECL_OVERRIDE Q_DECL_FINAL;
    TrackingFrustum positionalTrackingFrustum() const;
 
+   QStereoPosePredictor::Pose predictHeadPose(const double& time) const;
+   QStereoPosePredictor& posePredictor();
+
    bool eyeTrackingAvailable() const Q_DECL_OVERRIDE Q_DECL_FINAL;
    bool eyeTrackingEnabled(const QEye& eye) const Q_DECL_OVERRIDE Q_DECL_FINAL;
    void enableEyeTracking(const QEye& eye, const bool enable) Q_DECL_OVERRIDE Q_DECL_FINAL;
@@ -93,6 +97,7 @@ public:
 
    bool latencyTestingEnabled() const;
    void enableLatencyTesting(const bool enable = true);
+   QString latencyTestResult() const;
 
    bool dynamicPredictionEnabled() const;
    void enableDynamicPrediction(const bool enable = true);
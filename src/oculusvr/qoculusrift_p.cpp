@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  */
 #include "qoculusrift_p.h"
+#include "qstereotrace.h"
 #if defined(Q_OS_LINUX)
 #define OVR_OS_LINUX
 #elif defined(Q_OS_MAC)
@@ -145,6 +146,48 @@ QOculusRiftPrivate::resetTracking()
 {
    if (trackingAvailable())
       ovrHmd_ResetSensor(handle());
+
+   // Samples recorded before the reset are expressed in a different reference frame.
+   posePredictor_.clear();
+}
+
+
+void
+QOculusRiftPrivate::recordHeadPose() const
+{
+   if (!trackingAvailable())
+      return;
+
+   // The recorded state does not depend on the requested time, which is only used to
+   // compute LibOVR's own predicted state.
+   const auto& state = ovrHmd_GetSensorState(handle(), 0.0);
+   if (!(state.StatusFlags & (ovrStatus_OrientationTracked | ovrStatus_PositionTracked)))
+      return;
+
+   const auto& recorded = state.Recorded;
+   const auto& o = recorded.Pose.Orientation;
+   const auto& p = recorded.Pose.Position;
+   const auto& w = recorded.AngularVelocity;
+   const auto& v = recorded.LinearVelocity;
+
+   QStereoPosePredictor::Pose sample;
+   sample.time = recorded.TimeInSeconds;
+   sample.orientation = QQuaternion(o.w, o.x, o.y, o.z);
+   sample.position = QVector3D(p.x, p.y, p.z);
+   sample.linearVelocity = QVector3D(v.x, v.y, v.z);
+
+   // LibOVR 0.3 reports the angular velocity in the head's frame of reference, whereas the
+   // predictor expects it in the world's.
+   sample.angularVelocity = sample.orientation.rotatedVector(QVector3D(w.x, w.y, w.z));
+
+   posePredictor_.addSample(sample);
+}
+
+
+QStereoPosePredictor&
+QOculusRiftPrivate::posePredictor() const
+{
+   return posePredictor_;
 }
 
 
@@ -203,6 +246,7 @@ QOculusRiftPrivate::isHmdCap(const unsigned int& cap) const
 void
 QOculusRiftPrivate::updateHmdCaps()
 {
+   QSTEREO_TRACE_ZONE("QOculusRift::updateHmdCaps");
    ovrHmd_SetEnabledCaps(descriptor_.Handle, enabledCaps_.hmd);
 }
 
@@ -225,6 +269,8 @@ QOculusRiftPrivate::isTrackingCap(const unsigned int& cap) const
 void
 QOculusRiftPrivate::updateTrackingCaps()
 {
+   QSTEREO_TRACE_ZONE("QOculusRift::updateTrackingCaps");
+
    // If no tracking capabilities are activated, turn off the sensor. If, on the other hand, certain
    // tracking capabilities are set, and tracking is available, configure the sensor appropriately.
    if (trackingAvailable())
@@ -42,6 +42,8 @@ public:
 
    bool trackingAvailable() const;
    void resetTracking();
+   void recordHeadPose() const;
+   QStereoPosePredictor& posePredictor() const;
 
    bool isCapEnabled(const unsigned int& capability) const;
    void setCapEnabled(const unsigned int& capability, const bool enable);
@@ -56,6 +58,7 @@ private:
 
    ovrHmdDesc descriptor_;
    bool isDebugDevice_;
+   mutable QStereoPosePredictor posePredictor_;
    struct
    {
       unsigned int hmd;
@@ -0,0 +1,183 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qoculusriftqualitygovernor.h"
+#include "qoculusriftqualitygovernor_p.h"
+#include "qoculusriftrenderer.h"
+
+
+QOculusRiftQualityGovernor::QOculusRiftQualityGovernor(QOculusRiftRenderer& renderer) :
+QObject(&renderer),
+d_ptr(new QOculusRiftQualityGovernorPrivate(this, renderer))
+{}
+
+
+bool
+QOculusRiftQualityGovernor::enabled() const
+{
+   Q_D(const QOculusRiftQualityGovernor);
+   return d->enabled();
+}
+
+
+void
+QOculusRiftQualityGovernor::enable(const bool enable)
+{
+   Q_D(QOculusRiftQualityGovernor);
+   d->enable(enable);
+}
+
+
+const QVector<QOculusRiftQualityGovernor::Level>&
+QOculusRiftQualityGovernor::levels() const
+{
+   Q_D(const QOculusRiftQualityGovernor);
+   return d->levels();
+}
+
+
+void
+QOculusRiftQualityGovernor::setLevels(const QVector<Level>& levels)
+{
+   Q_D(QOculusRiftQualityGovernor);
+   const auto& previous = d->level();
+   d->setLevels(levels);
+   if (d->level() != previous)
+      emit levelChanged(d->level());
+}
+
+
+const int&
+QOculusRiftQualityGovernor::level() const
+{
+   Q_D(const QOculusRiftQualityGovernor);
+   return d->level();
+}
+
+
+void
+QOculusRiftQualityGovernor::setLevel(const int& level)
+{
+   Q_D(QOculusRiftQualityGovernor);
+   if (d->setLevel(level))
+      emit levelChanged(d->level());
+}
+
+
+double
+QOculusRiftQualityGovernor::frameBudget() const
+{
+   Q_D(const QOculusRiftQualityGovernor);
+   return d->frameBudget();
+}
+
+
+const float&
+QOculusRiftQualityGovernor::downgradeThreshold() const
+{
+   Q_D(const QOculusRiftQualityGovernor);
+   return d->downgradeThreshold();
+}
+
+
+void
+QOculusRiftQualityGovernor::setDowngradeThreshold(const float& threshold)
+{
+   Q_D(QOculusRiftQualityGovernor);
+   d->setDowngradeThreshold(threshold);
+}
+
+
+const float&
+QOculusRiftQualityGovernor::upgradeThreshold() const
+{
+   Q_D(const QOculusRiftQualityGovernor);
+   return d->upgradeThreshold();
+}
+
+
+void
+QOculusRiftQualityGovernor::setUpgradeThreshold(const float& threshold)
+{
+   Q_D(QOculusRiftQualityGovernor);
+   d->setUpgradeThreshold(threshold);
+}
+
+
+const unsigned int&
+QOculusRiftQualityGovernor::downgradeFrameCount() const
+{
+   Q_D(const QOculusRiftQualityGovernor);
+   return d->downgradeFrameCount();
+}
+
+
+void
+QOculusRiftQualityGovernor::setDowngradeFrameCount(const unsigned int& count)
+{
+   Q_D(QOculusRiftQualityGovernor);
+   d->setDowngradeFrameCount(count);
+}
+
+
+const unsigned int&
+QOculusRiftQualityGovernor::upgradeFrameCount() const
+{
+   Q_D(const QOculusRiftQualityGovernor);
+   return d->upgradeFrameCount();
+}
+
+
+void
+QOculusRiftQualityGovernor::setUpgradeFrameCount(const unsigned int& count)
+{
+   Q_D(QOculusRiftQualityGovernor);
+   d->setUpgradeFrameCount(count);
+}
+
+
+void
+QOculusRiftQualityGovernor::record(const QStereoFrameTiming::Frame& frame)
+{
+   Q_D(QOculusRiftQualityGovernor);
+   if (d->record(frame))
+      emit levelChanged(d->level());
+}
+
+
+QVector<QOculusRiftQualityGovernor::Level>
+QOculusRiftQualityGovernor::defaultLevels()
+{
+   // From the highest quality to the lowest: multisampling goes first since it is the most expensive
+   // feature relative to its benefit, followed by resolution, chromatic aberration correction and the
+   // vignette. Painting the eyes at half rate is the last resort.
+   return
+   {
+      {1.0f, 4, true,  true,  false},
+      {1.0f, 2, true,  true,  false},
+      {1.0f, 0, true,  true,  false},
+      {0.8f, 0, true,  true,  false},
+      {0.6f, 0, false, true,  false},
+      {0.6f, 0, false, false, true},
+   };
+}
@@ -0,0 +1,86 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QOCULUSRIFTQUALITYGOVERNOR_H
+#define QOCULUSRIFTQUALITYGOVERNOR_H
+
+#include "qstereoframetiming.h"
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOculusRiftRenderer;
+class QOculusRiftQualityGovernorPrivate;
+class QOculusRiftQualityGovernor : public QObject
+{
+   Q_OBJECT
+public:
+   struct Level
+   {
+      float pixelDensity;
+      unsigned int sampleCount;
+      bool chromaticAberrationCorrection;
+      bool vignette;
+      bool halfRateEyes;
+   };
+
+   explicit QOculusRiftQualityGovernor(QOculusRiftRenderer& renderer);
+
+   bool enabled() const;
+   void enable(const bool enable = true);
+
+   const QVector<Level>& levels() const;
+   void setLevels(const QVector<Level>& levels);
+
+   const int& level() const;
+   void setLevel(const int& level);
+
+   double frameBudget() const;
+
+   const float& downgradeThreshold() const;
+   void setDowngradeThreshold(const float& threshold);
+
+   const float& upgradeThreshold() const;
+   void setUpgradeThreshold(const float& threshold);
+
+   const unsigned int& downgradeFrameCount() const;
+   void setDowngradeFrameCount(const unsigned int& count);
+
+   const unsigned int& upgradeFrameCount() const;
+   void setUpgradeFrameCount(const unsigned int& count);
+
+   void record(const QStereoFrameTiming::Frame& frame);
+
+   static QVector<Level> defaultLevels();
+signals:
+   void levelChanged(const int& level);
+private:
+   QOculusRiftQualityGovernorPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QOculusRiftQualityGovernor);
+};
+
+QT_END_NAMESPACE
+
+#endif // QOCULUSRIFTQUALITYGOVERNOR_H
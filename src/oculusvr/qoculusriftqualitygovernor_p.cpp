@@ -0,0 +1,308 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qoculusriftqualitygovernor_p.h"
+#include "qoculusriftrenderer.h"
+#include <QtCore/QThread>
+#include <QtCore/QTimerEvent>
+#include <algorithm>
+
+
+QOculusRiftQualityGovernorPrivate::QOculusRiftQualityGovernorPrivate
+(
+   QOculusRiftQualityGovernor* const parent,
+   QOculusRiftRenderer& renderer
+) :
+QObject(parent),
+governor_(*parent),
+renderer_(renderer),
+levels_(QOculusRiftQualityGovernor::defaultLevels()),
+level_(0),
+enabled_(true),
+downgradeThreshold_(0.9f),
+upgradeThreshold_(0.7f),
+downgradeFrameCount_(5),
+upgradeFrameCount_(90),
+framesOverBudget_(0),
+framesUnderBudget_(0),
+settling_(std::make_shared<Settling>()),
+handOverHead_(0),
+handOverTail_(0)
+{
+   settling_->pendingLevelCount = 0;
+   settling_->frameIndex = 0;
+
+   // Frames are measured as soon as their timing is available. When the renderer renders on a thread of its
+   // own, frames are handed over to this thread and collected periodically, since a queued connection would
+   // allocate an event for every frame on the render thread.
+   QObject::connect(renderer_.frameTiming(), &QStereoFrameTiming::frameTimingAvailable, this, [this](const QStereoFrameTiming::Frame& frame)
+   {
+      if (QThread::currentThread() == thread())
+         governor_.record(frame);
+      else
+         handOver(frame);
+   }, Qt::DirectConnection);
+   collectTimer_.start(std::max(1, static_cast<int>(1000.0 * frameBudget())), this);
+   apply();
+}
+
+
+bool
+QOculusRiftQualityGovernorPrivate::enabled() const
+{
+   return enabled_;
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::enable(const bool enable)
+{
+   if (enabled_ != enable)
+   {
+      enabled_ = enable;
+      resetCounters();
+      if (enabled_)
+         apply();
+   }
+}
+
+
+const QVector<QOculusRiftQualityGovernor::Level>&
+QOculusRiftQualityGovernorPrivate::levels() const
+{
+   return levels_;
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::setLevels(const QVector<QOculusRiftQualityGovernor::Level>& levels)
+{
+   if (levels.isEmpty())
+   {
+      qWarning("[QtStereoscopy] Warning: A quality governor requires at least one level.");
+      return;
+   }
+   levels_ = levels;
+   level_ = std::min(level_, levels_.size() - 1);
+   resetCounters();
+   if (enabled_)
+      apply();
+}
+
+
+const int&
+QOculusRiftQualityGovernorPrivate::level() const
+{
+   return level_;
+}
+
+
+bool
+QOculusRiftQualityGovernorPrivate::setLevel(const int& level)
+{
+   const auto& l = std::max(0, std::min(level, levels_.size() - 1));
+   if (level_ == l)
+      return false;
+
+   level_ = l;
+   resetCounters();
+   if (enabled_)
+      apply();
+
+   return true;
+}
+
+
+double
+QOculusRiftQualityGovernorPrivate::frameBudget() const
+{
+   return 1.0 / renderer_.const_display().refreshRate();
+}
+
+
+const float&
+QOculusRiftQualityGovernorPrivate::downgradeThreshold() const
+{
+   return downgradeThreshold_;
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::setDowngradeThreshold(const float& threshold)
+{
+   downgradeThreshold_ = std::max(threshold, 0.0f);
+}
+
+
+const float&
+QOculusRiftQualityGovernorPrivate::upgradeThreshold() const
+{
+   return upgradeThreshold_;
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::setUpgradeThreshold(const float& threshold)
+{
+   upgradeThreshold_ = std::max(threshold, 0.0f);
+}
+
+
+const unsigned int&
+QOculusRiftQualityGovernorPrivate::downgradeFrameCount() const
+{
+   return downgradeFrameCount_;
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::setDowngradeFrameCount(const unsigned int& count)
+{
+   downgradeFrameCount_ = std::max(count, 1u);
+}
+
+
+const unsigned int&
+QOculusRiftQualityGovernorPrivate::upgradeFrameCount() const
+{
+   return upgradeFrameCount_;
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::setUpgradeFrameCount(const unsigned int& count)
+{
+   upgradeFrameCount_ = std::max(count, 1u);
+}
+
+
+bool
+QOculusRiftQualityGovernorPrivate::record(const QStereoFrameTiming::Frame& frame)
+{
+   // Frames that were begun before the current level was applied say nothing about it, and are skipped. Settings
+   // that reconfigure the renderer are staged, and only apply from the renderer's configuration frame onwards.
+   if (!enabled_ || settling_->pendingLevelCount > 0)
+      return false;
+   if (frame.index < settling_->frameIndex || frame.index < renderer_.configurationFrameIndex())
+      return false;
+
+   // A frame's load is the share of the refresh interval taken by the busier of the CPU and GPU, since
+   // either one can make the frame miss its deadline. Values that weren't recorded are negative.
+   double cpuTime = 0.0;
+   if (frame.beginFrameTime >= 0.0 && frame.endFrameTime >= 0.0)
+      cpuTime = frame.endFrameTime - frame.beginFrameTime;
+
+   double gpuTime = 0.0;
+   for (const auto& duration : frame.eyeGpuDuration)
+   {
+      if (duration > 0.0)
+         gpuTime += duration;
+   }
+   const auto& load = std::max(cpuTime, gpuTime) / frameBudget();
+
+   // The level only changes after several consecutive frames agree, so that a single spike doesn't lower
+   // the quality, and the quality is only raised back when there is enough headroom for it.
+   if (frame.droppedFrames > 0 || load > downgradeThreshold_)
+   {
+      framesUnderBudget_ = 0;
+      if (++framesOverBudget_ >= downgradeFrameCount_)
+         return setLevel(level_ + 1);
+   }
+   else if (load < upgradeThreshold_)
+   {
+      framesOverBudget_ = 0;
+      if (++framesUnderBudget_ >= upgradeFrameCount_)
+         return setLevel(level_ - 1);
+   }
+   else
+      resetCounters();
+
+   return false;
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::handOver(const QStereoFrameTiming::Frame& frame)
+{
+   const auto& head = handOverHead_.load(std::memory_order_relaxed);
+   if (head - handOverTail_.load(std::memory_order_acquire) >= handOverCapacity())
+      return;
+
+   handedOverFrames_[head % handOverCapacity()] = frame;
+   handOverHead_.store(head + 1, std::memory_order_release);
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::collect()
+{
+   const auto& head = handOverHead_.load(std::memory_order_acquire);
+   for (auto tail = handOverTail_.load(std::memory_order_relaxed); tail < head; ++tail)
+   {
+      // The frame is copied out before its slot is released to the render thread.
+      const auto frame = handedOverFrames_[tail % handOverCapacity()];
+      handOverTail_.store(tail + 1, std::memory_order_release);
+      governor_.record(frame);
+   }
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::timerEvent(QTimerEvent* const event)
+{
+   if (event->timerId() == collectTimer_.timerId())
+      collect();
+   else
+      QObject::timerEvent(event);
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::apply()
+{
+   // The renderer may be rendered on a thread of its own, so the level is applied there, before the next frame
+   // begins, and its settings take effect from that frame onwards. Frames are not measured in the meantime.
+   const auto& level = levels_[level_];
+   auto* const renderer = &renderer_;
+   const auto& settling = settling_;
+   ++settling->pendingLevelCount;
+   renderer_.invokeOnRenderThread([renderer, level, settling]
+   {
+      renderer->setPixelDensity(level.pixelDensity);
+      renderer->setSampleCount(level.sampleCount);
+      renderer->enableChromaticAberrationCorrection(level.chromaticAberrationCorrection);
+      renderer->enableVignette(level.vignette);
+      renderer->enableHalfRateEyes(level.halfRateEyes);
+
+      settling->frameIndex = renderer->frameTiming()->frameCount();
+      --settling->pendingLevelCount;
+   });
+}
+
+
+void
+QOculusRiftQualityGovernorPrivate::resetCounters()
+{
+   framesOverBudget_ = 0;
+   framesUnderBudget_ = 0;
+}
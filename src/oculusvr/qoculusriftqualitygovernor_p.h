@@ -0,0 +1,109 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QOCULUSRIFTQUALITYGOVERNOR_P_H
+#define QOCULUSRIFTQUALITYGOVERNOR_P_H
+
+#include "qoculusriftqualitygovernor.h"
+#include <QtCore/QBasicTimer>
+#include <array>
+#include <atomic>
+#include <memory>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOculusRiftQualityGovernorPrivate : public QObject
+{
+public:
+   QOculusRiftQualityGovernorPrivate(QOculusRiftQualityGovernor* const parent, QOculusRiftRenderer& renderer);
+
+   bool enabled() const;
+   void enable(const bool enable);
+
+   const QVector<QOculusRiftQualityGovernor::Level>& levels() const;
+   void setLevels(const QVector<QOculusRiftQualityGovernor::Level>& levels);
+
+   const int& level() const;
+   bool setLevel(const int& level);
+
+   double frameBudget() const;
+
+   const float& downgradeThreshold() const;
+   void setDowngradeThreshold(const float& threshold);
+
+   const float& upgradeThreshold() const;
+   void setUpgradeThreshold(const float& threshold);
+
+   const unsigned int& downgradeFrameCount() const;
+   void setDowngradeFrameCount(const unsigned int& count);
+
+   const unsigned int& upgradeFrameCount() const;
+   void setUpgradeFrameCount(const unsigned int& count);
+
+   bool record(const QStereoFrameTiming::Frame& frame);
+   void handOver(const QStereoFrameTiming::Frame& frame);
+
+   static Q_DECL_CONSTEXPR unsigned int handOverCapacity(){ return 32; }
+protected:
+   void timerEvent(QTimerEvent* const event) Q_DECL_OVERRIDE;
+private:
+   // Levels are applied on the render thread, which the governor's state is shared with until they are.
+   struct Settling
+   {
+      std::atomic<unsigned int> pendingLevelCount;
+      std::atomic<quint64> frameIndex;
+   };
+
+   void apply();
+   void resetCounters();
+   void collect();
+
+   QOculusRiftQualityGovernor& governor_;
+   QOculusRiftRenderer& renderer_;
+   QVector<QOculusRiftQualityGovernor::Level> levels_;
+   int level_;
+   bool enabled_;
+
+   float downgradeThreshold_;
+   float upgradeThreshold_;
+   unsigned int downgradeFrameCount_;
+   unsigned int upgradeFrameCount_;
+
+   unsigned int framesOverBudget_;
+   unsigned int framesUnderBudget_;
+   std::shared_ptr<Settling> settling_;
+
+   // Frames that are published on another thread are handed over through a preallocated ring, which only
+   // the render thread writes to and only the governor's thread reads from. The head counts every frame
+   // ever handed over while the tail counts those that were collected. Frames are dropped when the ring is
+   // full, rather than allocated for.
+   std::array<QStereoFrameTiming::Frame, 32> handedOverFrames_;
+   std::atomic<quint64> handOverHead_;
+   std::atomic<quint64> handOverTail_;
+   QBasicTimer collectTimer_;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOCULUSRIFTQUALITYGOVERNOR_P_H
@@ -23,7 +23,9 @@
  */
 #include "qoculusriftrenderer.h"
 #include "qoculusriftrenderer_p.h"
+#include "qstereotrace.h"
 #include <QtGui/QWindow>
+#include <algorithm>
 #include <OVR_CAPI_GL.h>
 
 
@@ -35,31 +37,52 @@ d_ptr(new QOculusRiftRendererPrivate(this, index, forceDebugDevice))
 void
 QOculusRiftRenderer::apply()
 {
-   Q_D(QOculusRiftRenderer);
+   QSTEREO_TRACE_ZONE("QOculusRiftRenderer::apply");
+   renderFrame<QStereoDynamicRenderPolicy>([this](const QStereoEyeParameters& parameters, const float& dt)
+   {
+      paintGL(parameters, dt);
+   });
+}
 
-   // Make sure there're no "dirty" rendering configurations before rendering is performed.
-   d->configureGL();
 
-   auto& display = d->display();
+float
+QOculusRiftRenderer::beginFrame(const bool timed, const std::array<bool, 2>& excludedEyes)
+{
+   Q_D(QOculusRiftRenderer);
+   const auto& dt = d->beginFrame(timed, excludedEyes);
 
-   const auto& frameTiming = ovrHmd_BeginFrame(display, 0);
+   prepareEyes(d->predictedEyeParameters(), dt);
+   d->refreshLayers();
    d->bindFBO();
 
-   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-   for (const auto& eye : display.descriptor().EyeRenderOrder)
-   {
-      const auto& pose = ovrHmd_BeginEyeRender(display, eye);
-      const auto& parameters = d->eyeParameters(eye, pose);
+   return dt;
+}
 
-      paintGL(parameters, frameTiming.DeltaSeconds);
 
-      ovrHmd_EndEyeRender(display, eye, pose, &d->eyeTextureConfiguration(eye).Texture);
-   }
+const QStereoEyeParameters&
+QOculusRiftRenderer::beginEye(const QEye& eye, double& predictedLatency)
+{
+   Q_D(QOculusRiftRenderer);
+   return d->beginEye(static_cast<ovrEyeType>(eye), predictedLatency);
+}
 
-   d->releaseFBO();
-   ovrHmd_EndFrame(display);
+
+void
+QOculusRiftRenderer::endEye(const QEye& eye, const bool lateLatched)
+{
+   Q_D(QOculusRiftRenderer);
+   d->endEye(static_cast<ovrEyeType>(eye), lateLatched);
+}
+
+
+void
+QOculusRiftRenderer::endFrame(const bool timed, const bool lateLatched)
+{
+   Q_D(QOculusRiftRenderer);
+   d->endFrame(timed, lateLatched);
 
    // TODO Remove this block when ovrHmd_EndFrame cleans up after itself correctly.
+   if (!d->isOffscreen())
    {
       glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
       glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -68,15 +91,65 @@ QOculusRiftRenderer::apply()
 }
 
 
+bool
+QOculusRiftRenderer::eyePainted(const QEye& eye) const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->eyePainted(static_cast<ovrEyeType>(eye));
+}
+
+
+QEye
+QOculusRiftRenderer::eyeRenderOrder(const unsigned int& i) const
+{
+   Q_D(const QOculusRiftRenderer);
+   return static_cast<QEye>(d->const_display().descriptor().EyeRenderOrder[i]);
+}
+
+
 void
 QOculusRiftRenderer::swapBuffers(QOpenGLContext&, QSurface&)
 {}
 
 
 void
-QOculusRiftRenderer::ignoreEyeUpdates(const QEye&, const bool)
+QOculusRiftRenderer::ignoreEyeUpdates(const QEye& eye, const bool freeze)
+{
+   checkRenderThread("QOculusRiftRenderer::ignoreEyeUpdates");
+   Q_D(QOculusRiftRenderer);
+   d->ignoreEyeUpdates(static_cast<ovrEyeType>(eye), freeze);
+}
+
+
+const QOpenGLFramebufferObject*
+QOculusRiftRenderer::framebufferObject() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->framebufferObject(ovrEye_Left);
+}
+
+
+const QOpenGLFramebufferObject*
+QOculusRiftRenderer::framebufferObject(const QEye& eye) const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->framebufferObject(static_cast<ovrEyeType>(eye));
+}
+
+
+QStereoFrameTiming*
+QOculusRiftRenderer::frameTiming()
+{
+   Q_D(QOculusRiftRenderer);
+   return &d->frameTiming();
+}
+
+
+QStereoFrameStatistics*
+QOculusRiftRenderer::frameStatistics()
 {
-   qCritical("[QtStereoscopy] Implement QOculusRiftRenderer::ignoreEyeUpdates.");
+   Q_D(QOculusRiftRenderer);
+   return &d->frameStatistics();
 }
 
 
@@ -100,15 +173,279 @@ const float&
 QOculusRiftRenderer::pixelDensity() const
 {
    Q_D(const QOculusRiftRenderer);
-   return d->pixelDensity();
+   return std::max(d->pixelDensity(ovrEye_Left), d->pixelDensity(ovrEye_Right));
+}
+
+
+const float&
+QOculusRiftRenderer::pixelDensity(const QEye& eye) const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->pixelDensity(static_cast<ovrEyeType>(eye));
 }
 
 
 void
 QOculusRiftRenderer::setPixelDensity(const float& density)
+{
+   checkRenderThread("QOculusRiftRenderer::setPixelDensity");
+   Q_D(QOculusRiftRenderer);
+   d->setPixelDensity(ovrEye_Left, density);
+   d->setPixelDensity(ovrEye_Right, density);
+}
+
+
+void
+QOculusRiftRenderer::setPixelDensity(const QEye& eye, const float& density)
+{
+   checkRenderThread("QOculusRiftRenderer::setPixelDensity");
+   Q_D(QOculusRiftRenderer);
+   d->setPixelDensity(static_cast<ovrEyeType>(eye), density);
+}
+
+
+const ovrFovPort&
+QOculusRiftRenderer::fov(const QEye& eye) const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->fov(static_cast<ovrEyeType>(eye));
+}
+
+
+void
+QOculusRiftRenderer::setFov(const QEye& eye, const ovrFovPort& fov)
+{
+   checkRenderThread("QOculusRiftRenderer::setFov");
+   Q_D(QOculusRiftRenderer);
+   d->setFov(static_cast<ovrEyeType>(eye), fov);
+}
+
+
+bool
+QOculusRiftRenderer::separateEyeTargetsEnabled() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->separateEyeTargetsEnabled();
+}
+
+
+void
+QOculusRiftRenderer::enableSeparateEyeTargets(const bool enable)
+{
+   checkRenderThread("QOculusRiftRenderer::enableSeparateEyeTargets");
+   Q_D(QOculusRiftRenderer);
+   d->enableSeparateEyeTargets(enable);
+}
+
+
+QStereoProjectionSettings&
+QOculusRiftRenderer::projectionSettings()
+{
+   Q_D(QOculusRiftRenderer);
+   return d->projectionSettings();
+}
+
+
+bool
+QOculusRiftRenderer::reverseDepthEnabled() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->reverseDepthEnabled();
+}
+
+
+void
+QOculusRiftRenderer::enableReverseDepth(const bool enable)
+{
+   checkRenderThread("QOculusRiftRenderer::enableReverseDepth");
+   Q_D(QOculusRiftRenderer);
+   d->enableReverseDepth(enable);
+}
+
+
+const unsigned int&
+QOculusRiftRenderer::sampleCount() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->sampleCount();
+}
+
+
+void
+QOculusRiftRenderer::setSampleCount(const unsigned int& samples)
+{
+   checkRenderThread("QOculusRiftRenderer::setSampleCount");
+   Q_D(QOculusRiftRenderer);
+   d->setSampleCount(samples);
+}
+
+
+const int&
+QOculusRiftRenderer::reconfigurationDelay() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->reconfigurationDelay();
+}
+
+
+void
+QOculusRiftRenderer::setReconfigurationDelay(const int& msec)
+{
+   checkRenderThread("QOculusRiftRenderer::setReconfigurationDelay");
+   Q_D(QOculusRiftRenderer);
+   d->setReconfigurationDelay(msec);
+}
+
+
+quint64
+QOculusRiftRenderer::configurationFrameIndex() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->configurationFrameIndex();
+}
+
+
+bool
+QOculusRiftRenderer::offscreenStagingEnabled() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->offscreenStagingEnabled();
+}
+
+
+void
+QOculusRiftRenderer::enableOffscreenStaging(const bool enable)
+{
+   checkRenderThread("QOculusRiftRenderer::enableOffscreenStaging");
+   Q_D(QOculusRiftRenderer);
+   d->enableOffscreenStaging(enable);
+}
+
+
+bool
+QOculusRiftRenderer::lateLatchEnabled() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->lateLatchEnabled();
+}
+
+
+void
+QOculusRiftRenderer::enableLateLatch(const bool enable)
+{
+   checkRenderThread("QOculusRiftRenderer::enableLateLatch");
+   Q_D(QOculusRiftRenderer);
+   d->enableLateLatch(enable);
+}
+
+
+QStereoLateLatch&
+QOculusRiftRenderer::lateLatch()
+{
+   Q_D(QOculusRiftRenderer);
+   return d->lateLatch();
+}
+
+
+bool
+QOculusRiftRenderer::reprojectionEnabled() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->reprojectionEnabled();
+}
+
+
+void
+QOculusRiftRenderer::enableReprojection(const bool enable)
+{
+   checkRenderThread("QOculusRiftRenderer::enableReprojection");
+   Q_D(QOculusRiftRenderer);
+   d->enableReprojection(enable);
+}
+
+
+QStereoReprojection&
+QOculusRiftRenderer::reprojection()
 {
    Q_D(QOculusRiftRenderer);
-   d->setPixelDensity(density);
+   return d->reprojection();
+}
+
+
+QStereoPosePredictor*
+QOculusRiftRenderer::offscreenPoses() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->offscreenPoses();
+}
+
+
+void
+QOculusRiftRenderer::setOffscreenPoses(QStereoPosePredictor* const poses)
+{
+   checkRenderThread("QOculusRiftRenderer::setOffscreenPoses");
+   Q_D(QOculusRiftRenderer);
+   d->setOffscreenPoses(poses);
+}
+
+
+bool
+QOculusRiftRenderer::halfRateEyesEnabled() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->halfRateEyesEnabled();
+}
+
+
+void
+QOculusRiftRenderer::enableHalfRateEyes(const bool enable)
+{
+   checkRenderThread("QOculusRiftRenderer::enableHalfRateEyes");
+   Q_D(QOculusRiftRenderer);
+   d->enableHalfRateEyes(enable);
+}
+
+
+void
+QOculusRiftRenderer::addLayer(QStereoCompositorLayer& layer)
+{
+   checkRenderThread("QOculusRiftRenderer::addLayer");
+   Q_D(QOculusRiftRenderer);
+   auto& layers = d->layers();
+   if (layers.contains(&layer))
+      return;
+
+   // A destroyed layer is removed from the renderer, so that the renderer never refers to it.
+   layers.append(&layer);
+   connect(&layer, &QObject::destroyed, d, [d](QObject* const object)
+   {
+      auto& layers = d->layers();
+      const auto& destroyed = [object](QStereoCompositorLayer* const l){ return static_cast<QObject*>(l) == object; };
+      layers.erase(std::remove_if(layers.begin(), layers.end(), destroyed), layers.end());
+   });
+}
+
+
+void
+QOculusRiftRenderer::removeLayer(QStereoCompositorLayer& layer)
+{
+   checkRenderThread("QOculusRiftRenderer::removeLayer");
+   Q_D(QOculusRiftRenderer);
+   auto& layers = d->layers();
+   const auto& i = layers.indexOf(&layer);
+   if (i >= 0)
+   {
+      layers.remove(i);
+      disconnect(&layer, nullptr, d, nullptr);
+   }
+}
+
+
+const QVector<QStereoCompositorLayer*>&
+QOculusRiftRenderer::layers() const
+{
+   Q_D(const QOculusRiftRenderer);
+   return d->layers();
 }
 
 
@@ -123,6 +460,7 @@ QOculusRiftRenderer::chromaticAberrationCorrectionEnabled() const
 void
 QOculusRiftRenderer::enableChromaticAberrationCorrection(const bool enable)
 {
+   checkRenderThread("QOculusRiftRenderer::enableChromaticAberrationCorrection");
    Q_D(QOculusRiftRenderer);
    d->setDistortionCapabilityEnabled(ovrDistortionCap_Chromatic, enable);
 }
@@ -139,6 +477,7 @@ QOculusRiftRenderer::timewarpEnabled() const
 void
 QOculusRiftRenderer::enableTimewarp(const bool enable)
 {
+   checkRenderThread("QOculusRiftRenderer::enableTimewarp");
    Q_D(QOculusRiftRenderer);
    d->setDistortionCapabilityEnabled(ovrDistortionCap_TimeWarp, enable);
 }
@@ -155,6 +494,7 @@ QOculusRiftRenderer::vignetteEnabled() const
 void
 QOculusRiftRenderer::enableVignette(const bool enable)
 {
+   checkRenderThread("QOculusRiftRenderer::enableVignette");
    Q_D(QOculusRiftRenderer);
    d->setDistortionCapabilityEnabled(ovrDistortionCap_Vignette, enable);
 }
@@ -174,6 +514,14 @@ QOculusRiftRenderer::initializeWindow(const WId& winId)
 }
 
 
+void
+QOculusRiftRenderer::initializeOffscreen()
+{
+   Q_D(QOculusRiftRenderer);
+   d->configureOffscreen();
+}
+
+
 void
 QOculusRiftRenderer::initializeGL()
 {}
@@ -26,8 +26,18 @@
 
 #include "qabstractstereorenderer.h"
 #include "qoculusrift.h"
+#include "qstereocompositorlayer.h"
 #include "qstereoeyeparameters.h"
+#include "qstereoframestatistics.h"
+#include "qstereoframetiming.h"
+#include "qstereolatelatch.h"
+#include "qstereoposepredictor.h"
+#include "qstereoprojectionsettings.h"
+#include "qstereoreprojection.h"
+#include "qstereotrace.h"
+#include <QtCore/QVector>
 #include <OVR_CAPI.h>
+#include <type_traits>
 
 
 QT_BEGIN_NAMESPACE
@@ -41,14 +51,59 @@ public:
    QOculusRiftRenderer(const unsigned int& index = 0, const bool& forceDebugDevice = false);
 
    void apply() Q_DECL_OVERRIDE Q_DECL_FINAL;
+   template<class Renderer, class Policy> void render();
    void swapBuffers(QOpenGLContext&, QSurface&) Q_DECL_OVERRIDE Q_DECL_FINAL;
    void ignoreEyeUpdates(const QEye& eye, const bool freeze = true) Q_DECL_OVERRIDE Q_DECL_FINAL;
+   const QOpenGLFramebufferObject* framebufferObject() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   const QOpenGLFramebufferObject* framebufferObject(const QEye& eye) const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   QStereoFrameTiming* frameTiming() Q_DECL_OVERRIDE Q_DECL_FINAL;
+   QStereoFrameStatistics* frameStatistics() Q_DECL_OVERRIDE Q_DECL_FINAL;
 
    QOculusRift& display();
    const QOculusRift& const_display() const;
 
    const float& pixelDensity() const;
+   const float& pixelDensity(const QEye& eye) const;
    void setPixelDensity(const float& density);
+   void setPixelDensity(const QEye& eye, const float& density);
+
+   const ovrFovPort& fov(const QEye& eye) const;
+   void setFov(const QEye& eye, const ovrFovPort& fov);
+
+   bool separateEyeTargetsEnabled() const;
+   void enableSeparateEyeTargets(const bool enable = true);
+
+   QStereoProjectionSettings& projectionSettings();
+
+   bool reverseDepthEnabled() const;
+   void enableReverseDepth(const bool enable = true);
+
+   const unsigned int& sampleCount() const;
+   void setSampleCount(const unsigned int& samples);
+
+   const int& reconfigurationDelay() const;
+   void setReconfigurationDelay(const int& msec);
+   quint64 configurationFrameIndex() const;
+   bool offscreenStagingEnabled() const;
+   void enableOffscreenStaging(const bool enable = true);
+
+   bool lateLatchEnabled() const;
+   void enableLateLatch(const bool enable = true);
+   QStereoLateLatch& lateLatch();
+
+   bool reprojectionEnabled() const;
+   void enableReprojection(const bool enable = true);
+   QStereoReprojection& reprojection();
+
+   QStereoPosePredictor* offscreenPoses() const;
+   void setOffscreenPoses(QStereoPosePredictor* const poses);
+
+   bool halfRateEyesEnabled() const;
+   void enableHalfRateEyes(const bool enable = true);
+
+   void addLayer(QStereoCompositorLayer& layer);
+   void removeLayer(QStereoCompositorLayer& layer);
+   const QVector<QStereoCompositorLayer*>& layers() const;
 
    bool chromaticAberrationCorrectionEnabled() const;
    void enableChromaticAberrationCorrection(const bool enable = true);
@@ -61,16 +116,130 @@ public:
 
    static Q_DECL_CONSTEXPR float minPixelDensity(){ return 0.25f; }
    static Q_DECL_CONSTEXPR float maxPixelDensity(){ return 4.00f; }
+   static Q_DECL_CONSTEXPR unsigned int maxSampleCount(){ return 16; }
+   static Q_DECL_CONSTEXPR float minFovTangent(){ return 0.25f; }
 protected:
    void initializeWindow(const WId&) Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void initializeOffscreen() Q_DECL_OVERRIDE Q_DECL_FINAL;
    void initializeGL() Q_DECL_OVERRIDE;
    void configureGL();
    void paintGL(const QStereoEyeParameters&, const float&) Q_DECL_OVERRIDE;
 private:
+   template<class Renderer, class Policy> void render(std::true_type);
+   template<class Renderer, class Policy> void render(std::false_type);
+   template<class Policy, class Paint> void renderFrame(const Paint& paint);
+   template<class Renderer> static auto paint(Renderer& renderer, const QStereoEyeParameters& parameters, const float& dt, int)
+   -> decltype(renderer.Renderer::paintGL(parameters, dt));
+   template<class Renderer> static void paint(Renderer& renderer, const QStereoEyeParameters& parameters, const float& dt, long);
+
+   float beginFrame(const bool timed, const std::array<bool, 2>& excludedEyes);
+   const QStereoEyeParameters& beginEye(const QEye& eye, double& predictedLatency);
+   void endEye(const QEye& eye, const bool lateLatched);
+   void endFrame(const bool timed, const bool lateLatched);
+   bool eyePainted(const QEye& eye) const;
+   QEye eyeRenderOrder(const unsigned int& i) const;
+
    QOculusRiftRendererPrivate* const d_ptr;
    Q_DECLARE_PRIVATE(QOculusRiftRenderer);
 };
 
+
+template<class Renderer, class Policy> void
+QOculusRiftRenderer::render()
+{
+   render<Renderer, Policy>(std::integral_constant<bool, Policy::staticDispatch()>());
+}
+
+
+template<class Renderer, class Policy> void
+QOculusRiftRenderer::render(std::true_type)
+{
+   static_assert(std::is_base_of<QOculusRiftRenderer, Renderer>::value, "Renderer must derive from QOculusRiftRenderer.");
+   QSTEREO_TRACE_ZONE("QOculusRiftRenderer::render");
+
+   auto* const renderer = static_cast<Renderer*>(this);
+   renderFrame<Policy>([renderer](const QStereoEyeParameters& parameters, const float& dt)
+   {
+      paint(*renderer, parameters, dt, 0);
+   });
+}
+
+
+template<class Renderer> auto
+QOculusRiftRenderer::paint(Renderer& renderer, const QStereoEyeParameters& parameters, const float& dt, int)
+-> decltype(renderer.Renderer::paintGL(parameters, dt))
+{
+   // The concrete renderer's paintGL is called directly rather than through the virtual table, which
+   // allows it to be inlined into the frame loop. This requires it to be accessible from this class.
+   renderer.Renderer::paintGL(parameters, dt);
+}
+
+
+template<class Renderer> void
+QOculusRiftRenderer::paint(Renderer& renderer, const QStereoEyeParameters& parameters, const float& dt, long)
+{
+   // A paintGL that the concrete renderer keeps to itself is reached through the virtual table instead.
+   static_cast<QOculusRiftRenderer&>(renderer).paintGL(parameters, dt);
+}
+
+
+template<class Renderer, class Policy> void
+QOculusRiftRenderer::render(std::false_type)
+{
+   apply();
+}
+
+
+template<class Policy, class Paint> void
+QOculusRiftRenderer::renderFrame(const Paint& paint)
+{
+   // Features that are left out of the policy are known at compile time, so their branches disappear.
+   using Feature = QStereoRenderFeature;
+   const auto& lateLatched = Policy::hasFeature(Feature::LateLatch) && lateLatchEnabled();
+   auto& timing = *frameTiming();
+
+   // An eye that is left out of the policy is neither prepared nor painted. It's still submitted like an eye
+   // whose updates are ignored, since the SDK distorts both eyes every frame.
+   const auto& excluded = Policy::eyeCount() < 2;
+   std::array<bool, 2> excludedEyes = {{excluded, excluded}};
+   excludedEyes[static_cast<int>(Policy::eye(0))] = false;
+
+   const auto& dt = beginFrame(Policy::hasFeature(Feature::FrameTiming), excludedEyes);
+   if (lateLatched)
+      lateLatch().beginFrame();
+
+   for (unsigned int i = 0; i < 2; ++i)
+   {
+      // A static policy fixes the eye order, whereas the default policy follows the order the device recommends.
+      const auto& eye = Policy::staticDispatch() ? Policy::eye(i) : eyeRenderOrder(i);
+
+      // An eye whose updates are ignored, that is synthesized from the previous frame, or that is left out of
+      // the policy isn't painted.
+      double predictedLatency = 0.0;
+      const auto& parameters = beginEye(eye, predictedLatency);
+      if (eyePainted(eye))
+      {
+         if (lateLatched)
+         {
+            auto& latch = lateLatch();
+            latch.latch(eye, parameters.view());
+            latch.bind(eye);
+         }
+
+         QSTEREO_TRACE_ZONE(eye == QEye::Left ? "QOculusRiftRenderer::paintGL (left eye)" : "QOculusRiftRenderer::paintGL (right eye)");
+         if (Policy::hasFeature(Feature::FrameTiming))
+            timing.beginEye(eye, predictedLatency);
+
+         paint(parameters, dt);
+
+         if (Policy::hasFeature(Feature::FrameTiming))
+            timing.endEye(eye);
+      }
+      endEye(eye, lateLatched);
+   }
+   endFrame(Policy::hasFeature(Feature::FrameTiming), lateLatched);
+}
+
 QT_END_NAMESPACE
 
 #endif // QOCULUSRIFTRENDERER_H
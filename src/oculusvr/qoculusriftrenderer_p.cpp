@@ -24,10 +24,16 @@
 #include "qoculusriftrenderer.h"
 #include "qoculusriftrenderer_p.h"
 #include "qoculusrift_p.h"
+#include "qstereotrace.h"
 #include <qpa/qplatformnativeinterface.h>
 #include <QtGui/QGuiApplication>
+#include <QtGui/QOpenGLContext>
 #include <QtGui/QOpenGLFramebufferObject>
+#include <QtGui/QOpenGLFunctions_3_2_Core>
 #include <QtGui/QWindow>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #if defined(Q_OS_LINUX)
 #define OVR_OS_LINUX
 #elif defined(Q_OS_MAC)
@@ -38,6 +44,67 @@
 #include <OVR_CAPI_GL.h>
 #include <OVR.h>
 
+// Introduced by OpenGL 4.5 and GL_ARB_clip_control.
+#ifndef GL_LOWER_LEFT
+#define GL_LOWER_LEFT 0x8CA1
+#endif
+#ifndef GL_NEGATIVE_ONE_TO_ONE
+#define GL_NEGATIVE_ONE_TO_ONE 0x935E
+#endif
+#ifndef GL_ZERO_TO_ONE
+#define GL_ZERO_TO_ONE 0x935F
+#endif
+
+
+namespace
+{
+// A framebuffer object with a 32-bit floating-point depth attachment, which QOpenGLFramebufferObjectFormat
+// can't describe. The framebuffer object is created without a depth attachment, and a depth renderbuffer
+// with the same number of samples is attached to it afterwards.
+class FloatDepthFramebufferObject : public QOpenGLFramebufferObject
+{
+public:
+   FloatDepthFramebufferObject(QOpenGLFunctions_3_2_Core& gl, const QSize& size, const QOpenGLFramebufferObjectFormat& format) :
+   QOpenGLFramebufferObject(size, colorFormat(format)),
+   gl_(gl),
+   depth_(0)
+   {
+      if (!isValid())
+         return;
+
+      bind();
+      gl_.glGenRenderbuffers(1, &depth_);
+      gl_.glBindRenderbuffer(GL_RENDERBUFFER, depth_);
+      if (this->format().samples() > 0)
+         gl_.glRenderbufferStorageMultisample(GL_RENDERBUFFER, this->format().samples(), GL_DEPTH_COMPONENT32F, size.width(), size.height());
+      else
+         gl_.glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32F, size.width(), size.height());
+      gl_.glBindRenderbuffer(GL_RENDERBUFFER, 0);
+      gl_.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth_);
+
+      if (gl_.glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+         qFatal("[QtStereoscopy] Error: Could not attach a floating-point depth buffer to the framebuffer object.");
+      release();
+   }
+   ~FloatDepthFramebufferObject()
+   {
+      // The renderbuffer can only be released while a context of its share group is current.
+      if (depth_ != 0 && QOpenGLContext::currentContext() != nullptr)
+         gl_.glDeleteRenderbuffers(1, &depth_);
+   }
+private:
+   static QOpenGLFramebufferObjectFormat colorFormat(const QOpenGLFramebufferObjectFormat& format)
+   {
+      auto color = format;
+      color.setAttachment(QOpenGLFramebufferObject::NoAttachment);
+      return color;
+   }
+
+   QOpenGLFunctions_3_2_Core& gl_;
+   GLuint depth_;
+};
+} // namespace
+
 
 QOculusRiftRendererPrivate::QOculusRiftRendererPrivate
 (
@@ -47,17 +114,45 @@ QOculusRiftRendererPrivate::QOculusRiftRendererPrivate
 ) :
 QObject(parent),
 display_(index, forceDebugDevice),
-fbo_(nullptr),
 fboSizeChanged_(true),
 fboFormatChanged_(true),
+sampleCount_(0),
+sampleCountChanged_(true),
+pendingSampleCount_(0),
+reconfigurationDelay_(100),
+offscreenStagingEnabled_(false),
+configurationFrameIndex_(0),
+lateLatchEnabled_(false),
+lateLatchChanged_(false),
+reprojectionEnabled_(false),
+reprojectionChanged_(false),
 apiConfig_(new ovrGLConfig),
 eyeTextureConfigs_(new ovrGLTexture[ovrEye_Count]),
+projection_(projectionSettings_.snapshot()),
 projectionChanged_({true, true}),
+reverseDepthEnabled_(false),
+reverseDepthChanged_(false),
+gl_(nullptr),
+clipControl_(nullptr),
+depthTestReversed_(false),
 eyeFov_(display_.recommendedFov()),
+eyeRenderingInfo_(),
 eyeRenderingInfoChanged_(true),
+eyeRendered_({false, false}),
+eyePainted_({false, false}),
+eyeReprojected_({false, false}),
+eyeLate_({false, false}),
+eyeExcluded_({false, false}),
+eyeUpdatesIgnored_({false, false}),
+halfRateEyes_(false),
+halfRateEye_(ovrEye_Left),
 enabledDistortionCapabilities_(display_.supportedDistortionCapabilities()),
-pixelDensity_(1.0f),
-forceZeroIPD_(false)
+pixelDensity_({1.0f, 1.0f}),
+separateEyeTargets_(false),
+forceZeroIPD_(false),
+offscreen_(false),
+offscreenPoses_(nullptr),
+offscreenFrameCount_(0)
 {
    if (apiConfig_ == nullptr && eyeTextureConfigs_ == nullptr)
       qFatal("[QtStereoscopy] Error: Could not instantiate a QOculusRiftRenderer.");
@@ -77,6 +172,12 @@ forceZeroIPD_(false)
    // Initialize eye value for each eye parameter.
    for (int i = 0; i < 2; ++i)
       eyeParameters_[i].setEye(static_cast<QEye>(i));
+
+   // Frame statistics are collected from the frame timing, which is therefore enabled by default. Frames are
+   // published on the render thread, which records them directly since the histograms are lock-free. A queued
+   // connection would allocate an event for every frame when rendering on a thread of its own.
+   QObject::connect(&frameTiming_, &QStereoFrameTiming::frameTimingAvailable, &frameStatistics_, &QStereoFrameStatistics::record, Qt::DirectConnection);
+   frameTiming_.enable();
 }
 
 
@@ -94,42 +195,104 @@ QOculusRiftRendererPrivate::configureWindow(QWindow& window)
 
 
 void
+QOculusRiftRendererPrivate::configureOffscreen()
+{
+   offscreen_ = true;
+   eyeRenderingInfoChanged_ = true;
+}
+
+
+const bool&
+QOculusRiftRendererPrivate::isOffscreen() const
+{
+   return offscreen_;
+}
+
+
+bool
 QOculusRiftRendererPrivate::configureGL()
 {
-/*
- * FIXME
-   // Toggle multisampling.
-   const auto& enableMultisampling = isMultisamplingEnabled();
-   auto& multisample = apiConfig_uration->OGL.Header.Multisample;
-   if (static_cast<bool>(multisample) != enableMultisampling)
+   // Whether the framebuffer objects or the rendering configuration were replaced by this call.
+   auto applied = false;
+
+   // Reversing depth swaps the depth attachments for floating-point ones, so framebuffer objects that were
+   // prepared beforehand are discarded, and the eyes' projections are rebuilt.
+   if (reverseDepthChanged_)
+   {
+      if (reverseDepthEnabled_ && !configureReverseDepth())
+         reverseDepthEnabled_ = false;
+
+      for (auto& pending : pendingFbo_)
+         pending.reset();
+      for (auto& pending : pendingMultisampleFbo_)
+         pending.reset();
+      fboFormatChanged_ = true;
+      projectionChanged_ = {true, true};
+      reprojection_.setReverseDepth(reverseDepthEnabled_);
+      reverseDepthChanged_ = false;
+   }
+
+   // A new framebuffer object is allocated, along with its multisampled counterpart, in the frame before
+   // it replaces the current one. This splits the cost of a reconfiguration over two frames, and both eyes
+   // always switch to the new configuration together, at the beginning of a frame.
+   const auto& fboChanged = fboSizeChanged_ || fboFormatChanged_;
+   if (fboChanged && reconfigurationDue())
    {
-      if (enableMultisampling)
+      if (fboCurrent())
       {
-         glEnable(GL_MULTISAMPLE);
-         multisample = 1;
+         // The settings went back to values that give the current layout, so there is nothing to replace.
+         for (auto& pending : pendingFbo_)
+            pending.reset();
+         for (auto& pending : pendingMultisampleFbo_)
+            pending.reset();
+         fboSizeChanged_ = false;
       }
+      else if (fbo_[0] != nullptr && (!offscreen_ || offscreenStagingEnabled_) && !fboPrepared())
+         prepareFBO();
       else
       {
-         glDisable(GL_MULTISAMPLE);
-         multisample = 0;
+         configureFBO();
+         fboSizeChanged_ = false;
+         fboFormatChanged_ = false;
+         applied = true;
       }
-      eyeRenderingInfoChanged_ = true;
    }
-*/
 
+   // The multisampled framebuffer is resolved into the texture that's handed to the SDK, so changing
+   // the sample count doesn't require the rendering configuration to be updated.
+   if (sampleCountChanged_)
+   {
+      configureMultisampleFBO();
+      sampleCountChanged_ = false;
+      applied = true;
+   }
 
-   if (fboSizeChanged_ || fboFormatChanged_)
+   if (lateLatchChanged_)
    {
-      configureFBO();
-      fboSizeChanged_ = false;
-      fboFormatChanged_ = false;
+      if (!lateLatchEnabled_)
+         lateLatch_.destroy();
+      else if (!lateLatch_.create())
+         lateLatchEnabled_ = false;
+      lateLatchChanged_ = false;
    }
 
-   if (eyeRenderingInfoChanged_)
+   if (reprojectionChanged_)
+   {
+      if (!reprojectionEnabled_)
+         reprojection_.destroy();
+      else if (!reprojection_.create())
+         reprojectionEnabled_ = false;
+      reprojectionChanged_ = false;
+   }
+
+   // The rendering configuration is updated along with the framebuffer object it distorts.
+   if (eyeRenderingInfoChanged_ && !fboSizeChanged_ && !fboFormatChanged_ && reconfigurationDue())
    {
       configureRendering();
       eyeRenderingInfoChanged_ = false;
+      applied = true;
    }
+   return applied;
 }
 
 
@@ -147,45 +310,375 @@ QOculusRiftRendererPrivate::const_display() const
 }
 
 
+QStereoFrameTiming&
+QOculusRiftRendererPrivate::frameTiming()
+{
+   return frameTiming_;
+}
+
+
+QStereoFrameStatistics&
+QOculusRiftRendererPrivate::frameStatistics()
+{
+   return frameStatistics_;
+}
+
+
 void
 QOculusRiftRendererPrivate::bindFBO()
 {
-   fbo_->bind();
+   renderFBO(ovrEye_Left).bind();
 }
 
 
 void
 QOculusRiftRendererPrivate::releaseFBO()
 {
-   fbo_->release();
+   if (multisampleFbo_[0] != nullptr)
+   {
+      QSTEREO_TRACE_ZONE("QOculusRiftRenderer::resolveFBO");
+
+      // Only the eye viewports are resolved, since the rest of the texture is never sampled. An eye that was
+      // neither painted nor reprojected this frame keeps its resolved image, onto which its layers were
+      // composited, since the multisampled one doesn't hold them.
+      for (const auto& eye : {ovrEye_Left, ovrEye_Right})
+      {
+         if (!eyePainted_[eye] && !eyeReprojected_[eye])
+            continue;
+
+         const auto& target = this->target(eye);
+         const auto& viewport = eyeParameters_[eye].viewport();
+         QOpenGLFramebufferObject::blitFramebuffer(fbo_[target].data(), viewport, multisampleFbo_[target].data(), viewport, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+      }
+   }
+   QOpenGLFramebufferObject::bindDefault();
+}
+
+
+const QOpenGLFramebufferObject*
+QOculusRiftRendererPrivate::framebufferObject(const ovrEyeType& eye) const
+{
+   return fbo_[target(eye)].data();
 }
 
 
 const float&
-QOculusRiftRendererPrivate::pixelDensity() const
+QOculusRiftRendererPrivate::pixelDensity(const ovrEyeType& eye) const
 {
-   return pixelDensity_;
+   return pixelDensity_[eye];
 }
 
 
 void
-QOculusRiftRendererPrivate::setPixelDensity(const float& density)
+QOculusRiftRendererPrivate::setPixelDensity(const ovrEyeType& eye, const float& density)
 {
-   if (!qFuzzyCompare(pixelDensity_, density))
+   auto& eyePixelDensity = pixelDensity_[eye];
+   if (!qFuzzyCompare(eyePixelDensity, density))
    {
       constexpr float MIN = QOculusRiftRenderer::minPixelDensity();
       constexpr float MAX = QOculusRiftRenderer::maxPixelDensity();
 
-      pixelDensity_ =
+      eyePixelDensity =
       density < MIN ? MIN :
       density > MAX ? MAX : density;
 
       // When the pixel density is changed, the framebuffer object needs to be resized.
       fboSizeChanged_ = true;
+      scheduleReconfiguration();
+   }
+}
+
+
+const ovrFovPort&
+QOculusRiftRendererPrivate::fov(const ovrEyeType& eye) const
+{
+   return eyeFov_[eye];
+}
+
+
+void
+QOculusRiftRendererPrivate::setFov(const ovrEyeType& eye, const ovrFovPort& fov)
+{
+   constexpr float MIN = QOculusRiftRenderer::minFovTangent();
+   const auto& max = display_.maximumFov()[eye];
+   const auto& clamp = [MIN](const float& tangent, const float& max)
+   {
+      return std::min(std::max(tangent, MIN), max);
+   };
+
+   ovrFovPort clamped;
+   clamped.UpTan    = clamp(fov.UpTan,    max.UpTan);
+   clamped.DownTan  = clamp(fov.DownTan,  max.DownTan);
+   clamped.LeftTan  = clamp(fov.LeftTan,  max.LeftTan);
+   clamped.RightTan = clamp(fov.RightTan, max.RightTan);
+
+   auto& eyeFov = eyeFov_[eye];
+   if
+   (
+      !qFuzzyCompare(eyeFov.UpTan,    clamped.UpTan)   ||
+      !qFuzzyCompare(eyeFov.DownTan,  clamped.DownTan) ||
+      !qFuzzyCompare(eyeFov.LeftTan,  clamped.LeftTan) ||
+      !qFuzzyCompare(eyeFov.RightTan, clamped.RightTan)
+   )
+   {
+      // The eye's buffer is resized and the rendering configuration is updated, which in turn recomputes
+      // the projections of the eyes whose rendering information changed.
+      eyeFov = clamped;
+      fboSizeChanged_ = true;
+      eyeRenderingInfoChanged_ = true;
+      scheduleReconfiguration();
+   }
+}
+
+
+bool
+QOculusRiftRendererPrivate::separateEyeTargetsEnabled() const
+{
+   return separateEyeTargets_;
+}
+
+
+void
+QOculusRiftRendererPrivate::enableSeparateEyeTargets(const bool enable)
+{
+   if (separateEyeTargets_ != enable)
+   {
+      separateEyeTargets_ = enable;
+      fboSizeChanged_ = true;
+      scheduleReconfiguration();
    }
 }
 
 
+QStereoProjectionSettings&
+QOculusRiftRendererPrivate::projectionSettings()
+{
+   return projectionSettings_;
+}
+
+
+bool
+QOculusRiftRendererPrivate::reverseDepthEnabled() const
+{
+   return reverseDepthEnabled_;
+}
+
+
+void
+QOculusRiftRendererPrivate::enableReverseDepth(const bool enable)
+{
+   if (reverseDepthEnabled_ != enable)
+   {
+      reverseDepthEnabled_ = enable;
+      reverseDepthChanged_ = true;
+   }
+}
+
+
+const unsigned int&
+QOculusRiftRendererPrivate::sampleCount() const
+{
+   return sampleCount_;
+}
+
+
+void
+QOculusRiftRendererPrivate::setSampleCount(const unsigned int& samples)
+{
+   const auto& count = std::min(samples, QOculusRiftRenderer::maxSampleCount());
+   if (sampleCount_ != count)
+   {
+      sampleCount_ = count;
+      sampleCountChanged_ = true;
+   }
+}
+
+
+const int&
+QOculusRiftRendererPrivate::reconfigurationDelay() const
+{
+   return reconfigurationDelay_;
+}
+
+
+void
+QOculusRiftRendererPrivate::setReconfigurationDelay(const int& msec)
+{
+   reconfigurationDelay_ = std::max(msec, 0);
+}
+
+
+void
+QOculusRiftRendererPrivate::scheduleReconfiguration()
+{
+   reconfigurationClock_.start();
+}
+
+
+bool
+QOculusRiftRendererPrivate::reconfigurationDue() const
+{
+   // Changes are coalesced until none has been made for the duration of the delay, so that a setting
+   // that changes continuously, e.g. from a slider, causes a single reconfiguration when it settles. The
+   // initial configuration and offscreen rendering are never delayed, unless offscreen staging is enabled.
+   return
+   fbo_[0] == nullptr ||
+   (offscreen_ && !offscreenStagingEnabled_) ||
+   !reconfigurationClock_.isValid() ||
+   reconfigurationClock_.elapsed() >= reconfigurationDelay_;
+}
+
+
+bool
+QOculusRiftRendererPrivate::offscreenStagingEnabled() const
+{
+   return offscreenStagingEnabled_;
+}
+
+
+void
+QOculusRiftRendererPrivate::enableOffscreenStaging(const bool enable)
+{
+   offscreenStagingEnabled_ = enable;
+}
+
+
+bool
+QOculusRiftRendererPrivate::reconfigurationPending() const
+{
+   return fboSizeChanged_ || fboFormatChanged_ || sampleCountChanged_ || reverseDepthChanged_ || eyeRenderingInfoChanged_;
+}
+
+
+quint64
+QOculusRiftRendererPrivate::configurationFrameIndex() const
+{
+   return configurationFrameIndex_;
+}
+
+
+bool
+QOculusRiftRendererPrivate::lateLatchEnabled() const
+{
+   return lateLatchEnabled_;
+}
+
+
+void
+QOculusRiftRendererPrivate::enableLateLatch(const bool enable)
+{
+   if (lateLatchEnabled_ != enable)
+   {
+      lateLatchEnabled_ = enable;
+      lateLatchChanged_ = true;
+   }
+}
+
+
+QStereoLateLatch&
+QOculusRiftRendererPrivate::lateLatch()
+{
+   return lateLatch_;
+}
+
+
+bool
+QOculusRiftRendererPrivate::reprojectionEnabled() const
+{
+   return reprojectionEnabled_;
+}
+
+
+void
+QOculusRiftRendererPrivate::enableReprojection(const bool enable)
+{
+   if (reprojectionEnabled_ != enable)
+   {
+      reprojectionEnabled_ = enable;
+      reprojectionChanged_ = true;
+   }
+}
+
+
+QStereoReprojection&
+QOculusRiftRendererPrivate::reprojection()
+{
+   return reprojection_;
+}
+
+
+QStereoPosePredictor*
+QOculusRiftRendererPrivate::offscreenPoses() const
+{
+   return offscreenPoses_;
+}
+
+
+void
+QOculusRiftRendererPrivate::setOffscreenPoses(QStereoPosePredictor* const poses)
+{
+   offscreenPoses_ = poses;
+}
+
+
+bool
+QOculusRiftRendererPrivate::eyeUpdatesIgnored(const ovrEyeType& eye) const
+{
+   return eyeUpdatesIgnored_[eye];
+}
+
+
+void
+QOculusRiftRendererPrivate::ignoreEyeUpdates(const ovrEyeType& eye, const bool ignore)
+{
+   eyeUpdatesIgnored_[eye] = ignore;
+}
+
+
+bool
+QOculusRiftRendererPrivate::eyePainted(const ovrEyeType& eye) const
+{
+   return eyePainted_[eye];
+}
+
+
+bool
+QOculusRiftRendererPrivate::halfRateEyesEnabled() const
+{
+   return halfRateEyes_;
+}
+
+
+void
+QOculusRiftRendererPrivate::enableHalfRateEyes(const bool enable)
+{
+   halfRateEyes_ = enable;
+}
+
+
+QVector<QStereoCompositorLayer*>&
+QOculusRiftRendererPrivate::layers()
+{
+   return layers_;
+}
+
+
+const QVector<QStereoCompositorLayer*>&
+QOculusRiftRendererPrivate::layers() const
+{
+   return layers_;
+}
+
+
+void
+QOculusRiftRendererPrivate::refreshLayers()
+{
+   // Layers are drawn into their own framebuffer objects, so this must happen before the eye buffer is bound.
+   for (auto* const layer : layers_)
+      layer->refresh();
+}
+
+
 bool
 QOculusRiftRendererPrivate::isDistortionCapabilityEnabled(const unsigned int& capability) const
 {
@@ -204,6 +697,7 @@ QOculusRiftRendererPrivate::setDistortionCapabilityEnabled(const unsigned int& c
          enabledDistortionCapabilities_ &= ~capability;
 
       eyeRenderingInfoChanged_ = true;
+      scheduleReconfiguration();
    }
 }
 
@@ -237,9 +731,9 @@ QOculusRiftRendererPrivate::eyeParameters(const ovrEyeType& eye, const ovrPosef&
    if (eyeProjectionChanged)
    {
       const auto& fov = eyeRenderInfo.Fov;
-      const auto& znear = QStereoEyeParameters::nearClippingDistance();
-      const auto& zfar = QStereoEyeParameters::farClippingDistance();
-      const auto& orthoDistance = QStereoEyeParameters::orthoDistance();
+      const auto& znear = projection_.nearClippingDistance;
+      const auto& zfar = projection_.farClippingDistance;
+      const auto& orthoDistance = projection_.orthoDistance;
       const auto& orthoScale = OVR::Vector2f(1.0f) / OVR::Vector2f(eyeRenderInfo.PixelsPerTanAngleAtCenter);
       const auto& ovrPerspective = ovrMatrix4f_Projection(fov, znear, zfar, true);
       const auto& ovrOrtho = ovrMatrix4f_OrthoSubProjection(ovrPerspective, orthoScale, orthoDistance, eyeViewAdjust.x());
@@ -256,58 +750,563 @@ QOculusRiftRendererPrivate::eyeParameters(const ovrEyeType& eye, const ovrPosef&
          perspective.setRow(i, QVector4D(P[0], P[1], P[2], P[3]));
          ortho.setRow(i, QVector4D(O[0], O[1], O[2], O[3]));
       }
+
+      // With reverse depth, the near plane is mapped to a depth of 1 and the far plane is moved to infinity,
+      // which is mapped to 0. Floating-point depth is most precise close to 0, which makes up for the
+      // perspective division's loss of precision at a distance. The orthogonal projection's depth would then
+      // be that of infinity, so overlays are placed at the perspective depth of the ortho distance instead.
+      if (reverseDepthEnabled_)
+      {
+         perspective.setRow(2, QVector4D(0.0f, 0.0f, 0.0f, znear));
+         perspective.setRow(3, QVector4D(0.0f, 0.0f, -1.0f, 0.0f));
+         ortho.setRow(2, QVector4D(0.0f, 0.0f, 0.0f, znear / orthoDistance));
+      }
       eyeProjectionChanged = false;
    }
    return eyeParams;
 }
 
 
+float
+QOculusRiftRendererPrivate::beginFrame(const bool timed, const std::array<bool, ovrEye_Count>& excludedEyes)
+{
+   // Make sure there're no "dirty" rendering configurations before rendering is performed. Changes that
+   // are delayed or staged over two frames leave the reconfiguration pending, and the first frame that
+   // begins with nothing pending, after a change was applied or while one was pending, is the first one
+   // to be rendered with every change applied. A change may well be applied within a single call, e.g.
+   // offscreen, or once its delay has already elapsed.
+   const auto& applied = configureGL();
+   if (reconfigurationPending())
+      configurationFrameIndex_ = std::numeric_limits<quint64>::max();
+   else if (applied || configurationFrameIndex_ == std::numeric_limits<quint64>::max())
+      configurationFrameIndex_ = frameTiming_.frameCount();
+   setClipControl(reverseDepthEnabled_);
+
+   // Projection settings may have been changed from another thread. They're picked up here, where they
+   // can't change between the eyes of a frame, and only invalidate the projections, not the buffers.
+   if (projectionSettings_.takeChanges(projection_))
+      projectionChanged_ = {true, true};
+
+   if (timed)
+      frameTiming_.beginFrame(1.0f / display_.refreshRate());
+
+   frameClock_.start();
+
+   eyeRendered_ = {false, false};
+   eyePainted_ = {false, false};
+   eyeReprojected_ = {false, false};
+   eyeExcluded_ = excludedEyes;
+
+   // With half-rate eyes, only one eye is painted per frame, and the eyes take turns.
+   halfRateEye_ = halfRateEye_ == ovrEye_Left ? ovrEye_Right : ovrEye_Left;
+   if (offscreen_)
+   {
+      // Without a window, the SDK can neither time nor present frames. Instead, both eyes are
+      // drawn from a neutral or replayed head pose and frames are assumed to be one display refresh
+      // apart, which keeps offscreen output reproducible regardless of how fast it is rendered.
+      ovrPosef pose = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+      if (offscreenPoses_ != nullptr)
+      {
+         const auto& replayed = offscreenPoses_->predict(static_cast<double>(offscreenFrameCount_) / display_.refreshRate());
+         const auto& orientation = replayed.orientation;
+         const auto& position = replayed.position;
+         pose.Orientation = {orientation.x(), orientation.y(), orientation.z(), orientation.scalar()};
+         pose.Position = {position.x(), position.y(), position.z()};
+      }
+      eyePose_ = {pose, pose};
+      ++offscreenFrameCount_;
+      return 1.0f / display_.refreshRate();
+   }
+
+   // Both eyes are prepared from the poses predicted at the start of the frame. Each eye's parameters
+   // are then refreshed with the pose returned by ovrHmd_BeginEyeRender before it is drawn.
+   sdkFrameTiming_ = ovrHmd_BeginFrame(display_, 0);
+   for (const auto& eye : {ovrEye_Left, ovrEye_Right})
+      eyePose_[eye] = ovrHmd_GetEyePose(display_, eye);
+
+   return sdkFrameTiming_.DeltaSeconds;
+}
+
+
+std::array<const QStereoEyeParameters*, ovrEye_Count>
+QOculusRiftRendererPrivate::predictedEyeParameters()
+{
+   // An eye that isn't drawn this frame has nothing to prepare.
+   std::array<const QStereoEyeParameters*, ovrEye_Count> parameters = {{nullptr, nullptr}};
+   for (const auto& eye : {ovrEye_Left, ovrEye_Right})
+   {
+      if (!eyeExcluded_[eye])
+         parameters[eye] = &eyeParameters(eye, eyePose_[eye]);
+   }
+   return parameters;
+}
+
+
+const QStereoEyeParameters&
+QOculusRiftRendererPrivate::beginEye(const ovrEyeType& eye, double& predictedLatency)
+{
+   eyeRendered_[eye] = true;
+   if (offscreen_)
+      predictedLatency = 0.0;
+   else
+   {
+      // The pose is predicted for the moment the eye is scanned out, so the time between sampling
+      // it and the predicted scanout is the motion-to-photon latency the SDK expects for this eye.
+      const auto& sampleTime = ovr_GetTimeInSeconds();
+      eyePose_[eye] = ovrHmd_BeginEyeRender(display_, eye);
+      predictedLatency = sdkFrameTiming_.EyeScanoutSeconds[eye] - sampleTime;
+   }
+   const auto& parameters = eyeParameters(eye, eyePose_[eye]);
+
+   // Each eye has a target of its own when they're separate, otherwise both share the one bound in bindFBO.
+   if (separateEyeTargets_)
+      renderFBO(eye).bind();
+
+   // An eye that isn't painted is synthesized from its previous image when possible. Otherwise, an eye
+   // whose updates are ignored keeps its previous image as it is. The frame's eyes are painted as long as
+   // they can make the frame's deadline, and an eye that begins once the deadline has passed would only
+   // be shown a frame late, so it's synthesized with the newest pose instead. An eye is never synthesized
+   // for a deadline twice in a row, which keeps its content at most one frame old when the application
+   // can't keep up.
+   const auto& ignored = eyeUpdatesIgnored_[eye] || eyeExcluded_[eye] || (halfRateEyes_ && eye != halfRateEye_);
+   const auto& late = reprojectionActive() && !ignored && !eyeLate_[eye] && deadlinePassed();
+   eyeLate_[eye] = false;
+   if ((ignored || late) && reprojectionActive() && reprojection_.reproject(parameters))
+   {
+      eyeReprojected_[eye] = true;
+      eyeLate_[eye] = late;
+      return parameters;
+   }
+
+   if (!ignored)
+   {
+      const auto& viewport = parameters.viewport();
+      glEnable(GL_SCISSOR_TEST);
+      glScissor(viewport.x(), viewport.y(), viewport.width(), viewport.height());
+      glClearDepth(reverseDepthEnabled_ ? 0.0 : 1.0);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      glClearDepth(1.0);
+      glDisable(GL_SCISSOR_TEST);
+      eyePainted_[eye] = true;
+   }
+   return parameters;
+}
+
+
+void
+QOculusRiftRendererPrivate::endEye(const ovrEyeType& eye, const bool lateLatched)
+{
+   // A late-latched eye is submitted once the late pose has been sampled, at the end of the frame. Eyes
+   // that weren't painted don't depend on the late pose and are submitted right away, as are all eyes
+   // when the late pose cannot reach draw calls that were already issued.
+   if (!offscreen_ && (!lateLatched || !lateLatch_.isPersistent() || !eyePainted_[eye]))
+      ovrHmd_EndEyeRender(display_, eye, eyePose_[eye], &eyeTextureConfiguration(eye).Texture);
+}
+
+
+void
+QOculusRiftRendererPrivate::endFrame(const bool timed, const bool lateLatched)
+{
+   // When late latching with a persistent buffer, both eyes' draw calls have been issued but are still
+   // queued, so a pose sampled now is written into the view matrices right before the GPU copies them.
+   // The eye's parameters and time warp are then given the late pose, since it's the one that was rendered
+   // in the common case. Without a persistent buffer, the late pose would only reach later draw calls, so
+   // the eyes keep the pose they were painted with and were already submitted in endEye.
+   if (!offscreen_ && lateLatched && lateLatch_.isPersistent())
+   {
+      QSTEREO_TRACE_ZONE("QOculusRiftRenderer::lateLatch");
+      for (const auto& eye : display_.descriptor().EyeRenderOrder)
+      {
+         if (!eyeRendered_[eye] || !eyePainted_[eye])
+            continue;
+
+         eyePose_[eye] = ovrHmd_GetEyePose(display_, eye);
+         lateLatch_.latch(static_cast<QEye>(eye), eyeParameters(eye, eyePose_[eye]).view());
+         ovrHmd_EndEyeRender(display_, eye, eyePose_[eye], &eyeTextureConfiguration(eye).Texture);
+      }
+   }
+   if (lateLatched)
+      lateLatch_.endFrame();
+
+   // Painted eyes are kept, along with the parameters they were painted with, so that a later frame can be
+   // synthesized from them. This happens before layers are composited, since layers are drawn every frame.
+   if (reprojectionActive())
+   {
+      for (const auto& eye : {ovrEye_Left, ovrEye_Right})
+      {
+         if (eyePainted_[eye])
+            reprojection_.store(renderFBO(eye), eyeParameters_[eye]);
+      }
+   }
+
+   releaseFBO();
+   compositeLayers();
+   setClipControl(false);
+   if (timed)
+      frameTiming_.endFrame();
+
+   if (!offscreen_)
+   {
+      QSTEREO_TRACE_ZONE("ovrHmd_EndFrame");
+      ovrHmd_EndFrame(display_);
+   }
+}
+
+
+void
+QOculusRiftRendererPrivate::compositeLayers()
+{
+   if (layers_.isEmpty())
+      return;
+
+   // LibOVR 0.3 has no compositor layers of its own. Instead, each layer is drawn into the resolved eye
+   // texture, after multisampling and before ovrHmd_EndFrame applies distortion to it. Layers are drawn
+   // in the order they were added, so later layers cover earlier ones. An eye that was neither painted nor
+   // reprojected this frame still holds the image its layers were composited onto, and compositing them
+   // again would blend translucent layers over themselves, so such an eye keeps its layers as they were.
+   QSTEREO_TRACE_ZONE("QOculusRiftRenderer::compositeLayers");
+   for (const auto& eye : {ovrEye_Left, ovrEye_Right})
+   {
+      if (!eyePainted_[eye] && !eyeReprojected_[eye])
+         continue;
+
+      fbo_[target(eye)]->bind();
+      for (auto* const layer : layers_)
+         layer->composite(eyeParameters_[eye]);
+   }
+   QOpenGLFramebufferObject::bindDefault();
+}
+
+
+QOpenGLFramebufferObject&
+QOculusRiftRendererPrivate::renderFBO(const ovrEyeType& eye) const
+{
+   const auto& target = this->target(eye);
+   return multisampleFbo_[target] != nullptr ? *multisampleFbo_[target] : *fbo_[target];
+}
+
+
+unsigned int
+QOculusRiftRendererPrivate::target(const ovrEyeType& eye) const
+{
+   return separateEyeTargets_ ? eye : 0;
+}
+
+
+unsigned int
+QOculusRiftRendererPrivate::targetCount() const
+{
+   return separateEyeTargets_ ? ovrEye_Count : 1;
+}
+
+
+bool
+QOculusRiftRendererPrivate::reprojectionActive() const
+{
+   // The reprojection keeps a single history, in which separate eye targets would overlap.
+   return reprojectionEnabled_ && !separateEyeTargets_;
+}
+
+
+bool
+QOculusRiftRendererPrivate::deadlinePassed() const
+{
+   // An eye that's drawn after the SDK starts distorting the frame misses the frame's scanout. Time warp
+   // distorts the frame as late as possible, at its time warp point, and the next vertical blank is the
+   // deadline otherwise. Offscreen, frames are assumed to be one display refresh apart.
+   if (offscreen_)
+      return frameClock_.nsecsElapsed() >= 1e9 / display_.refreshRate();
+
+   const auto& timewarp = isDistortionCapabilityEnabled(ovrDistortionCap_TimeWarp);
+   return ovr_GetTimeInSeconds() >= (timewarp ? sdkFrameTiming_.TimewarpPointSeconds : sdkFrameTiming_.NextFrameSeconds);
+}
+
+
+QSize
+QOculusRiftRendererPrivate::eyeSize(const ovrEyeType& eye) const
+{
+   const auto& size = ovrHmd_GetFovTextureSize(display_, eye, eyeFov_[eye], pixelDensity_[eye]);
+   return QSize(size.w, size.h);
+}
+
+
+QSize
+QOculusRiftRendererPrivate::fboSize(const unsigned int& target) const
+{
+   if (separateEyeTargets_)
+      return eyeSize(static_cast<ovrEyeType>(target));
+
+   const auto& sizeL = eyeSize(ovrEye_Left);
+   const auto& sizeR = eyeSize(ovrEye_Right);
+   return QSize(sizeL.width() + sizeR.width(), std::max(sizeL.height(), sizeR.height()));
+}
+
+
+bool
+QOculusRiftRendererPrivate::fboReusable(const unsigned int& target) const
+{
+   // A target keeps its framebuffer object when neither its size nor the format changed, e.g. when only
+   // the other eye's field of view or pixel density did.
+   const auto& fbo = fbo_[target];
+   return target < targetCount() && !fboFormatChanged_ && fbo != nullptr && fbo->size() == fboSize(target);
+}
+
+
+bool
+QOculusRiftRendererPrivate::fboCurrent() const
+{
+   for (unsigned int i = 0; i < fbo_.size(); ++i)
+   {
+      const auto& current = i < targetCount() ? fboReusable(i) : fbo_[i] == nullptr;
+      if (!current)
+         return false;
+   }
+   return true;
+}
+
+
+bool
+QOculusRiftRendererPrivate::fboPrepared() const
+{
+   for (unsigned int i = 0; i < targetCount(); ++i)
+   {
+      const auto& pending = pendingFbo_[i];
+      const auto& prepared = pending != nullptr ? pending->size() == fboSize(i) : fboReusable(i);
+      if (!prepared)
+         return false;
+   }
+   return true;
+}
+
+
+void
+QOculusRiftRendererPrivate::prepareFBO()
+{
+   QSTEREO_TRACE_ZONE("QOculusRiftRenderer::prepareFBO");
+
+   for (unsigned int i = 0; i < pendingFbo_.size(); ++i)
+   {
+      auto& fbo = pendingFbo_[i];
+      auto& multisampleFbo = pendingMultisampleFbo_[i];
+
+      fbo.reset();
+      multisampleFbo.reset();
+      if (i < targetCount() && !fboReusable(i))
+      {
+         const auto& size = fboSize(i);
+         fbo.reset(createFBO(size, fboFormat_));
+         if (fbo == nullptr || fbo->size() != size || !fbo->isValid())
+            qFatal("[QtStereoscopy] Error: Could not resize the framebuffer object.");
+
+         multisampleFbo.reset(createMultisampleFBO(size));
+      }
+   }
+   pendingSampleCount_ = sampleCount_;
+}
+
+
 void
 QOculusRiftRendererPrivate::configureFBO()
 {
-   // Calculate the FBO's new resolution.
-   const auto& sizeL = ovrHmd_GetFovTextureSize(display_, ovrEye_Left,  eyeFov_[ovrEye_Left],  pixelDensity_);
-   const auto& sizeR = ovrHmd_GetFovTextureSize(display_, ovrEye_Right, eyeFov_[ovrEye_Right], pixelDensity_);
-   const auto& size  = QSize(sizeL.w + sizeR.w, std::max(sizeL.h, sizeR.h));
+   QSTEREO_TRACE_ZONE("QOculusRiftRenderer::configureFBO");
 
-   // Reset the FBO by allocating a new one.
-   fbo_.reset(new QOpenGLFramebufferObject(size, fboFormat_));
-   if (fbo_ == nullptr || fbo_->size() != size || !fbo_->isValid())
-      qFatal("[QtStereoscopy] Error: Could not resize the framebuffer object.");
+   // Replace the FBOs with the ones that were prepared for them, or allocate new ones if there are none.
+   // Targets whose size hasn't changed are kept as they are.
+   const auto& prepared = fboPrepared();
+   for (unsigned int i = 0; i < fbo_.size(); ++i)
+   {
+      auto& fbo = fbo_[i];
+      if (i >= targetCount())
+      {
+         fbo.reset();
+         multisampleFbo_[i].reset();
+      }
+      else if (prepared && pendingFbo_[i] != nullptr)
+      {
+         fbo.swap(pendingFbo_[i]);
 
-   const auto& w = size.width();
-   const auto& h = size.height();
+         // The prepared multisampled framebuffer object is only valid if the sample count hasn't changed since.
+         if (pendingSampleCount_ == sampleCount_)
+            multisampleFbo_[i].swap(pendingMultisampleFbo_[i]);
+         else
+            sampleCountChanged_ = true;
+      }
+      else if (!fboReusable(i))
+      {
+         const auto& size = fboSize(i);
+         fbo.reset();
+         fbo.reset(createFBO(size, fboFormat_));
+         if (fbo == nullptr || fbo->size() != size || !fbo->isValid())
+            qFatal("[QtStereoscopy] Error: Could not resize the framebuffer object.");
+
+         sampleCountChanged_ = true;
+      }
+   }
+   if (!sampleCountChanged_)
+   {
+      if (multisampleFbo_[0] != nullptr)
+         glEnable(GL_MULTISAMPLE);
+      else
+         glDisable(GL_MULTISAMPLE);
+   }
+   for (auto& pending : pendingFbo_)
+      pending.reset();
+   for (auto& pending : pendingMultisampleFbo_)
+      pending.reset();
 
-   for (unsigned int i = 0; i < ovrEye_Count; ++i)
+   // Each eye's viewport is sized exactly after its texture size. Side by side, the right eye's viewport
+   // follows the left eye's, whereas separate targets each hold a single eye.
+   const auto& leftWidth = eyeSize(ovrEye_Left).width();
+   for (const auto& eye : {ovrEye_Left, ovrEye_Right})
    {
-      const auto& viewport = QRect(i * ((w + 1) * 0.5f), 0, w * 0.5f, h);
-            auto& OGL = eyeTextureConfigs_[i].OGL;
+      const auto& fbo = *fbo_[target(eye)];
+      const auto& size = eyeSize(eye);
+      const auto& viewport = QRect(!separateEyeTargets_ && eye == ovrEye_Right ? leftWidth : 0, 0, size.width(), size.height());
+            auto& OGL = eyeTextureConfigs_[eye].OGL;
 
       // Update the API.
-      OGL.TexId = fbo_->texture();
-      OGL.Header.TextureSize.w = w;
-      OGL.Header.TextureSize.h = h;
+      OGL.TexId = fbo.texture();
+      OGL.Header.TextureSize.w = fbo.width();
+      OGL.Header.TextureSize.h = fbo.height();
       OGL.Header.RenderViewport.Pos.x = viewport.x();
       OGL.Header.RenderViewport.Pos.y = viewport.y();
       OGL.Header.RenderViewport.Size.w = viewport.width();
       OGL.Header.RenderViewport.Size.h = viewport.height();
 
       // Update each eye's render viewport.
-      eyeParameters_[i].setViewport(viewport);
+      eyeParameters_[eye].setViewport(viewport);
    }
-   // Since the FBO has changed, the render configurations need to be updated too.
+   // Since the FBO has changed, the render configurations need to be updated too, and the eyes' previous
+   // images can no longer be reprojected.
    eyeRenderingInfoChanged_ = true;
+   reprojection_.clearHistory();
+}
+
+
+void
+QOculusRiftRendererPrivate::configureMultisampleFBO()
+{
+   QSTEREO_TRACE_ZONE("QOculusRiftRenderer::configureMultisampleFBO");
+
+   // The previous framebuffer objects are released first, so that both never take up memory at once.
+   for (auto& multisampleFbo : multisampleFbo_)
+      multisampleFbo.reset();
+
+   for (unsigned int i = 0; i < targetCount(); ++i)
+      multisampleFbo_[i].reset(createMultisampleFBO(fbo_[i]->size()));
+
+   if (multisampleFbo_[0] != nullptr)
+      glEnable(GL_MULTISAMPLE);
+   else
+      glDisable(GL_MULTISAMPLE);
+}
+
+
+QOpenGLFramebufferObject*
+QOculusRiftRendererPrivate::createMultisampleFBO(const QSize& size)
+{
+   if (sampleCount_ < 2)
+      return nullptr;
+
+   if (!QOpenGLFramebufferObject::hasOpenGLFramebufferMultisample() || !QOpenGLFramebufferObject::hasOpenGLFramebufferBlit())
+   {
+      qWarning("[QtStereoscopy] Warning: Multisampled framebuffer objects are not supported. Multisampling is disabled.");
+      return nullptr;
+   }
+
+   // The multisampled framebuffer object mirrors the resolved one, which keeps the eye viewports intact.
+   GLint maxSamples = 0;
+   glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+
+   auto format = fboFormat_;
+   format.setSamples(std::min(static_cast<GLint>(sampleCount_), maxSamples));
+
+   auto* const fbo = createFBO(size, format);
+   if (fbo == nullptr || !fbo->isValid())
+      qFatal("[QtStereoscopy] Error: Could not create the multisampled framebuffer object.");
+
+   return fbo;
+}
+
+
+QOpenGLFramebufferObject*
+QOculusRiftRendererPrivate::createFBO(const QSize& size, const QOpenGLFramebufferObjectFormat& format) const
+{
+   if (reverseDepthEnabled_ && gl_ != nullptr)
+      return new FloatDepthFramebufferObject(*gl_, size, format);
+
+   return new QOpenGLFramebufferObject(size, format);
+}
+
+
+bool
+QOculusRiftRendererPrivate::configureReverseDepth()
+{
+   auto* const context = QOpenGLContext::currentContext();
+   gl_ = context != nullptr ? context->versionFunctions<QOpenGLFunctions_3_2_Core>() : nullptr;
+   if (gl_ == nullptr || !gl_->initializeOpenGLFunctions())
+   {
+      qWarning("[QtStereoscopy] Warning: Reverse depth requires an OpenGL 3.2 context. Reverse depth is disabled.");
+      gl_ = nullptr;
+      return false;
+   }
+
+   // Without glClipControl, clip space depth ranges from -1 to 1, and the depth buffer's precision close
+   // to 0 is lost when it's mapped to window coordinates.
+   const auto& format = context->format();
+   const auto& version = format.majorVersion() * 10 + format.minorVersion();
+   if (version >= 45 || context->hasExtension(QByteArrayLiteral("GL_ARB_clip_control")))
+      clipControl_ = reinterpret_cast<ClipControl>(context->getProcAddress(QByteArrayLiteral("glClipControl")));
+   if (clipControl_ == nullptr)
+   {
+      qWarning("[QtStereoscopy] Warning: Reverse depth requires OpenGL 4.5 or GL_ARB_clip_control. Reverse depth is disabled.");
+      gl_ = nullptr;
+      return false;
+   }
+   return true;
+}
+
+
+void
+QOculusRiftRendererPrivate::setClipControl(const bool reverse)
+{
+   // Clip space depth only ranges from 0 to 1 while the eyes are drawn, since the SDK's distortion pass
+   // expects OpenGL's default.
+   if (clipControl_ != nullptr)
+      clipControl_(GL_LOWER_LEFT, reverse ? GL_ZERO_TO_ONE : GL_NEGATIVE_ONE_TO_ONE);
+
+   // Closer surfaces have greater depths, so OpenGL's default depth test is reversed for the same duration.
+   if (depthTestReversed_ != reverse)
+   {
+      glDepthFunc(reverse ? GL_GREATER : GL_LESS);
+      depthTestReversed_ = reverse;
+   }
 }
 
 
 void
 QOculusRiftRendererPrivate::configureRendering()
 {
-   const ovrFovPort* const fovs = eyeFov_.data();
-   const ovrRenderAPIConfig* const apiConfig = &(apiConfig_->Config);
-   ovrEyeRenderDesc* const renderConfigs = eyeRenderingInfo_.data();
-   if (!ovrHmd_ConfigureRendering(display_, apiConfig, enabledDistortionCapabilities_, fovs, renderConfigs))
-      qFatal("[QtStereoscopy] Error: Could not update the render configuration.");
+   QSTEREO_TRACE_ZONE("QOculusRiftRenderer::configureRendering");
+   const auto previousRenderingInfo = eyeRenderingInfo_;
+
+   if (offscreen_)
+   {
+      // There is no window to distort into, so only query the eyes' rendering information.
+      for (unsigned int i = 0; i < ovrEye_Count; ++i)
+      {
+         const auto& eye = static_cast<ovrEyeType>(i);
+         eyeRenderingInfo_[eye] = ovrHmd_GetRenderDesc(display_, eye, eyeFov_[eye]);
+      }
+   }
+   else
+   {
+      const ovrFovPort* const fovs = eyeFov_.data();
+      const ovrRenderAPIConfig* const apiConfig = &(apiConfig_->Config);
+      ovrEyeRenderDesc* const renderConfigs = eyeRenderingInfo_.data();
+      if (!ovrHmd_ConfigureRendering(display_, apiConfig, enabledDistortionCapabilities_, fovs, renderConfigs))
+         qFatal("[QtStereoscopy] Error: Could not update the render configuration.");
+   }
 
    if (forceZeroIPD_)
    {
@@ -315,6 +1314,20 @@ QOculusRiftRendererPrivate::configureRendering()
          info.ViewAdjust = OVR::Vector3f(0);
    }
 
+   // An eye's projections are only recomputed if the rendering information they're derived from changed.
+   for (const auto& eye : {ovrEye_Left, ovrEye_Right})
+   {
+      const auto& info = eyeRenderingInfo_[eye];
+      const auto& previous = previousRenderingInfo[eye];
+      if
+      (
+         std::memcmp(&info.Fov, &previous.Fov, sizeof(info.Fov)) != 0 ||
+         std::memcmp(&info.PixelsPerTanAngleAtCenter, &previous.PixelsPerTanAngleAtCenter, sizeof(info.PixelsPerTanAngleAtCenter)) != 0 ||
+         std::memcmp(&info.ViewAdjust, &previous.ViewAdjust, sizeof(info.ViewAdjust)) != 0
+      )
+         projectionChanged_[eye] = true;
+   }
+
    // Set the view adjust vectors.
    for (const auto& eye : display_.descriptor().EyeRenderOrder)
    {
@@ -25,10 +25,20 @@
 #define QOCULUSRIFTRENDERER_P_H
 
 #include "qoculusrift.h"
+#include "qstereocompositorlayer.h"
 #include "qstereoeyeparameters.h"
+#include "qstereoframestatistics.h"
+#include "qstereoframetiming.h"
+#include "qstereolatelatch.h"
+#include "qstereoposepredictor.h"
+#include "qstereoprojectionsettings.h"
+#include "qstereoreprojection.h"
+#include <QtCore/QElapsedTimer>
 #include <QtGui/QMatrix4x4>
 #include <QtGui/QOpenGLFramebufferObjectFormat>
+#include <QtGui/QOpenGLFunctions>
 #include <OVR_CAPI.h>
+#include <atomic>
 
 union ovrGLConfig;
 union ovrGLTexture_s;
@@ -37,55 +47,180 @@ using ovrGLTexture = ovrGLTexture_s;
 
 QT_BEGIN_NAMESPACE
 
+class QOpenGLFunctions_3_2_Core;
 class QOculusRiftRendererPrivate : public QObject
 {
 public:
    QOculusRiftRendererPrivate(QOculusRiftRenderer* const parent, const unsigned int& index, const bool& forceDebugDevice);
 
    void configureWindow(QWindow& window);
-   void configureGL();
+   void configureOffscreen();
+   const bool& isOffscreen() const;
+   bool configureGL();
    void apply();
 
    QOculusRift& display();
    const QOculusRift& const_display() const;
+   QStereoFrameTiming& frameTiming();
+   QStereoFrameStatistics& frameStatistics();
 
    void bindFBO();
    void releaseFBO();
+   const QOpenGLFramebufferObject* framebufferObject(const ovrEyeType& eye) const;
 
-   const float& pixelDensity() const;
-   void setPixelDensity(const float&);
+   const float& pixelDensity(const ovrEyeType& eye) const;
+   void setPixelDensity(const ovrEyeType& eye, const float& density);
+
+   const ovrFovPort& fov(const ovrEyeType& eye) const;
+   void setFov(const ovrEyeType& eye, const ovrFovPort& fov);
+
+   bool separateEyeTargetsEnabled() const;
+   void enableSeparateEyeTargets(const bool enable);
+
+   QStereoProjectionSettings& projectionSettings();
+
+   bool reverseDepthEnabled() const;
+   void enableReverseDepth(const bool enable);
+
+   const unsigned int& sampleCount() const;
+   void setSampleCount(const unsigned int& samples);
+
+   const int& reconfigurationDelay() const;
+   void setReconfigurationDelay(const int& msec);
+   quint64 configurationFrameIndex() const;
+   bool offscreenStagingEnabled() const;
+   void enableOffscreenStaging(const bool enable);
+
+   bool lateLatchEnabled() const;
+   void enableLateLatch(const bool enable);
+   QStereoLateLatch& lateLatch();
+
+   bool reprojectionEnabled() const;
+   void enableReprojection(const bool enable);
+   QStereoReprojection& reprojection();
+
+   QStereoPosePredictor* offscreenPoses() const;
+   void setOffscreenPoses(QStereoPosePredictor* const poses);
+
+   bool eyeUpdatesIgnored(const ovrEyeType& eye) const;
+   void ignoreEyeUpdates(const ovrEyeType& eye, const bool ignore);
+   bool eyePainted(const ovrEyeType& eye) const;
+
+   bool halfRateEyesEnabled() const;
+   void enableHalfRateEyes(const bool enable);
+
+   QVector<QStereoCompositorLayer*>& layers();
+   const QVector<QStereoCompositorLayer*>& layers() const;
+   void refreshLayers();
 
    bool isDistortionCapabilityEnabled(const unsigned int& capability) const;
    void setDistortionCapabilityEnabled(const unsigned int& capability, const bool enable);
 
    ovrGLTexture& eyeTextureConfiguration(const ovrEyeType& eye);
    const QStereoEyeParameters& eyeParameters(const ovrEyeType& eye, const ovrPosef& pose);
+
+   float beginFrame(const bool timed, const std::array<bool, ovrEye_Count>& excludedEyes);
+   std::array<const QStereoEyeParameters*, ovrEye_Count> predictedEyeParameters();
+   const QStereoEyeParameters& beginEye(const ovrEyeType& eye, double& predictedLatency);
+   void endEye(const ovrEyeType& eye, const bool lateLatched);
+   void endFrame(const bool timed, const bool lateLatched);
 private:
+   using FramebufferObjects = std::array<QScopedPointer<QOpenGLFramebufferObject>, ovrEye_Count>;
+   typedef void (QOPENGLF_APIENTRYP ClipControl)(GLenum origin, GLenum depth);
+
+   void scheduleReconfiguration();
+   bool reconfigurationDue() const;
+   bool reconfigurationPending() const;
+   unsigned int target(const ovrEyeType& eye) const;
+   unsigned int targetCount() const;
+   QSize eyeSize(const ovrEyeType& eye) const;
+   QSize fboSize(const unsigned int& target) const;
+   bool fboReusable(const unsigned int& target) const;
+   bool fboCurrent() const;
+   bool fboPrepared() const;
+   void prepareFBO();
    void configureFBO();
+   void configureMultisampleFBO();
+   QOpenGLFramebufferObject* createFBO(const QSize& size, const QOpenGLFramebufferObjectFormat& format) const;
+   QOpenGLFramebufferObject* createMultisampleFBO(const QSize& size);
+   bool configureReverseDepth();
+   void setClipControl(const bool reverse);
    void configureRendering();
+   void compositeLayers();
+   QOpenGLFramebufferObject& renderFBO(const ovrEyeType& eye) const;
+   bool reprojectionActive() const;
+   bool deadlinePassed() const;
 
    void* nativeDisplay(QWindow& window);
 
    QOculusRift display_;
+   QStereoFrameTiming frameTiming_;
+   QStereoFrameStatistics frameStatistics_;
+   QStereoLateLatch lateLatch_;
+   QStereoReprojection reprojection_;
 
-   QScopedPointer<QOpenGLFramebufferObject> fbo_;
+   FramebufferObjects fbo_;
    QOpenGLFramebufferObjectFormat fboFormat_;
    bool fboSizeChanged_;
    bool fboFormatChanged_;
 
+   FramebufferObjects multisampleFbo_;
+   unsigned int sampleCount_;
+   bool sampleCountChanged_;
+
+   FramebufferObjects pendingFbo_;
+   FramebufferObjects pendingMultisampleFbo_;
+   unsigned int pendingSampleCount_;
+   int reconfigurationDelay_;
+   QElapsedTimer reconfigurationClock_;
+   bool offscreenStagingEnabled_;
+   std::atomic<quint64> configurationFrameIndex_;
+
+   bool lateLatchEnabled_;
+   bool lateLatchChanged_;
+
+   bool reprojectionEnabled_;
+   bool reprojectionChanged_;
+   QElapsedTimer frameClock_;
+
+   QVector<QStereoCompositorLayer*> layers_;
+
    QScopedPointer<ovrGLConfig> apiConfig_;
    QScopedArrayPointer<ovrGLTexture> eyeTextureConfigs_;
 
+   QStereoProjectionSettings projectionSettings_;
+   QStereoProjectionSettings::Snapshot projection_;
    std::array<bool, ovrEye_Count> projectionChanged_;
 
+   bool reverseDepthEnabled_;
+   bool reverseDepthChanged_;
+   QOpenGLFunctions_3_2_Core* gl_;
+   ClipControl clipControl_;
+   bool depthTestReversed_;
+
    std::array<QStereoEyeParameters, ovrEye_Count> eyeParameters_;
    std::array<ovrFovPort,           ovrEye_Count> eyeFov_;
    std::array<ovrEyeRenderDesc,     ovrEye_Count> eyeRenderingInfo_;
    bool eyeRenderingInfoChanged_;
 
+   ovrFrameTiming sdkFrameTiming_;
+   std::array<ovrPosef, ovrEye_Count> eyePose_;
+   std::array<bool,     ovrEye_Count> eyeRendered_;
+   std::array<bool,     ovrEye_Count> eyePainted_;
+   std::array<bool,     ovrEye_Count> eyeReprojected_;
+   std::array<bool,     ovrEye_Count> eyeLate_;
+   std::array<bool,     ovrEye_Count> eyeExcluded_;
+   std::array<bool,     ovrEye_Count> eyeUpdatesIgnored_;
+   bool halfRateEyes_;
+   ovrEyeType halfRateEye_;
+
    unsigned int enabledDistortionCapabilities_;
-   float pixelDensity_;
+   std::array<float, ovrEye_Count> pixelDensity_;
+   bool separateEyeTargets_;
    bool forceZeroIPD_;
+   bool offscreen_;
+   QStereoPosePredictor* offscreenPoses_;
+   quint64 offscreenFrameCount_;
 };
 
 QT_END_NAMESPACE
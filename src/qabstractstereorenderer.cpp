@@ -22,8 +22,20 @@
  * THE SOFTWARE.
  */
 #include "qabstractstereorenderer.h"
+#include "qabstractstereorenderer_p.h"
+#include "qstereotaskscheduler.h"
+#include "qstereotrace.h"
 #include "qstereowindow.h"
+#include <QtCore/QMutexLocker>
 #include <QtCore/QRect>
+#include <QtCore/QThread>
+#include <QtGui/QOpenGLFunctions_3_2_Core>
+#include <utility>
+
+
+QAbstractStereoRenderer::QAbstractStereoRenderer() :
+d_ptr(new QAbstractStereoRendererPrivate(this))
+{}
 
 
 void
@@ -38,8 +50,199 @@ QAbstractStereoRenderer::initializeWindow(const WId&)
 {}
 
 
+void
+QAbstractStereoRenderer::initializeOffscreen()
+{}
+
+
 void
 QAbstractStereoRenderer::setViewport(const QRect& viewport)
 {
    glViewport(viewport.x(), viewport.y(), viewport.width(), viewport.height());
 }
+
+
+const QOpenGLFramebufferObject*
+QAbstractStereoRenderer::framebufferObject() const
+{
+   return nullptr;
+}
+
+
+const QOpenGLFramebufferObject*
+QAbstractStereoRenderer::framebufferObject(const QEye&) const
+{
+   return framebufferObject();
+}
+
+
+QStereoFrameTiming*
+QAbstractStereoRenderer::frameTiming()
+{
+   return nullptr;
+}
+
+
+QStereoFrameStatistics*
+QAbstractStereoRenderer::frameStatistics()
+{
+   return nullptr;
+}
+
+
+bool
+QAbstractStereoRenderer::parallelEyePreparationEnabled() const
+{
+   Q_D(const QAbstractStereoRenderer);
+   return d->parallelEyePreparationEnabled;
+}
+
+
+void
+QAbstractStereoRenderer::enableParallelEyePreparation(const bool enable)
+{
+   checkRenderThread("QAbstractStereoRenderer::enableParallelEyePreparation");
+   Q_D(QAbstractStereoRenderer);
+   d->parallelEyePreparationEnabled = enable;
+}
+
+
+QStereoTaskScheduler*
+QAbstractStereoRenderer::taskScheduler() const
+{
+   Q_D(const QAbstractStereoRenderer);
+   return d->taskScheduler;
+}
+
+
+void
+QAbstractStereoRenderer::setTaskScheduler(QStereoTaskScheduler* const scheduler)
+{
+   checkRenderThread("QAbstractStereoRenderer::setTaskScheduler");
+   Q_D(QAbstractStereoRenderer);
+   d->taskScheduler = scheduler != nullptr ? scheduler : QStereoTaskScheduler::globalInstance();
+}
+
+
+void
+QAbstractStereoRenderer::fenceFrame()
+{
+   auto* const functions = QAbstractStereoRendererPrivate::syncFunctions();
+   if (functions == nullptr)
+      return;
+
+   // Another context may only wait on the fence once it has been flushed to the GPU.
+   auto* fence = functions->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+   functions->glFlush();
+
+   Q_D(QAbstractStereoRenderer);
+   {
+      QMutexLocker lock(&d->frameFenceMutex);
+      std::swap(d->frameFence, fence);
+   }
+   // A wait that was already issued on the previous fence keeps it alive until the wait is over.
+   if (fence != nullptr)
+      functions->glDeleteSync(fence);
+}
+
+
+void
+QAbstractStereoRenderer::waitForFrame() const
+{
+   auto* const functions = QAbstractStereoRendererPrivate::syncFunctions();
+   if (functions == nullptr)
+      return;
+
+   // The wait is queued in the current context's command stream and does not block this thread. The lock
+   // only keeps the fence from being deleted before the wait is issued.
+   Q_D(const QAbstractStereoRenderer);
+   QMutexLocker lock(&d->frameFenceMutex);
+   if (d->frameFence != nullptr)
+      functions->glWaitSync(d->frameFence, 0, GL_TIMEOUT_IGNORED);
+}
+
+
+void
+QAbstractStereoRenderer::invokeOnRenderThread(const Invocation& invocation)
+{
+   Q_D(QAbstractStereoRenderer);
+   QMutexLocker lock(&d->invocationMutex);
+   d->invocations.append(invocation);
+}
+
+
+void
+QAbstractStereoRenderer::processInvocations()
+{
+   // The thread that processes invocations is the one that renders, since frames begin here.
+   Q_D(QAbstractStereoRenderer);
+   d->renderThread = QThread::currentThread();
+
+   // Invocations are taken out of the queue before they're called, so that they may queue others,
+   // which are then processed the next frame.
+   QVector<Invocation> invocations;
+   {
+      QMutexLocker lock(&d->invocationMutex);
+      if (d->invocations.isEmpty())
+         return;
+
+      invocations.swap(d->invocations);
+   }
+   for (const auto& invocation : invocations)
+      invocation();
+}
+
+
+bool
+QAbstractStereoRenderer::isRenderThread() const
+{
+   // Until a frame is rendered, the renderer is only configured from the thread that creates it.
+   Q_D(const QAbstractStereoRenderer);
+   auto* const thread = d->renderThread.load();
+   return thread == nullptr || thread == QThread::currentThread();
+}
+
+
+void
+QAbstractStereoRenderer::checkRenderThread(const char* const function) const
+{
+   if (Q_UNLIKELY(!isRenderThread()))
+      qWarning("[QtStereoscopy] Warning: %s must be called on the render thread. Use invokeOnRenderThread() instead.", function);
+}
+
+
+void
+QAbstractStereoRenderer::prepareEye(const QStereoEyeParameters&, const float&)
+{}
+
+
+void
+QAbstractStereoRenderer::prepareEyes(const std::array<const QStereoEyeParameters*, 2>& parameters, const float& dt)
+{
+   QSTEREO_TRACE_ZONE("QAbstractStereoRenderer::prepareEyes");
+   Q_D(QAbstractStereoRenderer);
+
+   const auto* const left = parameters[static_cast<int>(QEye::Left)];
+   const auto* const right = parameters[static_cast<int>(QEye::Right)];
+
+   // When both eyes are prepared in parallel, the right eye is handed to the task scheduler while the
+   // left eye is prepared on this thread. Neither is ever submitted before both have been prepared.
+   if (d->parallelEyePreparationEnabled && left != nullptr && right != nullptr)
+   {
+      auto& scheduler = *d->taskScheduler;
+      const auto& handle = scheduler.submit(QByteArrayLiteral("prepareEye (right eye)"), [this, right, &dt]{ prepareEye(*right, dt); });
+      {
+         QSTEREO_TRACE_ZONE("QAbstractStereoRenderer::prepareEye (left eye)");
+         prepareEye(*left, dt);
+      }
+      scheduler.wait(handle);
+   }
+   else
+   {
+      for (const auto* const p : parameters)
+      {
+         if (p != nullptr)
+            prepareEye(*p, dt);
+      }
+   }
+}
@@ -28,39 +28,95 @@
 #include <QtGui/QOpenGLFunctions>
 #include <QtGui/qwindowdefs.h>
 #include "qeye.h"
+#include "qstereorenderpolicy.h"
+#include <array>
+#include <functional>
 
 
 QT_BEGIN_NAMESPACE
 
+class QAbstractStereoRendererPrivate;
+class QOpenGLFramebufferObject;
 class QStereoEyeParameters;
-template<class T> class QStereoWindow;
+class QStereoFrameStatistics;
+class QStereoFrameTiming;
+class QStereoTaskScheduler;
+template<class Renderer, class Policy = QStereoDynamicRenderPolicy> class QStereoOffscreenSurface;
+template<class Renderer, class Policy = QStereoDynamicRenderPolicy> class QStereoWindow;
 
 class QAbstractStereoRenderer : public QObject, protected QOpenGLFunctions
 {
 public:
-   template<class T> void initialize(const QStereoWindow<T>& window);
+   using Invocation = std::function<void()>;
+
+   template<class T, class P> void initialize(const QStereoWindow<T, P>& window);
+   template<class T, class P> void initialize(const QStereoOffscreenSurface<T, P>& surface);
 
    virtual void apply() = 0;
+   template<class Renderer, class Policy> void render();
    virtual void swapBuffers(QOpenGLContext& context, QSurface& surface);
    virtual void ignoreEyeUpdates(const QEye& eye, const bool freeze) = 0;
            void setViewport(const QRect& viewport);
+
+   virtual const QOpenGLFramebufferObject* framebufferObject() const;
+   virtual const QOpenGLFramebufferObject* framebufferObject(const QEye& eye) const;
+   virtual QStereoFrameTiming* frameTiming();
+   virtual QStereoFrameStatistics* frameStatistics();
+
+   bool parallelEyePreparationEnabled() const;
+   void enableParallelEyePreparation(const bool enable = true);
+
+   QStereoTaskScheduler* taskScheduler() const;
+   void setTaskScheduler(QStereoTaskScheduler* const scheduler);
+
+   void fenceFrame();
+   void waitForFrame() const;
+
+   void invokeOnRenderThread(const Invocation& invocation);
+   void processInvocations();
+   bool isRenderThread() const;
 protected:
-   QAbstractStereoRenderer() = default;
+   QAbstractStereoRenderer();
 
    virtual void initializeWindow(const WId& windowId);
+   virtual void initializeOffscreen();
    virtual void initializeGL() = 0;
+   virtual void prepareEye(const QStereoEyeParameters& parameters, const float& dt);
    virtual void paintGL(const QStereoEyeParameters& parameters, const float& dt) = 0;
+
+   void prepareEyes(const std::array<const QStereoEyeParameters*, 2>& parameters, const float& dt);
+   void checkRenderThread(const char* const function) const;
+private:
+   QAbstractStereoRendererPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QAbstractStereoRenderer);
 };
 
 
-template<class T> void
-QAbstractStereoRenderer::initialize(const QStereoWindow<T>& window)
+template<class T, class P> void
+QAbstractStereoRenderer::initialize(const QStereoWindow<T, P>& window)
 {
    initializeOpenGLFunctions();
    initializeWindow(window.winId());
    initializeGL();
 }
 
+
+template<class T, class P> void
+QAbstractStereoRenderer::initialize(const QStereoOffscreenSurface<T, P>&)
+{
+   initializeOpenGLFunctions();
+   initializeOffscreen();
+   initializeGL();
+}
+
+
+template<class Renderer, class Policy> void
+QAbstractStereoRenderer::render()
+{
+   // Renderers without a frame loop that can be specialized fall back to their virtual interface.
+   apply();
+}
+
 QT_END_NAMESPACE
 
 #endif // QABSTRACTSTEREORENDERER_H
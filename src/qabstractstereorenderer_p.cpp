@@ -0,0 +1,54 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qabstractstereorenderer_p.h"
+#include "qstereotaskscheduler.h"
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions_3_2_Core>
+
+
+QAbstractStereoRendererPrivate::QAbstractStereoRendererPrivate(QAbstractStereoRenderer* const parent) :
+QObject(parent),
+parallelEyePreparationEnabled(false),
+taskScheduler(QStereoTaskScheduler::globalInstance()),
+frameFence(nullptr),
+renderThread(nullptr)
+{}
+
+
+QAbstractStereoRendererPrivate::~QAbstractStereoRendererPrivate()
+{
+   auto* const functions = frameFence != nullptr ? syncFunctions() : nullptr;
+   if (functions != nullptr)
+      functions->glDeleteSync(frameFence);
+}
+
+
+QOpenGLFunctions_3_2_Core*
+QAbstractStereoRendererPrivate::syncFunctions()
+{
+   // Sync objects require OpenGL 3.2. The functions are resolved once per context.
+   auto* const context = QOpenGLContext::currentContext();
+   auto* const functions = context != nullptr ? context->versionFunctions<QOpenGLFunctions_3_2_Core>() : nullptr;
+   return functions != nullptr && functions->initializeOpenGLFunctions() ? functions : nullptr;
+}
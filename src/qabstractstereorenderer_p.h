@@ -0,0 +1,59 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QABSTRACTSTEREORENDERER_P_H
+#define QABSTRACTSTEREORENDERER_P_H
+
+#include "qabstractstereorenderer.h"
+#include <QtCore/QMutex>
+#include <QtCore/QVector>
+#include <atomic>
+#include <QtGui/qopengl.h>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLFunctions_3_2_Core;
+class QThread;
+class QAbstractStereoRendererPrivate : public QObject
+{
+public:
+   explicit QAbstractStereoRendererPrivate(QAbstractStereoRenderer* const parent);
+   ~QAbstractStereoRendererPrivate();
+
+   static QOpenGLFunctions_3_2_Core* syncFunctions();
+
+   bool parallelEyePreparationEnabled;
+   QStereoTaskScheduler* taskScheduler;
+
+   mutable QMutex frameFenceMutex;
+   GLsync frameFence;
+
+   QMutex invocationMutex;
+   QVector<QAbstractStereoRenderer::Invocation> invocations;
+   std::atomic<QThread*> renderThread;
+};
+
+QT_END_NAMESPACE
+
+#endif // QABSTRACTSTEREORENDERER_P_H
@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoallocationcounter.h"
+#if defined(QTSTEREOSCOPY_ALLOCATION_COUNTER)
+#include <cstdlib>
+#include <new>
+
+
+namespace
+{
+   // Each thread counts its own allocations, so the render thread's count isn't disturbed by
+   // workers, and counting never requires synchronization.
+   thread_local quint64 allocationCount = 0;
+
+   void*
+   allocate(const std::size_t size)
+   {
+      ++allocationCount;
+      return std::malloc(size > 0 ? size : 1);
+   }
+
+   // Like the standard operator new, a failed allocation calls the installed new handler, which may free
+   // memory, and is retried until it succeeds or there is no handler left.
+   void*
+   allocateOrThrow(const std::size_t size)
+   {
+      forever
+      {
+         auto* const p = allocate(size);
+         if (p != nullptr)
+            return p;
+
+         const auto& handler = std::get_new_handler();
+         if (handler == nullptr)
+            throw std::bad_alloc();
+
+         handler();
+      }
+   }
+}
+
+
+void*
+operator new(std::size_t size)
+{
+   return allocateOrThrow(size);
+}
+
+
+void*
+operator new[](std::size_t size)
+{
+   return operator new(size);
+}
+
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+   try
+   {
+      return allocateOrThrow(size);
+   }
+   catch (const std::bad_alloc&)
+   {
+      return nullptr;
+   }
+}
+
+
+void*
+operator new[](std::size_t size, const std::nothrow_t& nothrow) noexcept
+{
+   return operator new(size, nothrow);
+}
+
+
+void
+operator delete(void* p) noexcept
+{
+   std::free(p);
+}
+
+
+void
+operator delete[](void* p) noexcept
+{
+   std::free(p);
+}
+
+
+#if defined(__cpp_sized_deallocation)
+void
+operator delete(void* p, std::size_t) noexcept
+{
+   std::free(p);
+}
+
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+   std::free(p);
+}
+#endif
+
+
+void
+operator delete(void* p, const std::nothrow_t&) noexcept
+{
+   std::free(p);
+}
+
+
+void
+operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+   std::free(p);
+}
+#endif
+
+
+bool
+QStereoAllocationCounter::enabled()
+{
+#if defined(QTSTEREOSCOPY_ALLOCATION_COUNTER)
+   return true;
+#else
+   return false;
+#endif
+}
+
+
+quint64
+QStereoAllocationCounter::count()
+{
+#if defined(QTSTEREOSCOPY_ALLOCATION_COUNTER)
+   return allocationCount;
+#else
+   return 0;
+#endif
+}
@@ -0,0 +1,279 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereocompositorlayer.h"
+#include "qstereocompositorlayer_p.h"
+#include "qstereoeyeparameters.h"
+#include "qstereotrace.h"
+
+
+QStereoCompositorLayer::QStereoCompositorLayer(const QSize& resolution, QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoCompositorLayerPrivate(this, resolution))
+{}
+
+
+const QSize&
+QStereoCompositorLayer::resolution() const
+{
+   Q_D(const QStereoCompositorLayer);
+   return d->resolution;
+}
+
+
+void
+QStereoCompositorLayer::setResolution(const QSize& resolution)
+{
+   Q_D(QStereoCompositorLayer);
+   if (d->resolution != resolution)
+   {
+      d->resolution = resolution;
+      d->dirty = true;
+   }
+}
+
+
+const QSizeF&
+QStereoCompositorLayer::size() const
+{
+   Q_D(const QStereoCompositorLayer);
+   return d->size;
+}
+
+
+void
+QStereoCompositorLayer::setSize(const QSizeF& size)
+{
+   Q_D(QStereoCompositorLayer);
+   d->size = size;
+}
+
+
+const QVector3D&
+QStereoCompositorLayer::position() const
+{
+   Q_D(const QStereoCompositorLayer);
+   return d->position;
+}
+
+
+void
+QStereoCompositorLayer::setPosition(const QVector3D& position)
+{
+   Q_D(QStereoCompositorLayer);
+   d->position = position;
+}
+
+
+const QQuaternion&
+QStereoCompositorLayer::orientation() const
+{
+   Q_D(const QStereoCompositorLayer);
+   return d->orientation;
+}
+
+
+void
+QStereoCompositorLayer::setOrientation(const QQuaternion& orientation)
+{
+   Q_D(QStereoCompositorLayer);
+   d->orientation = orientation;
+}
+
+
+bool
+QStereoCompositorLayer::isHeadLocked() const
+{
+   Q_D(const QStereoCompositorLayer);
+   return d->headLocked;
+}
+
+
+void
+QStereoCompositorLayer::setHeadLocked(const bool locked)
+{
+   Q_D(QStereoCompositorLayer);
+   d->headLocked = locked;
+}
+
+
+bool
+QStereoCompositorLayer::isVisible() const
+{
+   Q_D(const QStereoCompositorLayer);
+   return d->visible;
+}
+
+
+void
+QStereoCompositorLayer::setVisible(const bool visible)
+{
+   Q_D(QStereoCompositorLayer);
+   d->visible = visible;
+}
+
+
+const int&
+QStereoCompositorLayer::updateInterval() const
+{
+   Q_D(const QStereoCompositorLayer);
+   return d->updateInterval;
+}
+
+
+void
+QStereoCompositorLayer::setUpdateInterval(const int& msec)
+{
+   Q_D(QStereoCompositorLayer);
+   d->updateInterval = qMax(0, msec);
+}
+
+
+void
+QStereoCompositorLayer::update()
+{
+   Q_D(QStereoCompositorLayer);
+   d->dirty = true;
+}
+
+
+bool
+QStereoCompositorLayer::needsUpdate() const
+{
+   Q_D(const QStereoCompositorLayer);
+   if (d->dirty || !d->lastUpdate.isValid())
+      return true;
+
+   return d->updateInterval > 0 && d->lastUpdate.hasExpired(d->updateInterval);
+}
+
+
+const QOpenGLFramebufferObject*
+QStereoCompositorLayer::framebufferObject() const
+{
+   Q_D(const QStereoCompositorLayer);
+   return d->fbo.data();
+}
+
+
+void
+QStereoCompositorLayer::refresh()
+{
+   Q_D(QStereoCompositorLayer);
+   if (!d->visible || !needsUpdate() || d->resolution.isEmpty())
+      return;
+
+   QSTEREO_TRACE_ZONE("QStereoCompositorLayer::refresh");
+   if (!d->initialized)
+   {
+      initializeOpenGLFunctions();
+      initializeGL();
+      d->initialized = true;
+   }
+   if (d->fbo == nullptr || d->fbo->size() != d->resolution)
+   {
+      d->fbo.reset(new QOpenGLFramebufferObject(d->resolution));
+      if (!d->fbo->isValid())
+         qFatal("[QtStereoscopy] Error: Could not create the compositor layer's framebuffer object.");
+   }
+
+   // The layer is drawn at its own resolution and starts out fully transparent, so that only what
+   // paintGL draws covers the eye buffers. The viewport and clear color belong to the caller.
+   GLint viewport[4];
+   GLfloat clearColor[4];
+   glGetIntegerv(GL_VIEWPORT, viewport);
+   glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+   d->fbo->bind();
+   glViewport(0, 0, d->resolution.width(), d->resolution.height());
+   glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+   glClear(GL_COLOR_BUFFER_BIT);
+   paintGL();
+   d->fbo->release();
+
+   glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+   glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+   d->dirty = false;
+   d->lastUpdate.start();
+}
+
+
+void
+QStereoCompositorLayer::composite(const QStereoEyeParameters& parameters)
+{
+   Q_D(QStereoCompositorLayer);
+   if (!d->visible || d->fbo == nullptr || (d->program == nullptr && !d->createProgram()))
+      return;
+
+   // A head-locked layer only moves with the eye's offset from the head's center, so it stays put in
+   // the field of view. Any other layer is placed in the world and seen through the eye's view matrix.
+   QMatrix4x4 view;
+   if (d->headLocked)
+      view.translate(parameters.viewAdjust());
+   else
+      view = parameters.view();
+
+   static const GLfloat quad[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+   const auto& viewport = parameters.viewport();
+   const auto& depthTest = glIsEnabled(GL_DEPTH_TEST);
+   const auto& cullFace = glIsEnabled(GL_CULL_FACE);
+   const auto& blend = glIsEnabled(GL_BLEND);
+   GLint blendFunc[4];
+   glGetIntegerv(GL_BLEND_SRC_RGB, &blendFunc[0]);
+   glGetIntegerv(GL_BLEND_DST_RGB, &blendFunc[1]);
+   glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendFunc[2]);
+   glGetIntegerv(GL_BLEND_DST_ALPHA, &blendFunc[3]);
+
+   // The layer's texture holds premultiplied alpha and is drawn over the eye's content.
+   glViewport(viewport.x(), viewport.y(), viewport.width(), viewport.height());
+   glDisable(GL_DEPTH_TEST);
+   glDisable(GL_CULL_FACE);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+   d->program->bind();
+   d->program->setUniformValue("transform", parameters.perspective() * view * d->model());
+   d->program->setUniformValue("layer", 0);
+   glActiveTexture(GL_TEXTURE0);
+   glBindTexture(GL_TEXTURE_2D, d->fbo->texture());
+   d->program->enableAttributeArray(0);
+   d->program->setAttributeArray(0, quad, 2);
+   glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+   d->program->disableAttributeArray(0);
+   glBindTexture(GL_TEXTURE_2D, 0);
+   d->program->release();
+
+   glBlendFuncSeparate(blendFunc[0], blendFunc[1], blendFunc[2], blendFunc[3]);
+   if (!blend)
+      glDisable(GL_BLEND);
+   if (cullFace)
+      glEnable(GL_CULL_FACE);
+   if (depthTest)
+      glEnable(GL_DEPTH_TEST);
+}
+
+
+void
+QStereoCompositorLayer::initializeGL()
+{}
@@ -0,0 +1,83 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOCOMPOSITORLAYER_H
+#define QSTEREOCOMPOSITORLAYER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QSize>
+#include <QtCore/QSizeF>
+#include <QtGui/QOpenGLFunctions>
+#include <QtGui/QQuaternion>
+#include <QtGui/QVector3D>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLFramebufferObject;
+class QStereoEyeParameters;
+class QStereoCompositorLayerPrivate;
+class QStereoCompositorLayer : public QObject, protected QOpenGLFunctions
+{
+public:
+   explicit QStereoCompositorLayer(const QSize& resolution, QObject* const parent = nullptr);
+
+   const QSize& resolution() const;
+   void setResolution(const QSize& resolution);
+
+   const QSizeF& size() const;
+   void setSize(const QSizeF& size);
+
+   const QVector3D& position() const;
+   void setPosition(const QVector3D& position);
+
+   const QQuaternion& orientation() const;
+   void setOrientation(const QQuaternion& orientation);
+
+   bool isHeadLocked() const;
+   void setHeadLocked(const bool locked = true);
+
+   bool isVisible() const;
+   void setVisible(const bool visible = true);
+
+   const int& updateInterval() const;
+   void setUpdateInterval(const int& msec);
+
+   void update();
+   bool needsUpdate() const;
+
+   const QOpenGLFramebufferObject* framebufferObject() const;
+
+   void refresh();
+   void composite(const QStereoEyeParameters& parameters);
+protected:
+   virtual void initializeGL();
+   virtual void paintGL() = 0;
+private:
+   QStereoCompositorLayerPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoCompositorLayer);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOCOMPOSITORLAYER_H
@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereocompositorlayer_p.h"
+
+
+QStereoCompositorLayerPrivate::QStereoCompositorLayerPrivate(QStereoCompositorLayer* const parent, const QSize& resolution) :
+QObject(parent),
+resolution(resolution),
+size(1.0, resolution.width() > 0 ? static_cast<qreal>(resolution.height()) / resolution.width() : 1.0),
+position(0.0f, 0.0f, -1.0f),
+headLocked(true),
+visible(true),
+updateInterval(0),
+dirty(true),
+initialized(false),
+fbo(nullptr),
+program(nullptr)
+{}
+
+
+bool
+QStereoCompositorLayerPrivate::createProgram()
+{
+   // The quad spans [-1, 1] in both directions and is scaled to the layer's size by the model matrix.
+   static const char* const vertexShader =
+      "#version 120\n"
+      "attribute vec2 vertex;\n"
+      "uniform mat4 transform;\n"
+      "varying vec2 texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "   texCoord = 0.5 * vertex + 0.5;\n"
+      "   gl_Position = transform * vec4(vertex, 0.0, 1.0);\n"
+      "}\n";
+   static const char* const fragmentShader =
+      "#version 120\n"
+      "uniform sampler2D layer;\n"
+      "varying vec2 texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "   gl_FragColor = texture2D(layer, texCoord);\n"
+      "}\n";
+
+   program.reset(new QOpenGLShaderProgram);
+   program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShader);
+   program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShader);
+   program->bindAttributeLocation("vertex", 0);
+   if (!program->link())
+   {
+      qWarning("[QtStereoscopy] Warning: Could not link the compositor layer's shader program.");
+      program.reset();
+      return false;
+   }
+   return true;
+}
+
+
+QMatrix4x4
+QStereoCompositorLayerPrivate::model() const
+{
+   QMatrix4x4 model;
+   model.translate(position);
+   model.rotate(orientation);
+   model.scale(0.5f * size.width(), 0.5f * size.height(), 1.0f);
+
+   return model;
+}
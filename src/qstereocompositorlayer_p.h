@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOCOMPOSITORLAYER_P_H
+#define QSTEREOCOMPOSITORLAYER_P_H
+
+#include "qstereocompositorlayer.h"
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QMatrix4x4>
+#include <QtGui/QOpenGLFramebufferObject>
+#include <QtGui/QOpenGLShaderProgram>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoCompositorLayerPrivate : public QObject
+{
+public:
+   QStereoCompositorLayerPrivate(QStereoCompositorLayer* const parent, const QSize& resolution);
+
+   bool createProgram();
+   QMatrix4x4 model() const;
+
+   QSize resolution;
+   QSizeF size;
+   QVector3D position;
+   QQuaternion orientation;
+   bool headLocked;
+   bool visible;
+   int updateInterval;
+   bool dirty;
+   bool initialized;
+   QElapsedTimer lastUpdate;
+   QScopedPointer<QOpenGLFramebufferObject> fbo;
+   QScopedPointer<QOpenGLShaderProgram> program;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOCOMPOSITORLAYER_P_H
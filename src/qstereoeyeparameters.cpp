@@ -173,43 +173,43 @@ QStereoEyeParameters::setOrtho(const QMatrix4x4& ortho)
 }
 
 
-const float&
+float
 QStereoEyeParameters::orthoDistance()
 {
-   return QStereoEyeParametersPrivate::ORTHO_DISTANCE;
+   return QStereoEyeParametersPrivate::ORTHO_DISTANCE.load();
 }
 
 
 void
 QStereoEyeParameters::setOrthoDistance(const float& distance)
 {
-   QStereoEyeParametersPrivate::ORTHO_DISTANCE = distance;
+   QStereoEyeParametersPrivate::ORTHO_DISTANCE.store(distance);
 }
 
 
-const float&
+float
 QStereoEyeParameters::nearClippingDistance()
 {
-   return QStereoEyeParametersPrivate::NEAR_CLIPPING_DISTANCE;
+   return QStereoEyeParametersPrivate::NEAR_CLIPPING_DISTANCE.load();
 }
 
 
 void
 QStereoEyeParameters::setNearClippingDistance(const float& distance)
 {
-   QStereoEyeParametersPrivate::NEAR_CLIPPING_DISTANCE = distance;
+   QStereoEyeParametersPrivate::NEAR_CLIPPING_DISTANCE.store(distance);
 }
 
 
-const float&
+float
 QStereoEyeParameters::farClippingDistance()
 {
-   return QStereoEyeParametersPrivate::FAR_CLIPPING_DISTANCE;
+   return QStereoEyeParametersPrivate::FAR_CLIPPING_DISTANCE.load();
 }
 
 
 void
 QStereoEyeParameters::setFarClippingDistance(const float& distance)
 {
-   QStereoEyeParametersPrivate::FAR_CLIPPING_DISTANCE = distance;
+   QStereoEyeParametersPrivate::FAR_CLIPPING_DISTANCE.store(distance);
 }
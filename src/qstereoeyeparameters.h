@@ -40,13 +40,13 @@ public:
    const QMatrix4x4& ortho() const;
    void setOrtho(const QMatrix4x4& ortho);
 
-   static const float& orthoDistance();
+   static float orthoDistance();
    static void setOrthoDistance(const float& distance);
 
-   static const float& nearClippingDistance();
+   static float nearClippingDistance();
    static void setNearClippingDistance(const float& distance);
 
-   static const float& farClippingDistance();
+   static float farClippingDistance();
    static void setFarClippingDistance(const float& distance);
 private:
    QStereoEyeParametersPrivate* const d_ptr;
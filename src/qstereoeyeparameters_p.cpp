@@ -24,9 +24,9 @@
 #include "qstereoeyeparameters_p.h"
 
 
-float QStereoEyeParametersPrivate::ORTHO_DISTANCE = 0.8f;
-float QStereoEyeParametersPrivate::NEAR_CLIPPING_DISTANCE = 0.01f;
-float QStereoEyeParametersPrivate::FAR_CLIPPING_DISTANCE = 10000.0f;
+std::atomic<float> QStereoEyeParametersPrivate::ORTHO_DISTANCE(0.8f);
+std::atomic<float> QStereoEyeParametersPrivate::NEAR_CLIPPING_DISTANCE(0.01f);
+std::atomic<float> QStereoEyeParametersPrivate::FAR_CLIPPING_DISTANCE(10000.0f);
 
 
 QStereoEyeParametersPrivate::QStereoEyeParametersPrivate(QStereoEyeParameters* const parent) :
@@ -28,11 +28,12 @@
 #include "qeye.h"
 #include <QPointF>
 #include <QMatrix4x4>
+#include <atomic>
 
 
 QT_BEGIN_NAMESPACE
 
-struct QStereoEyeParametersPrivate : public QObject
+class QStereoEyeParametersPrivate : public QObject
 {
 public:
    explicit QStereoEyeParametersPrivate(QStereoEyeParameters* const parent);
@@ -48,9 +49,9 @@ public:
    QMatrix4x4 ortho;
    QMatrix4x4 perspective;
 
-   static float ORTHO_DISTANCE;
-   static float NEAR_CLIPPING_DISTANCE;
-   static float FAR_CLIPPING_DISTANCE;
+   static std::atomic<float> ORTHO_DISTANCE;
+   static std::atomic<float> NEAR_CLIPPING_DISTANCE;
+   static std::atomic<float> FAR_CLIPPING_DISTANCE;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoframecapture_p.h"
+#include <algorithm>
+
+
+QStereoFrameCapture::QStereoFrameCapture(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoFrameCapturePrivate(this))
+{}
+
+
+QStereoFrameCapture::~QStereoFrameCapture()
+{
+   // Pending transfers can only be handed over while the context they were queued in is current.
+   Q_D(QStereoFrameCapture);
+   d->flush();
+}
+
+
+bool
+QStereoFrameCapture::enabled() const
+{
+   Q_D(const QStereoFrameCapture);
+   return d->enabled;
+}
+
+
+void
+QStereoFrameCapture::enable(const bool enable)
+{
+   Q_D(QStereoFrameCapture);
+   if (d->enabled && !enable)
+      d->flush();
+   d->enabled = enable;
+}
+
+
+const unsigned int&
+QStereoFrameCapture::frameInterval() const
+{
+   Q_D(const QStereoFrameCapture);
+   return d->frameInterval;
+}
+
+
+void
+QStereoFrameCapture::setFrameInterval(const unsigned int& interval)
+{
+   Q_D(QStereoFrameCapture);
+   d->frameInterval = std::max(interval, 1u);
+}
+
+
+QStereoVideoEncoder*
+QStereoFrameCapture::encoder() const
+{
+   Q_D(const QStereoFrameCapture);
+   return d->encoder;
+}
+
+
+void
+QStereoFrameCapture::setEncoder(QStereoVideoEncoder* const encoder)
+{
+   Q_D(QStereoFrameCapture);
+   d->encoder = encoder;
+}
+
+
+const quint64&
+QStereoFrameCapture::capturedFrameCount() const
+{
+   Q_D(const QStereoFrameCapture);
+   return d->capturedFrameCount;
+}
+
+
+const quint64&
+QStereoFrameCapture::droppedFrameCount() const
+{
+   Q_D(const QStereoFrameCapture);
+   return d->droppedFrameCount;
+}
+
+
+void
+QStereoFrameCapture::capture(const QOpenGLFramebufferObject& fbo)
+{
+   Q_D(QStereoFrameCapture);
+   if (d->enabled && d->encoder != nullptr && (d->frameCount++ % d->frameInterval) == 0)
+      d->capture(fbo, nullptr);
+}
+
+
+void
+QStereoFrameCapture::capture(const QOpenGLFramebufferObject& left, const QOpenGLFramebufferObject& right)
+{
+   Q_D(QStereoFrameCapture);
+   if (d->enabled && d->encoder != nullptr && (d->frameCount++ % d->frameInterval) == 0)
+      d->capture(left, &right);
+}
+
+
+void
+QStereoFrameCapture::flush()
+{
+   Q_D(QStereoFrameCapture);
+   d->flush();
+}
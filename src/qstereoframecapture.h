@@ -0,0 +1,73 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOFRAMECAPTURE_H
+#define QSTEREOFRAMECAPTURE_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QSize>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLFramebufferObject;
+class QStereoVideoEncoder;
+class QStereoFrameCapturePrivate;
+class QStereoFrameCapture : public QObject
+{
+public:
+   struct Frame
+   {
+      QByteArray pixels;
+      QSize size;
+      quint64 index;
+      qint64 timestamp;
+   };
+
+   explicit QStereoFrameCapture(QObject* const parent = nullptr);
+   ~QStereoFrameCapture();
+
+   bool enabled() const;
+   void enable(const bool enable = true);
+
+   const unsigned int& frameInterval() const;
+   void setFrameInterval(const unsigned int& interval);
+
+   QStereoVideoEncoder* encoder() const;
+   void setEncoder(QStereoVideoEncoder* const encoder);
+
+   const quint64& capturedFrameCount() const;
+   const quint64& droppedFrameCount() const;
+
+   void capture(const QOpenGLFramebufferObject& fbo);
+   void capture(const QOpenGLFramebufferObject& left, const QOpenGLFramebufferObject& right);
+   void flush();
+private:
+   QStereoFrameCapturePrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoFrameCapture);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOFRAMECAPTURE_H
@@ -0,0 +1,275 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoframecapture_p.h"
+#include "qstereovideoencoder.h"
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFramebufferObject>
+#include <QtGui/QOpenGLFunctions>
+#include <QtGui/QOpenGLFunctions_3_2_Core>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+QStereoFrameCapturePrivate::QStereoFrameCapturePrivate(QStereoFrameCapture* const parent) :
+QObject(parent),
+nextBuffer(0),
+splitWidth(0),
+context(nullptr),
+sync(nullptr),
+encoder(nullptr),
+enabled(true),
+frameInterval(1),
+frameCount(0),
+capturedFrameCount(0),
+droppedFrameCount(0)
+{
+   for (auto& buffer : buffers)
+      buffer = QOpenGLBuffer(QOpenGLBuffer::PixelPackBuffer);
+
+   for (auto& transfer : transfers)
+      transfer = Transfer({false, 0, 0, nullptr});
+
+   clock.start();
+}
+
+
+void
+QStereoFrameCapturePrivate::capture(const QOpenGLFramebufferObject& left, const QOpenGLFramebufferObject* const right)
+{
+   auto* const current = QOpenGLContext::currentContext();
+   if (Q_UNLIKELY(current == nullptr))
+      return;
+
+   // Fences tell when a transfer has completed without waiting for it. Without them, which requires
+   // OpenGL 3.2, a buffer is assumed to be ready once bufferCount() frames have passed.
+   if (context == nullptr)
+   {
+      context = current;
+      sync = context->versionFunctions<QOpenGLFunctions_3_2_Core>();
+      if (sync != nullptr && !sync->initializeOpenGLFunctions())
+         sync = nullptr;
+   }
+   else if (Q_UNLIKELY(current != context))
+   {
+      qWarning("[QtStereoscopy] Warning: Frames can only be captured from a single context.");
+      return;
+   }
+
+   // Eyes that are rendered into separate targets are captured side by side into a single frame, bottom-aligned
+   // like the eyes of a shared target.
+   auto* const gl = context->functions();
+   const auto& frameSize = right != nullptr ? QSize(left.width() + right->width(), std::max(left.height(), right->height())) : left.size();
+   const auto& split = right != nullptr ? left.width() : 0;
+   if (frameSize != size || split != splitWidth)
+      resize(frameSize, split);
+
+   // Transfers the GPU has completed are handed over oldest first, which keeps them in order.
+   for (unsigned int i = 0; i < bufferCount(); ++i)
+   {
+      const auto& slot = (nextBuffer + i) % bufferCount();
+      if (!transfers[slot].pending)
+         continue;
+      if (!isComplete(slot))
+         break;
+      deliver(slot);
+   }
+
+   // A buffer that is still being written to means the GPU is more than bufferCount() frames behind.
+   // Its frame is dropped rather than waited for, since the render loop must never stall.
+   const auto slot = nextBuffer;
+   nextBuffer = (nextBuffer + 1) % bufferCount();
+   if (transfers[slot].pending)
+   {
+      release(slot);
+      ++droppedFrameCount;
+   }
+
+   // Queue an asynchronous read-back of the eye buffer: with a pixel pack buffer bound, glReadPixels
+   // returns immediately and the copy is performed by the GPU.
+   GLint previousFramebuffer = 0;
+   gl->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+   auto& buffer = buffers[slot];
+   buffer.bind();
+   gl->glPixelStorei(GL_PACK_ALIGNMENT, 4);
+   gl->glPixelStorei(GL_PACK_ROW_LENGTH, right != nullptr ? size.width() : 0);
+   gl->glBindFramebuffer(GL_FRAMEBUFFER, left.handle());
+   gl->glReadPixels(0, 0, left.width(), left.height(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+   if (right != nullptr)
+   {
+      // The right eye's rows start after the left eye's, at a byte offset into the bound buffer.
+      const auto& offset = static_cast<std::uintptr_t>(4 * splitWidth);
+      gl->glBindFramebuffer(GL_FRAMEBUFFER, right->handle());
+      gl->glReadPixels(0, 0, right->width(), right->height(), GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<GLvoid*>(offset));
+      gl->glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+   }
+   buffer.release();
+
+   gl->glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+
+   const auto& fence = sync != nullptr ? sync->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+   transfers[slot] = Transfer({true, capturedFrameCount++, clock.nsecsElapsed(), fence});
+}
+
+
+void
+QStereoFrameCapturePrivate::resize(const QSize& newSize, const int& newSplitWidth)
+{
+   // Pending transfers refer to the previous layout, so they're handed over before the buffers are reallocated.
+   flush();
+
+   // When eyes of different heights are captured side by side, the rows above the shorter eye are never read
+   // into. The buffers are then cleared once, so that those rows are black rather than undefined.
+   size = newSize;
+   splitWidth = newSplitWidth;
+   pixelPool.clear();
+   const auto& byteCount = size.width() * size.height() * 4;
+   const auto& clear = splitWidth > 0 ? QByteArray(byteCount, 0) : QByteArray();
+   for (unsigned int i = 0; i < bufferCount(); ++i)
+   {
+      auto& buffer = buffers[i];
+      if (!buffer.isCreated() && Q_UNLIKELY(!buffer.create()))
+         qFatal("[QtStereoscopy] Error: Could not create a pixel pack buffer.");
+
+      buffer.bind();
+      buffer.setUsagePattern(QOpenGLBuffer::StreamRead);
+      if (clear.isEmpty())
+         buffer.allocate(byteCount);
+      else
+         buffer.allocate(clear.constData(), byteCount);
+      buffer.release();
+   }
+}
+
+
+bool
+QStereoFrameCapturePrivate::isComplete(const unsigned int& slot) const
+{
+   const auto& fence = transfers[slot].fence;
+   if (fence == nullptr)
+      return slot == nextBuffer;
+
+   const auto& status = sync->glClientWaitSync(fence, 0, 0);
+   return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+
+void
+QStereoFrameCapturePrivate::deliver(const unsigned int& slot)
+{
+   const auto transfer = transfers[slot];
+   release(slot);
+
+   // If the encoder is saturated, do not even bother mapping the buffer.
+   if (encoder == nullptr || encoder->isFull())
+   {
+      ++droppedFrameCount;
+      return;
+   }
+
+   auto& buffer = buffers[slot];
+   buffer.bind();
+   const auto* const data = static_cast<const char*>(buffer.map(QOpenGLBuffer::ReadOnly));
+   if (data != nullptr)
+   {
+      auto& pixels = pooledPixels();
+      std::memcpy(pixels.data(), data, pixels.size());
+
+      const QStereoFrameCapture::Frame frame =
+      {
+         pixels,
+         size,
+         transfer.index,
+         transfer.timestamp
+      };
+      buffer.unmap();
+
+      if (!encoder->submit(frame))
+         ++droppedFrameCount;
+   }
+   else
+   {
+      qWarning("[QtStereoscopy] Warning: Could not map a pixel pack buffer.");
+      ++droppedFrameCount;
+   }
+   buffer.release();
+}
+
+
+void
+QStereoFrameCapturePrivate::release(const unsigned int& slot)
+{
+   auto& transfer = transfers[slot];
+   if (transfer.fence != nullptr)
+   {
+      sync->glDeleteSync(transfer.fence);
+      transfer.fence = nullptr;
+   }
+   transfer.pending = false;
+}
+
+
+QByteArray&
+QStereoFrameCapturePrivate::pooledPixels()
+{
+   // Frames are shared with the encoder, which drops its reference once a frame is encoded. Any pixels that
+   // are no longer shared are reused, so the pool only grows until it covers the frames the encoder holds.
+   for (auto& pixels : pixelPool)
+   {
+      if (pixels.isDetached())
+         return pixels;
+   }
+   pixelPool.append(QByteArray(size.width() * size.height() * 4, Qt::Uninitialized));
+   return pixelPool.last();
+}
+
+
+void
+QStereoFrameCapturePrivate::flush()
+{
+   if (!isContextCurrent())
+      return;
+
+   // Every pending transfer is waited for, oldest first. This only happens when capturing stops or the
+   // frame size changes, so the stall doesn't recur every frame.
+   for (unsigned int i = 0; i < bufferCount(); ++i)
+   {
+      const auto& slot = (nextBuffer + i) % bufferCount();
+      auto& transfer = transfers[slot];
+      if (!transfer.pending)
+         continue;
+
+      if (transfer.fence != nullptr)
+         sync->glClientWaitSync(transfer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+      deliver(slot);
+   }
+}
+
+
+bool
+QStereoFrameCapturePrivate::isContextCurrent() const
+{
+   return context != nullptr && QOpenGLContext::currentContext() == context;
+}
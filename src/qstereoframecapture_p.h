@@ -0,0 +1,85 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOFRAMECAPTURE_P_H
+#define QSTEREOFRAMECAPTURE_P_H
+
+#include "qstereoframecapture.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QVector>
+#include <QtGui/QOpenGLBuffer>
+#include <QtGui/qopengl.h>
+#include <array>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLContext;
+class QOpenGLFunctions_3_2_Core;
+
+class QStereoFrameCapturePrivate : public QObject
+{
+public:
+   explicit QStereoFrameCapturePrivate(QStereoFrameCapture* const parent);
+
+   void capture(const QOpenGLFramebufferObject& left, const QOpenGLFramebufferObject* const right);
+   void resize(const QSize& size, const int& splitWidth);
+   bool isComplete(const unsigned int& slot) const;
+   void deliver(const unsigned int& slot);
+   void release(const unsigned int& slot);
+   QByteArray& pooledPixels();
+   void flush();
+   bool isContextCurrent() const;
+
+   static Q_DECL_CONSTEXPR unsigned int bufferCount(){ return 3; }
+
+   struct Transfer
+   {
+      bool pending;
+      quint64 index;
+      qint64 timestamp;
+      GLsync fence;
+   };
+
+   std::array<QOpenGLBuffer, 3> buffers;
+   std::array<Transfer, 3> transfers;
+   unsigned int nextBuffer;
+   QVector<QByteArray> pixelPool;
+
+   QSize size;
+   int splitWidth;
+   QOpenGLContext* context;
+   QOpenGLFunctions_3_2_Core* sync;
+   QElapsedTimer clock;
+   QStereoVideoEncoder* encoder;
+
+   bool enabled;
+   unsigned int frameInterval;
+   quint64 frameCount;
+   quint64 capturedFrameCount;
+   quint64 droppedFrameCount;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOFRAMECAPTURE_P_H
@@ -0,0 +1,123 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOFRAMESEQUENCE_H
+#define QSTEREOFRAMESEQUENCE_H
+
+#include "qabstractstereorenderer.h"
+#include "qstereoframecapture.h"
+#include "qstereoframetiming.h"
+#include "qstereorenderpolicy.h"
+#include "qstereoresourceloader.h"
+#include "qstereotaskscheduler.h"
+#include <initializer_list>
+
+
+QT_BEGIN_NAMESPACE
+
+template<class Renderer, class Policy>
+class QStereoFrameSequence
+{
+   static_assert(std::is_base_of<QAbstractStereoRenderer, Renderer>::value, "Renderer must derive from QAbstractStereoRenderer.");
+public:
+   template<class Present>
+   static void renderFrame
+   (
+      Renderer& renderer,
+      std::initializer_list<QStereoResourceLoader*> resourceLoaders,
+      QStereoFrameCapture* const capture,
+      const Present& present
+   );
+private:
+   QStereoFrameSequence() = delete;
+};
+
+
+template<class T, class P> template<class Present> void
+QStereoFrameSequence<T, P>::renderFrame
+(
+   T& renderer,
+   std::initializer_list<QStereoResourceLoader*> resourceLoaders,
+   QStereoFrameCapture* const capture,
+   const Present& present
+)
+{
+   // Features that the policy leaves out are resolved at compile time, so their branches disappear.
+   using Feature = QStereoRenderFeature;
+
+   // Configuration changes that other threads handed over are applied before anything else, so that they
+   // never change in the middle of a frame.
+   renderer.processInvocations();
+
+   // Resources whose uploads have completed are handed over before the frame is rendered.
+   if (P::hasFeature(Feature::ResourceLoading))
+   {
+      for (auto* const loader : resourceLoaders)
+      {
+         if (loader != nullptr)
+            loader->collect();
+      }
+   }
+
+   // Tasks that were due next frame become due this frame, and must all be finished before the frame
+   // is presented. Their timings are then added to the renderer's frame statistics.
+   auto* const scheduler = renderer.taskScheduler();
+   if (P::hasFeature(Feature::TaskScheduling))
+      scheduler->beginFrame();
+
+   // The renderer's frame loop is specialized on the concrete renderer and the policy. With the
+   // default policy, this is the renderer's apply().
+   renderer.template render<T, P>();
+
+   if (P::hasFeature(Feature::TaskScheduling))
+      scheduler->endFrame(renderer.frameStatistics());
+
+   // Queue a read-back of the frame's eye buffers. The transfer is asynchronous and frames are
+   // dropped under back-pressure, so capturing never holds up the render loop. Eyes that have
+   // separate targets are captured side by side, like eyes that share one.
+   if (P::hasFeature(Feature::FrameCapture) && capture != nullptr)
+   {
+      const auto* const left = renderer.framebufferObject(QEye::Left);
+      const auto* const right = renderer.framebufferObject(QEye::Right);
+      if (left != nullptr && right != nullptr && left != right)
+         capture->capture(*left, *right);
+      else if (left != nullptr)
+         capture->capture(*left);
+   }
+
+   // Contexts that sample the eye buffers, such as a mirror window's, wait on this fence so that they
+   // only see completed frames.
+   renderer.fenceFrame();
+   present();
+
+   if (P::hasFeature(Feature::FrameTiming))
+   {
+      auto* const timing = renderer.frameTiming();
+      if (timing != nullptr)
+         timing->frameSwapped();
+   }
+}
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOFRAMESEQUENCE_H
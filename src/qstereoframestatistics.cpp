@@ -0,0 +1,212 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoframestatistics.h"
+#include "qstereoframestatistics_p.h"
+
+
+QStereoFrameStatistics::QStereoFrameStatistics(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoFrameStatisticsPrivate(this))
+{}
+
+
+void
+QStereoFrameStatistics::record(const QStereoFrameTiming::Frame& frame)
+{
+   Q_D(QStereoFrameStatistics);
+
+   // Frames are recorded in order, so the interval is measured from the previous frame. Values
+   // that weren't measured are negative, and are ignored by the histograms.
+   const auto& interval = d->lastBeginFrameTime >= 0.0 ? frame.beginFrameTime - d->lastBeginFrameTime : -1.0;
+   d->lastBeginFrameTime = frame.beginFrameTime;
+
+   d->histogram(Stage::FrameInterval).record(interval);
+   if (frame.endFrameTime >= 0.0)
+      d->histogram(Stage::FrameTime).record(frame.endFrameTime - frame.beginFrameTime);
+
+   // An eye's pose is sampled when its rendering begins, and both eyes are submitted when the frame ends.
+   const Stage cpu[] = {Stage::LeftEyeCpuTime, Stage::RightEyeCpuTime};
+   const Stage gpu[] = {Stage::LeftEyeGpuTime, Stage::RightEyeGpuTime};
+   const Stage poseToSubmit[] = {Stage::LeftEyePoseToSubmit, Stage::RightEyePoseToSubmit};
+   for (unsigned int e = 0; e < 2; ++e)
+   {
+      if (frame.beginEyeTime[e] < 0.0)
+         continue;
+
+      if (frame.endEyeTime[e] >= 0.0)
+         d->histogram(cpu[e]).record(frame.endEyeTime[e] - frame.beginEyeTime[e]);
+      if (frame.endFrameTime >= 0.0)
+         d->histogram(poseToSubmit[e]).record(frame.endFrameTime - frame.beginEyeTime[e]);
+
+      d->histogram(gpu[e]).record(frame.eyeGpuDuration[e]);
+   }
+}
+
+
+void
+QStereoFrameStatistics::reset()
+{
+   Q_D(QStereoFrameStatistics);
+   for (auto& histogram : d->histograms)
+      histogram.reset();
+
+   QMutexLocker locker(&d->taskMutex);
+   for (auto* const histogram : d->taskHistograms)
+      histogram->reset();
+}
+
+
+QStereoHistogram&
+QStereoFrameStatistics::histogram(const Stage& stage)
+{
+   Q_D(QStereoFrameStatistics);
+   return d->histogram(stage);
+}
+
+
+const QStereoHistogram&
+QStereoFrameStatistics::histogram(const Stage& stage) const
+{
+   Q_D(const QStereoFrameStatistics);
+   return d->histograms[static_cast<unsigned int>(stage)];
+}
+
+
+void
+QStereoFrameStatistics::recordTask(const QByteArray& name, const double& seconds)
+{
+   Q_D(QStereoFrameStatistics);
+   QStereoHistogram* histogram = nullptr;
+   {
+      QMutexLocker locker(&d->taskMutex);
+      histogram = d->taskHistograms.value(name, nullptr);
+      if (histogram == nullptr)
+      {
+         histogram = new QStereoHistogram(d);
+         d->taskHistograms.insert(name, histogram);
+      }
+   }
+   histogram->record(seconds);
+}
+
+
+QList<QByteArray>
+QStereoFrameStatistics::taskNames() const
+{
+   Q_D(const QStereoFrameStatistics);
+   QMutexLocker locker(&d->taskMutex);
+   return d->taskHistograms.keys();
+}
+
+
+const QStereoHistogram*
+QStereoFrameStatistics::taskHistogram(const QByteArray& name) const
+{
+   Q_D(const QStereoFrameStatistics);
+   QMutexLocker locker(&d->taskMutex);
+   return d->taskHistograms.value(name, nullptr);
+}
+
+
+QByteArray
+QStereoFrameStatistics::toCsv() const
+{
+   // Times are given in milliseconds. Each task is reported as a stage of its own, prefixed with 'task:'.
+   QByteArray csv("stage,count,min,mean,p50,p95,p99,max\n");
+   const auto& row = [&csv](const QByteArray& name, const QStereoHistogram::Snapshot& s)
+   {
+      const auto& ms = [](const double& seconds){ return QByteArray::number(1e3 * seconds, 'f', 3); };
+
+      csv += name + "," + QByteArray::number(s.count);
+      csv += "," + ms(s.minimum) + "," + ms(s.mean());
+      csv += "," + ms(s.percentile(50)) + "," + ms(s.percentile(95)) + "," + ms(s.percentile(99));
+      csv += "," + ms(s.maximum) + "\n";
+   };
+
+   for (unsigned int i = 0; i < stageCount(); ++i)
+   {
+      const auto& stage = static_cast<Stage>(i);
+      row(stageName(stage), histogram(stage).snapshot());
+   }
+   for (const auto& name : taskNames())
+      row("task:" + name, taskHistogram(name)->snapshot());
+
+   return csv;
+}
+
+
+QByteArray
+QStereoFrameStatistics::toJson() const
+{
+   // Times are given in milliseconds. Each task is reported as a stage of its own, prefixed with 'task:'.
+   QByteArray json("{");
+   const auto& object = [&json](const QByteArray& name, const QStereoHistogram::Snapshot& s)
+   {
+      const auto& ms = [](const double& seconds){ return QByteArray::number(1e3 * seconds, 'f', 3); };
+
+      json += json.size() > 1 ? "," : "";
+      json += "\"" + name + "\":{\"count\":" + QByteArray::number(s.count);
+      json += ",\"min\":" + ms(s.minimum) + ",\"mean\":" + ms(s.mean());
+      json += ",\"p50\":" + ms(s.percentile(50)) + ",\"p95\":" + ms(s.percentile(95)) + ",\"p99\":" + ms(s.percentile(99));
+      json += ",\"max\":" + ms(s.maximum) + "}";
+   };
+
+   for (unsigned int i = 0; i < stageCount(); ++i)
+   {
+      const auto& stage = static_cast<Stage>(i);
+      object(stageName(stage), histogram(stage).snapshot());
+   }
+   for (const auto& name : taskNames())
+      object("task:" + name, taskHistogram(name)->snapshot());
+
+   json += "}";
+   return json;
+}
+
+
+const char*
+QStereoFrameStatistics::stageName(const Stage& stage)
+{
+   switch (stage)
+   {
+      case Stage::FrameInterval:
+         return "frameInterval";
+      case Stage::FrameTime:
+         return "frameTime";
+      case Stage::LeftEyeCpuTime:
+         return "leftEyeCpuTime";
+      case Stage::RightEyeCpuTime:
+         return "rightEyeCpuTime";
+      case Stage::LeftEyeGpuTime:
+         return "leftEyeGpuTime";
+      case Stage::RightEyeGpuTime:
+         return "rightEyeGpuTime";
+      case Stage::LeftEyePoseToSubmit:
+         return "leftEyePoseToSubmit";
+      case Stage::RightEyePoseToSubmit:
+         return "rightEyePoseToSubmit";
+      default:
+         return "";
+   }
+}
@@ -0,0 +1,74 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOFRAMESTATISTICS_H
+#define QSTEREOFRAMESTATISTICS_H
+
+#include "qstereoframetiming.h"
+#include "qstereohistogram.h"
+#include <QtCore/QList>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoFrameStatisticsPrivate;
+class QStereoFrameStatistics : public QObject
+{
+public:
+   enum class Stage
+   {
+      FrameInterval,
+      FrameTime,
+      LeftEyeCpuTime,
+      RightEyeCpuTime,
+      LeftEyeGpuTime,
+      RightEyeGpuTime,
+      LeftEyePoseToSubmit,
+      RightEyePoseToSubmit
+   };
+
+   explicit QStereoFrameStatistics(QObject* const parent = nullptr);
+
+   void record(const QStereoFrameTiming::Frame& frame);
+   void reset();
+
+   QStereoHistogram& histogram(const Stage& stage);
+   const QStereoHistogram& histogram(const Stage& stage) const;
+
+   void recordTask(const QByteArray& name, const double& seconds);
+   QList<QByteArray> taskNames() const;
+   const QStereoHistogram* taskHistogram(const QByteArray& name) const;
+
+   QByteArray toCsv() const;
+   QByteArray toJson() const;
+
+   static const char* stageName(const Stage& stage);
+   static Q_DECL_CONSTEXPR unsigned int stageCount(){ return 8; }
+private:
+   QStereoFrameStatisticsPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoFrameStatistics);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOFRAMESTATISTICS_H
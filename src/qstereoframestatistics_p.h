@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOFRAMESTATISTICS_P_H
+#define QSTEREOFRAMESTATISTICS_P_H
+
+#include "qstereoframestatistics.h"
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <array>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoFrameStatisticsPrivate : public QObject
+{
+public:
+   explicit QStereoFrameStatisticsPrivate(QStereoFrameStatistics* const parent);
+
+   QStereoHistogram& histogram(const QStereoFrameStatistics::Stage& stage);
+
+   std::array<QStereoHistogram, QStereoFrameStatistics::stageCount()> histograms;
+   double lastBeginFrameTime;
+
+   // Tasks are recorded from whichever thread ends a frame, so their histograms are created under a lock.
+   mutable QMutex taskMutex;
+   QMap<QByteArray, QStereoHistogram*> taskHistograms;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOFRAMESTATISTICS_P_H
@@ -0,0 +1,161 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoframetiming_p.h"
+#include <algorithm>
+
+
+QStereoFrameTiming::QStereoFrameTiming(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoFrameTimingPrivate(this))
+{}
+
+
+bool
+QStereoFrameTiming::enabled() const
+{
+   Q_D(const QStereoFrameTiming);
+   return d->enabled;
+}
+
+
+void
+QStereoFrameTiming::enable(const bool enable)
+{
+   Q_D(QStereoFrameTiming);
+   if (d->enabled != enable)
+   {
+      // Frames that were in flight when timing was toggled are incomplete, so they are discarded.
+      d->discard();
+      d->enabled = enable;
+      if (enable)
+         d->clock.start();
+   }
+}
+
+
+const unsigned int&
+QStereoFrameTiming::capacity() const
+{
+   Q_D(const QStereoFrameTiming);
+   return d->capacity;
+}
+
+
+void
+QStereoFrameTiming::setCapacity(const unsigned int& capacity)
+{
+   Q_D(QStereoFrameTiming);
+   d->capacity = std::max(capacity, 1u);
+   d->history.clear();
+   d->history.reserve(d->capacity);
+   d->historyHead = 0;
+}
+
+
+QVector<QStereoFrameTiming::Frame>
+QStereoFrameTiming::frames() const
+{
+   Q_D(const QStereoFrameTiming);
+
+   // Return the frames from the oldest to the most recent.
+   QVector<Frame> frames;
+   frames.reserve(d->history.size());
+   for (int i = 0; i < d->history.size(); ++i)
+      frames.append(d->history[(d->historyHead + i) % d->history.size()]);
+
+   return frames;
+}
+
+
+const quint64&
+QStereoFrameTiming::frameCount() const
+{
+   Q_D(const QStereoFrameTiming);
+   return d->frameCount;
+}
+
+
+const quint64&
+QStereoFrameTiming::droppedFrameCount() const
+{
+   Q_D(const QStereoFrameTiming);
+   return d->droppedFrameCount;
+}
+
+
+void
+QStereoFrameTiming::reset()
+{
+   Q_D(QStereoFrameTiming);
+   d->discard();
+   d->history.clear();
+   d->historyHead = 0;
+   d->frameCount = 0;
+   d->droppedFrameCount = 0;
+}
+
+
+void
+QStereoFrameTiming::beginFrame(const float& frameInterval)
+{
+   Q_D(QStereoFrameTiming);
+   if (d->enabled)
+      d->beginFrame(frameInterval);
+}
+
+
+void
+QStereoFrameTiming::beginEye(const QEye& eye, const double& predictedLatency)
+{
+   Q_D(QStereoFrameTiming);
+   if (d->enabled)
+      d->beginEye(eye, predictedLatency);
+}
+
+
+void
+QStereoFrameTiming::endEye(const QEye& eye)
+{
+   Q_D(QStereoFrameTiming);
+   if (d->enabled)
+      d->endEye(eye);
+}
+
+
+void
+QStereoFrameTiming::endFrame()
+{
+   Q_D(QStereoFrameTiming);
+   if (d->enabled)
+      d->pendingFrames[d->currentFrame].frame.endFrameTime = d->now();
+}
+
+
+void
+QStereoFrameTiming::frameSwapped()
+{
+   Q_D(QStereoFrameTiming);
+   if (d->enabled)
+      d->pendingFrames[d->currentFrame].frame.swapTime = d->now();
+}
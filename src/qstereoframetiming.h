@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOFRAMETIMING_H
+#define QSTEREOFRAMETIMING_H
+
+#include <QtCore/QMetaType>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+#include "qeye.h"
+#include <array>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoFrameTimingPrivate;
+class QStereoFrameTiming : public QObject
+{
+   Q_OBJECT
+public:
+   struct Frame
+   {
+      quint64 index;
+      double beginFrameTime;
+      std::array<double, 2> beginEyeTime;
+      std::array<double, 2> endEyeTime;
+      double endFrameTime;
+      double swapTime;
+      std::array<double, 2> eyeGpuDuration;
+      std::array<double, 2> predictedLatency;
+      unsigned int droppedFrames;
+      qint64 allocations;
+   };
+
+   explicit QStereoFrameTiming(QObject* const parent = nullptr);
+
+   bool enabled() const;
+   void enable(const bool enable = true);
+
+   const unsigned int& capacity() const;
+   void setCapacity(const unsigned int& capacity);
+
+   QVector<Frame> frames() const;
+   const quint64& frameCount() const;
+   const quint64& droppedFrameCount() const;
+   void reset();
+
+   void beginFrame(const float& frameInterval);
+   void beginEye(const QEye& eye, const double& predictedLatency);
+   void endEye(const QEye& eye);
+   void endFrame();
+   void frameSwapped();
+signals:
+   void frameTimingAvailable(const QStereoFrameTiming::Frame& frame);
+private:
+   QStereoFrameTimingPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoFrameTiming);
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QStereoFrameTiming::Frame)
+
+#endif // QSTEREOFRAMETIMING_H
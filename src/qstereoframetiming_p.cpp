@@ -0,0 +1,246 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoframetiming_p.h"
+#include "qstereoallocationcounter.h"
+#include <QtGui/QOpenGLContext>
+#include <cmath>
+
+
+QStereoFrameTimingPrivate::QStereoFrameTimingPrivate(QStereoFrameTiming* const parent) :
+QObject(parent),
+timing(*parent),
+currentFrame(0),
+nextFrame(0),
+historyHead(0),
+lastBeginFrameTime(-1.0),
+lastBeginFrameAllocations(0),
+timerQueriesSupported(true),
+enabled(false),
+capacity(120),
+frameCount(0),
+droppedFrameCount(0)
+{
+   for (auto& pendingFrame : pendingFrames)
+   {
+      pendingFrame.pending = false;
+      pendingFrame.sampleCount = 0;
+   }
+
+   history.reserve(capacity);
+}
+
+
+double
+QStereoFrameTimingPrivate::now() const
+{
+   return 1e-9 * clock.nsecsElapsed();
+}
+
+
+void
+QStereoFrameTimingPrivate::beginFrame(const float& frameInterval)
+{
+   // A frame's allocations are those made by this thread until the next frame begins, which covers
+   // the whole frame loop. The previous frame is still pending at this point, since it's published below.
+   if (QStereoAllocationCounter::enabled())
+   {
+      const auto& allocations = QStereoAllocationCounter::count();
+      auto& previousFrame = pendingFrames[currentFrame];
+      if (previousFrame.pending && lastBeginFrameTime >= 0.0)
+         previousFrame.frame.allocations = static_cast<qint64>(allocations - lastBeginFrameAllocations);
+
+      lastBeginFrameAllocations = allocations;
+   }
+
+   // Publish the frames whose GPU results have come in since the last frame.
+   collect();
+
+   // If the GPU is so far behind that the oldest frame's results are still not available, that
+   // frame is published without them rather than stalling the pipeline to wait for the GPU.
+   if (pendingFrames[nextFrame].pending)
+      publish(nextFrame, false);
+
+   currentFrame = nextFrame;
+   nextFrame = (nextFrame + 1) % pendingFrameCount();
+
+   auto& pendingFrame = pendingFrames[currentFrame];
+   pendingFrame.pending = true;
+   pendingFrame.sampleCount = 0;
+   pendingFrame.eyeSample = {-1, -1};
+
+   auto& frame = pendingFrame.frame;
+   frame.index = frameCount++;
+   frame.beginFrameTime = now();
+   frame.beginEyeTime = {-1.0, -1.0};
+   frame.endEyeTime = {-1.0, -1.0};
+   frame.endFrameTime = -1.0;
+   frame.swapTime = -1.0;
+   frame.eyeGpuDuration = {-1.0, -1.0};
+   frame.predictedLatency = {-1.0, -1.0};
+   frame.droppedFrames = 0;
+   frame.allocations = -1;
+
+   // Every display refresh that passed without a new frame beginning is counted as a dropped frame.
+   if (lastBeginFrameTime >= 0.0 && frameInterval > 0.0f)
+   {
+      const auto& intervals = std::round((frame.beginFrameTime - lastBeginFrameTime) / frameInterval);
+      frame.droppedFrames = intervals > 1.0 ? static_cast<unsigned int>(intervals) - 1 : 0;
+      droppedFrameCount += frame.droppedFrames;
+   }
+   lastBeginFrameTime = frame.beginFrameTime;
+
+   // GPU timer queries are only issued when there's a context to issue them in. Each frame
+   // records a sample at the beginning and the end of each eye.
+   if (pendingFrame.timerQueries[0] == nullptr && timerQueriesSupported && QOpenGLContext::currentContext() != nullptr)
+   {
+      timerQueriesSupported = createTimerQueries();
+      if (!timerQueriesSupported)
+         qWarning("[QtStereoscopy] Warning: GPU timer queries are not supported. Only CPU times will be recorded.");
+   }
+}
+
+
+void
+QStereoFrameTimingPrivate::beginEye(const QEye& eye, const double& predictedLatency)
+{
+   auto& pendingFrame = pendingFrames[currentFrame];
+   const auto& e = static_cast<int>(eye);
+
+   pendingFrame.frame.beginEyeTime[e] = now();
+   pendingFrame.frame.predictedLatency[e] = predictedLatency;
+   pendingFrame.eyeSample[e] = recordSample();
+}
+
+
+void
+QStereoFrameTimingPrivate::endEye(const QEye& eye)
+{
+   auto& pendingFrame = pendingFrames[currentFrame];
+   const auto& e = static_cast<int>(eye);
+
+   pendingFrame.frame.endEyeTime[e] = now();
+   if (pendingFrame.eyeSample[e] >= 0)
+      recordSample();
+}
+
+
+bool
+QStereoFrameTimingPrivate::createTimerQueries()
+{
+   // The queries are created once and reused every frame. Unlike QOpenGLTimeMonitor, whose results
+   // are returned in a new vector, reading a query's result does not allocate any memory.
+   auto& timerQueries = pendingFrames[currentFrame].timerQueries;
+   for (auto& query : timerQueries)
+   {
+      query.reset(new QOpenGLTimerQuery);
+      if (!query->create())
+      {
+         for (auto& q : timerQueries)
+            q.reset(nullptr);
+
+         return false;
+      }
+   }
+   return true;
+}
+
+
+int
+QStereoFrameTimingPrivate::recordSample()
+{
+   auto& pendingFrame = pendingFrames[currentFrame];
+   if (pendingFrame.timerQueries[0] == nullptr || pendingFrame.sampleCount >= samplesPerFrame())
+      return -1;
+
+   pendingFrame.timerQueries[pendingFrame.sampleCount]->recordTimestamp();
+   return pendingFrame.sampleCount++;
+}
+
+
+void
+QStereoFrameTimingPrivate::collect()
+{
+   // Frames are published in the order they were rendered, starting with the oldest.
+   for (unsigned int i = 0; i < pendingFrameCount(); ++i)
+   {
+      const auto& slot = (nextFrame + i) % pendingFrameCount();
+      const auto& pendingFrame = pendingFrames[slot];
+      if (!pendingFrame.pending)
+         continue;
+
+      // Timestamps are written in the order they were recorded, so the frame's results are available
+      // once its last one is.
+      const auto& sampleCount = pendingFrame.sampleCount;
+      if (sampleCount > 0 && !pendingFrame.timerQueries[sampleCount - 1]->isResultAvailable())
+         break;
+
+      publish(slot, sampleCount > 0);
+   }
+}
+
+
+void
+QStereoFrameTimingPrivate::publish(const unsigned int& slot, const bool gpuResultsAvailable)
+{
+   auto& pendingFrame = pendingFrames[slot];
+   auto& frame = pendingFrame.frame;
+   if (gpuResultsAvailable)
+   {
+      // Each eye's duration is the interval between the samples that bracket it.
+      const auto& queries = pendingFrame.timerQueries;
+      for (unsigned int e = 0; e < 2; ++e)
+      {
+         const auto& sample = pendingFrame.eyeSample[e];
+         if (sample >= 0 && static_cast<unsigned int>(sample) + 1 < pendingFrame.sampleCount)
+         {
+            const auto& begin = queries[sample]->waitForResult();
+            const auto& end = queries[sample + 1]->waitForResult();
+            frame.eyeGpuDuration[e] = 1e-9 * (end - begin);
+         }
+      }
+   }
+   pendingFrame.sampleCount = 0;
+   pendingFrame.pending = false;
+
+   if (static_cast<unsigned int>(history.size()) < capacity)
+      history.append(frame);
+   else
+   {
+      history[historyHead] = frame;
+      historyHead = (historyHead + 1) % capacity;
+   }
+   emit timing.frameTimingAvailable(frame);
+}
+
+
+void
+QStereoFrameTimingPrivate::discard()
+{
+   for (auto& pendingFrame : pendingFrames)
+   {
+      pendingFrame.pending = false;
+      pendingFrame.sampleCount = 0;
+   }
+   lastBeginFrameTime = -1.0;
+}
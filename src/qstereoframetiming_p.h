@@ -0,0 +1,83 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOFRAMETIMING_P_H
+#define QSTEREOFRAMETIMING_P_H
+
+#include "qstereoframetiming.h"
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QOpenGLTimerQuery>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoFrameTimingPrivate : public QObject
+{
+public:
+   explicit QStereoFrameTimingPrivate(QStereoFrameTiming* const parent);
+
+   double now() const;
+   void beginFrame(const float& frameInterval);
+   void beginEye(const QEye& eye, const double& predictedLatency);
+   void endEye(const QEye& eye);
+   bool createTimerQueries();
+   int recordSample();
+   void collect();
+   void publish(const unsigned int& slot, const bool gpuResultsAvailable);
+   void discard();
+
+   static Q_DECL_CONSTEXPR unsigned int pendingFrameCount(){ return 3; }
+   static Q_DECL_CONSTEXPR unsigned int samplesPerFrame(){ return 4; }
+
+   struct PendingFrame
+   {
+      bool pending;
+      QStereoFrameTiming::Frame frame;
+      std::array<QScopedPointer<QOpenGLTimerQuery>, 4> timerQueries;
+      unsigned int sampleCount;
+      std::array<int, 2> eyeSample;
+   };
+
+   QStereoFrameTiming& timing;
+
+   std::array<PendingFrame, 3> pendingFrames;
+   unsigned int currentFrame;
+   unsigned int nextFrame;
+
+   QVector<QStereoFrameTiming::Frame> history;
+   unsigned int historyHead;
+
+   QElapsedTimer clock;
+   double lastBeginFrameTime;
+   quint64 lastBeginFrameAllocations;
+   bool timerQueriesSupported;
+
+   bool enabled;
+   unsigned int capacity;
+   quint64 frameCount;
+   quint64 droppedFrameCount;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOFRAMETIMING_P_H
@@ -0,0 +1,160 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereohistogram.h"
+#include "qstereohistogram_p.h"
+#include <algorithm>
+#include <cmath>
+
+
+QStereoHistogram::QStereoHistogram(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoHistogramPrivate(this))
+{}
+
+
+void
+QStereoHistogram::record(const double& seconds)
+{
+   // Negative values denote measurements that weren't taken.
+   if (seconds < 0.0)
+      return;
+
+   Q_D(QStereoHistogram);
+   const auto& value = static_cast<quint64>(std::llround(seconds * 1e6));
+
+   // Recording is lock-free so that the render loop never waits for a thread reading the histogram.
+   d->buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+   d->sum.fetch_add(value, std::memory_order_relaxed);
+
+   auto minimum = d->minimum.load(std::memory_order_relaxed);
+   while (value < minimum && !d->minimum.compare_exchange_weak(minimum, value, std::memory_order_relaxed))
+   {}
+
+   auto maximum = d->maximum.load(std::memory_order_relaxed);
+   while (value > maximum && !d->maximum.compare_exchange_weak(maximum, value, std::memory_order_relaxed))
+   {}
+}
+
+
+QStereoHistogram::Snapshot
+QStereoHistogram::snapshot() const
+{
+   Q_D(const QStereoHistogram);
+   return const_cast<QStereoHistogramPrivate*>(d)->snapshot(false);
+}
+
+
+QStereoHistogram::Snapshot
+QStereoHistogram::takeSnapshot()
+{
+   Q_D(QStereoHistogram);
+   return d->snapshot(true);
+}
+
+
+void
+QStereoHistogram::reset()
+{
+   Q_D(QStereoHistogram);
+   d->snapshot(true);
+}
+
+
+unsigned int
+QStereoHistogram::bucketIndex(const quint64& microseconds)
+{
+   constexpr auto BITS = QStereoHistogramPrivate::subBucketBits();
+   constexpr auto LINEAR = QStereoHistogramPrivate::linearBucketCount();
+   constexpr auto SUB = QStereoHistogramPrivate::subBucketCount();
+
+   if (microseconds < LINEAR)
+      return static_cast<unsigned int>(microseconds);
+
+   // Find the value's most significant bit, then use the bits that follow it as the sub-bucket.
+   unsigned int msb = 0;
+   for (auto v = microseconds; v > 1; v >>= 1)
+      ++msb;
+
+   const auto& index = LINEAR + (msb - BITS - 1) * SUB + ((microseconds >> (msb - BITS)) & (SUB - 1));
+   return std::min(static_cast<unsigned int>(index), bucketCount() - 1);
+}
+
+
+quint64
+QStereoHistogram::bucketLowerBound(const unsigned int& index)
+{
+   constexpr auto BITS = QStereoHistogramPrivate::subBucketBits();
+   constexpr auto LINEAR = QStereoHistogramPrivate::linearBucketCount();
+   constexpr auto SUB = QStereoHistogramPrivate::subBucketCount();
+
+   if (index < LINEAR)
+      return index;
+
+   const auto& msb = (index - LINEAR) / SUB + BITS + 1;
+   const auto& sub = (index - LINEAR) % SUB;
+   return (static_cast<quint64>(SUB + sub)) << (msb - BITS);
+}
+
+
+quint64
+QStereoHistogram::bucketUpperBound(const unsigned int& index)
+{
+   return index + 1 < bucketCount() ? bucketLowerBound(index + 1) : bucketLowerBound(index) * 2;
+}
+
+
+double
+QStereoHistogram::Snapshot::mean() const
+{
+   return count > 0 ? sum / count : 0.0;
+}
+
+
+double
+QStereoHistogram::Snapshot::percentile(const double& p) const
+{
+   if (count == 0)
+      return 0.0;
+
+   // The extreme ranks are known exactly. Any other rank is approximated by the midpoint of the
+   // bucket holding it, clamped to the range of recorded values.
+   const auto& rank = static_cast<quint64>(std::ceil(std::max(0.0, std::min(p, 100.0)) * 0.01 * count));
+   if (rank <= 1)
+      return minimum;
+   if (rank >= count)
+      return maximum;
+
+   quint64 cumulative = 0;
+   for (int i = 0; i < buckets.size(); ++i)
+   {
+      cumulative += buckets[i];
+      if (cumulative >= rank)
+      {
+         const auto& lower = 1e-6 * bucketLowerBound(i);
+         const auto& upper = 1e-6 * bucketUpperBound(i);
+         return std::max(minimum, std::min(maximum, 0.5 * (lower + upper)));
+      }
+   }
+   return maximum;
+}
@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOHISTOGRAM_H
+#define QSTEREOHISTOGRAM_H
+
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoHistogramPrivate;
+class QStereoHistogram : public QObject
+{
+public:
+   struct Snapshot
+   {
+      QVector<quint64> buckets;
+      quint64 count;
+      double sum;
+      double minimum;
+      double maximum;
+
+      double mean() const;
+      double percentile(const double& p) const;
+   };
+
+   explicit QStereoHistogram(QObject* const parent = nullptr);
+
+   void record(const double& seconds);
+   Snapshot snapshot() const;
+   Snapshot takeSnapshot();
+   void reset();
+
+   static Q_DECL_CONSTEXPR unsigned int bucketCount(){ return 528; }
+   static unsigned int bucketIndex(const quint64& microseconds);
+   static quint64 bucketLowerBound(const unsigned int& index);
+   static quint64 bucketUpperBound(const unsigned int& index);
+private:
+   QStereoHistogramPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoHistogram);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOHISTOGRAM_H
@@ -0,0 +1,62 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereohistogram_p.h"
+#include <limits>
+
+
+QStereoHistogramPrivate::QStereoHistogramPrivate(QStereoHistogram* const parent) :
+QObject(parent),
+sum(0),
+minimum(std::numeric_limits<quint64>::max()),
+maximum(0)
+{
+   for (auto& bucket : buckets)
+      bucket.store(0, std::memory_order_relaxed);
+}
+
+
+QStereoHistogram::Snapshot
+QStereoHistogramPrivate::snapshot(const bool reset)
+{
+   // Each counter is read (and cleared) atomically, but values recorded while the snapshot is
+   // being taken may land on either side of it. This is negligible over a long session.
+   QStereoHistogram::Snapshot snapshot;
+   snapshot.buckets.resize(buckets.size());
+   snapshot.count = 0;
+   for (unsigned int i = 0; i < buckets.size(); ++i)
+   {
+      const auto& count = reset ? buckets[i].exchange(0, std::memory_order_relaxed) : buckets[i].load(std::memory_order_relaxed);
+      snapshot.buckets[i] = count;
+      snapshot.count += count;
+   }
+
+   const auto& s = reset ? sum.exchange(0) : sum.load();
+   const auto& lo = reset ? minimum.exchange(std::numeric_limits<quint64>::max()) : minimum.load();
+   const auto& hi = reset ? maximum.exchange(0) : maximum.load();
+
+   snapshot.sum = 1e-6 * s;
+   snapshot.minimum = snapshot.count > 0 ? 1e-6 * lo : 0.0;
+   snapshot.maximum = snapshot.count > 0 ? 1e-6 * hi : 0.0;
+   return snapshot;
+}
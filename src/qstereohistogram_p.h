@@ -0,0 +1,56 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOHISTOGRAM_P_H
+#define QSTEREOHISTOGRAM_P_H
+
+#include "qstereohistogram.h"
+#include <array>
+#include <atomic>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoHistogramPrivate : public QObject
+{
+public:
+   explicit QStereoHistogramPrivate(QStereoHistogram* const parent);
+
+   QStereoHistogram::Snapshot snapshot(const bool reset);
+
+   // Values are bucketed by their order of magnitude, with each power of two split into a fixed
+   // number of linear sub-buckets. This bounds the relative error regardless of the magnitude,
+   // and lets the histogram cover microseconds to hours in a few kilobytes.
+   static Q_DECL_CONSTEXPR unsigned int subBucketBits(){ return 4; }
+   static Q_DECL_CONSTEXPR unsigned int subBucketCount(){ return 1u << subBucketBits(); }
+   static Q_DECL_CONSTEXPR unsigned int linearBucketCount(){ return 2 * subBucketCount(); }
+
+   std::array<std::atomic<quint64>, QStereoHistogram::bucketCount()> buckets;
+   std::atomic<quint64> sum;
+   std::atomic<quint64> minimum;
+   std::atomic<quint64> maximum;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOHISTOGRAM_P_H
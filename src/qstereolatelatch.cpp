@@ -0,0 +1,250 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereolatelatch.h"
+#include "qstereolatelatch_p.h"
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions_3_2_Core>
+#include <cstring>
+
+
+QStereoLateLatch::QStereoLateLatch(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoLateLatchPrivate(this))
+{}
+
+
+QStereoLateLatch::~QStereoLateLatch()
+{
+   // The buffers can only be released while a context of their share group is current.
+   if (isCreated() && QOpenGLContext::currentContext() != nullptr)
+      destroy();
+}
+
+
+bool
+QStereoLateLatch::create()
+{
+   if (isCreated())
+      return true;
+
+   auto* const context = QOpenGLContext::currentContext();
+   auto* const gl = context != nullptr ? context->versionFunctions<QOpenGLFunctions_3_2_Core>() : nullptr;
+   if (gl == nullptr || !gl->initializeOpenGLFunctions())
+   {
+      qWarning("[QtStereoscopy] Warning: Late latching requires an OpenGL 3.2 context.");
+      return false;
+   }
+
+   Q_D(QStereoLateLatch);
+   d->gl = gl;
+
+   // Each eye's view matrix is stored in its own range, which must respect the uniform buffer offset alignment.
+   GLint alignment = 0;
+   gl->glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+   const GLintptr matrixSize = 16 * sizeof(GLfloat);
+   d->stride = alignment > 0 ? ((matrixSize + alignment - 1) / alignment) * alignment : matrixSize;
+
+   const auto& size = 2 * d->stride;
+   gl->glGenBuffers(1, &d->viewBuffer);
+   gl->glBindBuffer(GL_UNIFORM_BUFFER, d->viewBuffer);
+   gl->glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+
+   // The persistent buffer has a slot per frame in flight, so that the CPU never writes the matrices of a
+   // frame whose copies the GPU has yet to execute.
+   const auto& latchSize = slotCount() * size;
+
+   // With persistent, coherent mappings, view matrices written by the CPU are seen by the GPU when it
+   // executes the copy into the view buffer, rather than when the copy is issued. Without them, view
+   // matrices are simply written into the view buffer in command order.
+   const auto& persistent = context->format().version() >= qMakePair(4, 4) || context->hasExtension("GL_ARB_buffer_storage");
+   const auto glBufferStorage = persistent ? reinterpret_cast<PFNGLBUFFERSTORAGEPROC>(context->getProcAddress("glBufferStorage")) : nullptr;
+   if (glBufferStorage != nullptr)
+   {
+      const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+      gl->glGenBuffers(1, &d->latchBuffer);
+      gl->glBindBuffer(GL_COPY_READ_BUFFER, d->latchBuffer);
+      glBufferStorage(GL_COPY_READ_BUFFER, latchSize, nullptr, flags);
+      d->latchMemory = static_cast<uchar*>(gl->glMapBufferRange(GL_COPY_READ_BUFFER, 0, latchSize, flags));
+      gl->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+      if (d->latchMemory == nullptr)
+      {
+         gl->glDeleteBuffers(1, &d->latchBuffer);
+         d->latchBuffer = 0;
+      }
+   }
+   gl->glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+   // Start from identity matrices so that nothing is read uninitialized.
+   for (unsigned int i = 0; i < slotCount(); ++i)
+   {
+      d->slot = i;
+      for (const auto& eye : {QEye::Left, QEye::Right})
+         latch(eye, QMatrix4x4());
+   }
+
+   return true;
+}
+
+
+void
+QStereoLateLatch::destroy()
+{
+   Q_D(QStereoLateLatch);
+   if (d->gl == nullptr)
+      return;
+
+   for (auto& fence : d->fences)
+   {
+      if (fence != nullptr)
+         d->gl->glDeleteSync(fence);
+      fence = nullptr;
+   }
+   if (d->latchBuffer != 0)
+   {
+      d->gl->glBindBuffer(GL_COPY_READ_BUFFER, d->latchBuffer);
+      d->gl->glUnmapBuffer(GL_COPY_READ_BUFFER);
+      d->gl->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+      d->gl->glDeleteBuffers(1, &d->latchBuffer);
+   }
+   d->gl->glDeleteBuffers(1, &d->viewBuffer);
+
+   d->gl = nullptr;
+   d->viewBuffer = 0;
+   d->latchBuffer = 0;
+   d->latchMemory = nullptr;
+   d->stride = 0;
+   d->slot = 0;
+}
+
+
+bool
+QStereoLateLatch::isCreated() const
+{
+   Q_D(const QStereoLateLatch);
+   return d->gl != nullptr;
+}
+
+
+bool
+QStereoLateLatch::isPersistent() const
+{
+   Q_D(const QStereoLateLatch);
+   return d->latchMemory != nullptr;
+}
+
+
+const GLuint&
+QStereoLateLatch::binding() const
+{
+   Q_D(const QStereoLateLatch);
+   return d->binding;
+}
+
+
+void
+QStereoLateLatch::setBinding(const GLuint& binding)
+{
+   Q_D(QStereoLateLatch);
+   d->binding = binding;
+}
+
+
+void
+QStereoLateLatch::beginFrame()
+{
+   Q_D(QStereoLateLatch);
+   if (d->latchMemory == nullptr)
+      return;
+
+   // Move on to the next frame's slot. Its fence was inserted slotCount() frames ago, so waiting on it
+   // only stalls when the GPU is that far behind.
+   d->slot = (d->slot + 1) % slotCount();
+   auto& fence = d->fences[d->slot];
+   if (fence != nullptr)
+   {
+      d->gl->glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+      d->gl->glDeleteSync(fence);
+      fence = nullptr;
+   }
+}
+
+
+void
+QStereoLateLatch::latch(const QEye& eye, const QMatrix4x4& view)
+{
+   Q_D(QStereoLateLatch);
+   if (d->gl == nullptr)
+      return;
+
+   // QMatrix4x4 and std140 both store matrices in column-major order. Within a frame, a persistent write
+   // races with that frame's copy by design, which then reads either the earlier or the later matrix.
+   // Other frames' copies read other slots.
+   const auto& size = 16 * sizeof(GLfloat);
+   if (d->latchMemory != nullptr)
+      std::memcpy(d->latchMemory + d->latchOffset(eye), view.constData(), size);
+   else
+   {
+      d->gl->glBindBuffer(GL_UNIFORM_BUFFER, d->viewBuffer);
+      d->gl->glBufferSubData(GL_UNIFORM_BUFFER, d->offset(eye), size, view.constData());
+      d->gl->glBindBuffer(GL_UNIFORM_BUFFER, 0);
+   }
+}
+
+
+void
+QStereoLateLatch::bind(const QEye& eye)
+{
+   Q_D(QStereoLateLatch);
+   if (d->gl == nullptr)
+      return;
+
+   const auto& offset = d->offset(eye);
+   const auto& size = 16 * sizeof(GLfloat);
+   if (d->latchBuffer != 0)
+   {
+      d->gl->glBindBuffer(GL_COPY_READ_BUFFER, d->latchBuffer);
+      d->gl->glBindBuffer(GL_COPY_WRITE_BUFFER, d->viewBuffer);
+      d->gl->glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, d->latchOffset(eye), offset, size);
+      d->gl->glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+      d->gl->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+   }
+   d->gl->glBindBufferRange(GL_UNIFORM_BUFFER, d->binding, d->viewBuffer, offset, size);
+}
+
+
+void
+QStereoLateLatch::endFrame()
+{
+   // The fence tells when the GPU has executed the frame's copies, after which its slot can be reused.
+   Q_D(QStereoLateLatch);
+   if (d->latchMemory == nullptr)
+      return;
+
+   auto& fence = d->fences[d->slot];
+   if (fence != nullptr)
+      d->gl->glDeleteSync(fence);
+   fence = d->gl->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,64 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOLATELATCH_H
+#define QSTEREOLATELATCH_H
+
+#include "qeye.h"
+#include <QtCore/QObject>
+#include <QtGui/QMatrix4x4>
+#include <QtGui/qopengl.h>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoLateLatchPrivate;
+class QStereoLateLatch : public QObject
+{
+public:
+   explicit QStereoLateLatch(QObject* const parent = nullptr);
+   ~QStereoLateLatch();
+
+   bool create();
+   void destroy();
+   bool isCreated() const;
+   bool isPersistent() const;
+
+   const GLuint& binding() const;
+   void setBinding(const GLuint& binding);
+
+   void beginFrame();
+   void latch(const QEye& eye, const QMatrix4x4& view);
+   void bind(const QEye& eye);
+   void endFrame();
+
+   static Q_DECL_CONSTEXPR const char* blockName(){ return "QStereoLateLatch"; }
+   static Q_DECL_CONSTEXPR unsigned int slotCount(){ return 3; }
+private:
+   QStereoLateLatchPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoLateLatch);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOLATELATCH_H
@@ -0,0 +1,53 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereolatelatch_p.h"
+
+
+QStereoLateLatchPrivate::QStereoLateLatchPrivate(QStereoLateLatch* const parent) :
+QObject(parent),
+gl(nullptr),
+viewBuffer(0),
+latchBuffer(0),
+latchMemory(nullptr),
+stride(0),
+binding(0),
+slot(0)
+{
+   fences.fill(nullptr);
+}
+
+
+GLintptr
+QStereoLateLatchPrivate::offset(const QEye& eye) const
+{
+   return static_cast<int>(eye) * stride;
+}
+
+
+GLintptr
+QStereoLateLatchPrivate::latchOffset(const QEye& eye) const
+{
+   // The persistent buffer holds a slot of both eyes' matrices for each frame in flight.
+   return 2 * slot * stride + offset(eye);
+}
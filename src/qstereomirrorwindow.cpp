@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereomirrorwindow.h"
+#include "qstereomirrorwindow_p.h"
+#include <algorithm>
+
+
+QStereoMirrorWindow::QStereoMirrorWindow(const QAbstractStereoRenderer& renderer, QOpenGLContext& shareContext, QWindow* const parent) :
+QWindow(parent),
+d_ptr(new QStereoMirrorWindowPrivate(this, renderer, shareContext))
+{
+   setSurfaceType(QWindow::OpenGLSurface);
+   if (Q_UNLIKELY(!supportsOpenGL()))
+      qFatal("[QtStereoscopy] Error: This system is not OpenGL compatible.");
+}
+
+
+QStereoMirrorWindow::~QStereoMirrorWindow()
+{
+   // Stop mirroring before the surface is destroyed.
+   Q_D(QStereoMirrorWindow);
+   d->timer.stop();
+}
+
+
+const QStereoMirrorWindow::Source&
+QStereoMirrorWindow::source() const
+{
+   Q_D(const QStereoMirrorWindow);
+   return d->source;
+}
+
+
+void
+QStereoMirrorWindow::setSource(const Source& source)
+{
+   Q_D(QStereoMirrorWindow);
+   d->source = source;
+}
+
+
+const unsigned int&
+QStereoMirrorWindow::downscaleFactor() const
+{
+   Q_D(const QStereoMirrorWindow);
+   return d->downscaleFactor;
+}
+
+
+void
+QStereoMirrorWindow::setDownscaleFactor(const unsigned int& factor)
+{
+   Q_D(QStereoMirrorWindow);
+   d->downscaleFactor = std::max(factor, 1u);
+}
+
+
+const unsigned int&
+QStereoMirrorWindow::refreshRate() const
+{
+   Q_D(const QStereoMirrorWindow);
+   return d->refreshRate;
+}
+
+
+void
+QStereoMirrorWindow::setRefreshRate(const unsigned int& rate)
+{
+   Q_D(QStereoMirrorWindow);
+   d->refreshRate = std::max(rate, 1u);
+   d->timer.setInterval(1000 / d->refreshRate);
+}
+
+
+QRectF
+QStereoMirrorWindow::sourceRegion(const QEye& eye, const bool separateEyeTargets)
+{
+   // A shared eye buffer holds the left and right eyes side by side. The region is given in texture coordinates.
+   if (separateEyeTargets)
+      return QRectF(0.0, 0.0, 1.0, 1.0);
+
+   return eye == QEye::Left ? QRectF(0.0, 0.0, 0.5, 1.0) : QRectF(0.5, 0.0, 0.5, 1.0);
+}
+
+
+QSize
+QStereoMirrorWindow::fittedSize(const Source& source, const QSize& leftEyeSize, const QSize& rightEyeSize, const unsigned int& downscaleFactor)
+{
+   auto size = leftEyeSize;
+   if (source == Source::RightEye)
+      size = rightEyeSize;
+   else if (source == Source::BothEyes)
+      size = QSize(leftEyeSize.width() + rightEyeSize.width(), std::max(leftEyeSize.height(), rightEyeSize.height()));
+
+   const auto& factor = static_cast<int>(std::max(downscaleFactor, 1u));
+   return QSize(size.width() / factor, size.height() / factor);
+}
@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOMIRRORWINDOW_H
+#define QSTEREOMIRRORWINDOW_H
+
+#include <QtCore/QRectF>
+#include <QtCore/QSize>
+#include <QtGui/QWindow>
+#include "qeye.h"
+
+
+QT_BEGIN_NAMESPACE
+
+class QAbstractStereoRenderer;
+class QOpenGLContext;
+class QStereoMirrorWindowPrivate;
+class QStereoMirrorWindow : public QWindow
+{
+public:
+   enum class Source
+   {
+      BothEyes,
+      LeftEye,
+      RightEye
+   };
+
+   QStereoMirrorWindow(const QAbstractStereoRenderer& renderer, QOpenGLContext& shareContext, QWindow* const parent = nullptr);
+   ~QStereoMirrorWindow();
+
+   const Source& source() const;
+   void setSource(const Source& source);
+
+   const unsigned int& downscaleFactor() const;
+   void setDownscaleFactor(const unsigned int& factor);
+
+   const unsigned int& refreshRate() const;
+   void setRefreshRate(const unsigned int& rate);
+
+   static QRectF sourceRegion(const QEye& eye, const bool separateEyeTargets);
+   static QSize fittedSize(const Source& source, const QSize& leftEyeSize, const QSize& rightEyeSize, const unsigned int& downscaleFactor);
+private:
+   explicit QStereoMirrorWindow(const QStereoMirrorWindow&) = delete;
+   QStereoMirrorWindow& operator=(const QStereoMirrorWindow&) = delete;
+
+   QStereoMirrorWindowPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoMirrorWindow);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOMIRRORWINDOW_H
@@ -0,0 +1,150 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereomirrorwindow_p.h"
+#include "qabstractstereorenderer.h"
+#include <QtGui/QOpenGLFramebufferObject>
+#include <algorithm>
+#include <array>
+
+
+QStereoMirrorWindowPrivate::QStereoMirrorWindowPrivate
+(
+   QStereoMirrorWindow* const parent,
+   const QAbstractStereoRenderer& r,
+   QOpenGLContext& share
+) :
+QObject(parent),
+window(*parent),
+renderer(r),
+shareContext(share),
+source(QStereoMirrorWindow::Source::BothEyes),
+downscaleFactor(2),
+refreshRate(30)
+{
+   // The mirror is paced by its own timer instead of the display's frame loop, so that it
+   // never holds up the head-mounted display and can run at a fraction of its refresh rate.
+   timer.setTimerType(Qt::PreciseTimer);
+   timer.setInterval(1000 / refreshRate);
+   QObject::connect(&timer, &QTimer::timeout, [this]{ paintGL(); });
+   timer.start();
+}
+
+
+bool
+QStereoMirrorWindowPrivate::makeCurrent()
+{
+   // The mirror's context shares its resources with the renderer's context, which must therefore
+   // be created first. Until then, there is nothing to mirror.
+   if (!context.isValid())
+   {
+      if (!shareContext.isValid())
+         return false;
+
+      // Never wait for the vertical retrace here since the timer already paces the mirror.
+      auto format = window.requestedFormat();
+      format.setSwapInterval(0);
+
+      context.setFormat(format);
+      context.setShareContext(&shareContext);
+      if (!context.create() || !context.makeCurrent(&window))
+         qFatal("[QtStereoscopy] Error: Could not create a shared OpenGL context for the mirror window.");
+
+      glDisable(GL_DEPTH_TEST);
+      glDisable(GL_LIGHTING);
+      glEnable(GL_TEXTURE_2D);
+      return true;
+   }
+   return context.makeCurrent(&window);
+}
+
+
+void
+QStereoMirrorWindowPrivate::paintGL()
+{
+   const std::array<const QOpenGLFramebufferObject*, 2> fbo =
+   {{
+      renderer.framebufferObject(QEye::Left),
+      renderer.framebufferObject(QEye::Right)
+   }};
+   if (!window.isExposed() || fbo[0] == nullptr || fbo[1] == nullptr || !makeCurrent())
+      return;
+
+   // With separate eye targets, each eye has a framebuffer object of its own instead of half of a shared one.
+   const bool separateEyeTargets = fbo[0] != fbo[1];
+   std::array<QRectF, 2> region;
+   std::array<QSize, 2> eyeSize;
+   for (const auto& eye : {QEye::Left, QEye::Right})
+   {
+      const auto& i = static_cast<int>(eye);
+      const auto& fboSize = fbo[i]->size();
+      region[i] = QStereoMirrorWindow::sourceRegion(eye, separateEyeTargets);
+      eyeSize[i] = QSize
+      (
+         static_cast<int>(region[i].width() * fboSize.width()),
+         static_cast<int>(region[i].height() * fboSize.height())
+      );
+   }
+
+   // Fit the window to the (downscaled) source whenever the latter's size changes, but leave it
+   // alone otherwise so that it may be resized freely.
+   const auto& size = QStereoMirrorWindow::fittedSize(source, eyeSize[0], eyeSize[1], downscaleFactor);
+   if (size != this->size)
+   {
+      this->size = size;
+      window.resize(size);
+   }
+
+   // Only sample the eye buffers once the GPU has completed the renderer's last frame.
+   renderer.waitForFrame();
+
+   // When both eyes are mirrored, each one gets a share of the window that is proportional to its width.
+   const bool bothEyes = source == QStereoMirrorWindow::Source::BothEyes;
+   const auto& split = bothEyes ? 2.0f * eyeSize[0].width() / std::max(eyeSize[0].width() + eyeSize[1].width(), 1) - 1.0f : 0.0f;
+
+   // The eye buffers' textures are shared with this context, so mirroring them is a textured quad per
+   // eye instead of a second pass over the scene.
+   const auto& ratio = window.devicePixelRatio();
+   glViewport(0, 0, static_cast<GLsizei>(window.width() * ratio), static_cast<GLsizei>(window.height() * ratio));
+   for (const auto& eye : {QEye::Left, QEye::Right})
+   {
+      if (!bothEyes && source != (eye == QEye::Left ? QStereoMirrorWindow::Source::LeftEye : QStereoMirrorWindow::Source::RightEye))
+         continue;
+
+      const auto& i = static_cast<int>(eye);
+      const auto& r = region[i];
+      const auto& left = bothEyes && eye == QEye::Right ? split : -1.0f;
+      const auto& right = bothEyes && eye == QEye::Left ? split : 1.0f;
+
+      glBindTexture(GL_TEXTURE_2D, fbo[i]->texture());
+      glBegin(GL_QUADS);
+      glTexCoord2f(r.left(),  r.top());    glVertex2f(left, -1.0f);
+      glTexCoord2f(r.right(), r.top());    glVertex2f(right,-1.0f);
+      glTexCoord2f(r.right(), r.bottom()); glVertex2f(right, 1.0f);
+      glTexCoord2f(r.left(),  r.bottom()); glVertex2f(left,  1.0f);
+      glEnd();
+   }
+   glBindTexture(GL_TEXTURE_2D, 0);
+
+   context.swapBuffers(&window);
+}
@@ -0,0 +1,56 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOMIRRORWINDOW_P_H
+#define QSTEREOMIRRORWINDOW_P_H
+
+#include "qstereomirrorwindow.h"
+#include <QtCore/QTimer>
+#include <QtGui/QOpenGLContext>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoMirrorWindowPrivate : public QObject
+{
+public:
+   QStereoMirrorWindowPrivate(QStereoMirrorWindow* const parent, const QAbstractStereoRenderer& renderer, QOpenGLContext& shareContext);
+
+   bool makeCurrent();
+   void paintGL();
+
+   QStereoMirrorWindow& window;
+   const QAbstractStereoRenderer& renderer;
+   QOpenGLContext& shareContext;
+   QOpenGLContext context;
+   QTimer timer;
+
+   QStereoMirrorWindow::Source source;
+   unsigned int downscaleFactor;
+   unsigned int refreshRate;
+   QSize size;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOMIRRORWINDOW_P_H
@@ -0,0 +1,232 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOOFFSCREENSURFACE_H
+#define QSTEREOOFFSCREENSURFACE_H
+
+#include <QtGui/QImage>
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFramebufferObject>
+#include <QtGui/QPainter>
+#include "qabstractstereorenderer.h"
+#include "qstereoframecapture.h"
+#include "qstereoframesequence.h"
+#include "qstereoresourceloader.h"
+#include "qstereotrace.h"
+#include <algorithm>
+
+
+QT_BEGIN_NAMESPACE
+
+template<class Renderer, class Policy>
+class QStereoOffscreenSurface Q_DECL_FINAL : public QOffscreenSurface
+{
+   static_assert(std::is_base_of<QAbstractStereoRenderer, Renderer>::value, "Renderer must derive from QAbstractStereoRenderer.");
+   static_assert(std::is_default_constructible<Renderer>::value, "Renderer requires a default constructor.");
+public:
+   explicit QStereoOffscreenSurface(const QSurfaceFormat& format = QSurfaceFormat());
+   explicit QStereoOffscreenSurface(Renderer& renderer, const QSurfaceFormat& format = QSurfaceFormat());
+   ~QStereoOffscreenSurface();
+
+   QOpenGLContext& context();
+   Renderer& renderer();
+   QStereoResourceLoader& resourceLoader();
+
+   QStereoFrameCapture* frameCapture() const;
+   void setFrameCapture(QStereoFrameCapture* const capture);
+
+   void renderFrame();
+   void renderFrames(const unsigned int& count);
+   QImage grabFramebuffer();
+private:
+   QStereoOffscreenSurface(Renderer* const renderer, const QSurfaceFormat& format);
+
+   explicit QStereoOffscreenSurface(const QStereoOffscreenSurface&) = delete;
+   QStereoOffscreenSurface& operator=(const QStereoOffscreenSurface&) = delete;
+
+   bool makeCurrent();
+   void paintGL();
+
+   QOpenGLContext context_;
+   QStereoResourceLoader resourceLoader_;
+   Renderer* const renderer_;
+   QStereoFrameCapture* capture_;
+};
+
+
+template<class T, class P>
+QStereoOffscreenSurface<T, P>::QStereoOffscreenSurface(const QSurfaceFormat& format) :
+QStereoOffscreenSurface(new T, format)
+{
+   // Change the renderer's ownership to manage dynamic memory automatically.
+   renderer_->setParent(this);
+}
+
+
+template<class T, class P>
+QStereoOffscreenSurface<T, P>::QStereoOffscreenSurface(T& renderer, const QSurfaceFormat& format) :
+QStereoOffscreenSurface(&renderer, format)
+{}
+
+
+template<class T, class P>
+QStereoOffscreenSurface<T, P>::QStereoOffscreenSurface(T* const renderer, const QSurfaceFormat& format) :
+resourceLoader_(context_),
+renderer_(renderer),
+capture_(nullptr)
+{
+   if (renderer_ == nullptr)
+      qFatal("[QtStereoscopy] Error: QStereoOffscreenSurface renderer is null.");
+
+   setFormat(format);
+   create();
+   if (Q_UNLIKELY(!isValid()))
+      qFatal("[QtStereoscopy] Error: Could not create an offscreen surface.");
+}
+
+
+template<class T, class P>
+QStereoOffscreenSurface<T, P>::~QStereoOffscreenSurface()
+{
+   // An owned renderer holds OpenGL resources, so release it while the context is still alive.
+   if (renderer_->parent() == this && context_.isValid() && context_.makeCurrent(this))
+      delete renderer_;
+}
+
+
+template<class T, class P> QOpenGLContext&
+QStereoOffscreenSurface<T, P>::context()
+{
+   return context_;
+}
+
+
+template<class T, class P> T&
+QStereoOffscreenSurface<T, P>::renderer()
+{
+   return *renderer_;
+}
+
+
+template<class T, class P> QStereoResourceLoader&
+QStereoOffscreenSurface<T, P>::resourceLoader()
+{
+   return resourceLoader_;
+}
+
+
+template<class T, class P> QStereoFrameCapture*
+QStereoOffscreenSurface<T, P>::frameCapture() const
+{
+   return capture_;
+}
+
+
+template<class T, class P> void
+QStereoOffscreenSurface<T, P>::setFrameCapture(QStereoFrameCapture* const capture)
+{
+   capture_ = capture;
+}
+
+
+template<class T, class P> void
+QStereoOffscreenSurface<T, P>::renderFrame()
+{
+   renderFrames(1);
+}
+
+
+template<class T, class P> void
+QStereoOffscreenSurface<T, P>::renderFrames(const unsigned int& count)
+{
+   // There is no display to synchronize with, so frames are drawn back-to-back. The pipeline
+   // is drained at the end so that the time spent in this call accounts for the GPU's work.
+   if (makeCurrent())
+   {
+      for (unsigned int i = 0; i < count; ++i)
+         paintGL();
+
+      context_.functions()->glFinish();
+   }
+}
+
+
+template<class T, class P> QImage
+QStereoOffscreenSurface<T, P>::grabFramebuffer()
+{
+   if (makeCurrent())
+   {
+      // Eyes that have separate targets are grabbed side by side, bottom-aligned like captured frames.
+      const auto* const left = renderer_->framebufferObject(QEye::Left);
+      const auto* const right = renderer_->framebufferObject(QEye::Right);
+      if (left != nullptr && right != nullptr && left != right)
+      {
+         const auto& leftImage = left->toImage();
+         const auto& rightImage = right->toImage();
+         QImage image(leftImage.width() + rightImage.width(), std::max(leftImage.height(), rightImage.height()), leftImage.format());
+         image.fill(Qt::black);
+
+         QPainter painter(&image);
+         painter.drawImage(QPoint(0, image.height() - leftImage.height()), leftImage);
+         painter.drawImage(QPoint(leftImage.width(), image.height() - rightImage.height()), rightImage);
+         return image;
+      }
+      if (left != nullptr)
+         return left->toImage();
+   }
+   qWarning("[QtStereoscopy] Warning: The renderer does not provide a framebuffer to grab.");
+   return QImage();
+}
+
+
+template<class T, class P> bool
+QStereoOffscreenSurface<T, P>::makeCurrent()
+{
+   // The context and renderer are initialized when the first frame is requested.
+   if (!context_.isValid())
+   {
+      context_.setFormat(requestedFormat());
+      if (context_.create() && context_.makeCurrent(this))
+         renderer_->initialize(*this);
+      else
+         qFatal("[QtStereoscopy] Error: Could not create an OpenGL context.");
+
+      return true;
+   }
+   return context_.makeCurrent(this);
+}
+
+
+template<class T, class P> void
+QStereoOffscreenSurface<T, P>::paintGL()
+{
+   QSTEREO_TRACE_ZONE("QStereoOffscreenSurface::paintGL");
+
+   // Frames go through the same sequence as a window's, except that there is nothing to present.
+   QStereoFrameSequence<T, P>::renderFrame(*renderer_, {&resourceLoader_}, capture_, []{});
+}
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOOFFSCREENSURFACE_H
@@ -0,0 +1,165 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoposepredictor.h"
+#include "qstereoposepredictor_p.h"
+#include <algorithm>
+
+
+QStereoPosePredictor::QStereoPosePredictor(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoPosePredictorPrivate(this))
+{}
+
+
+const unsigned int&
+QStereoPosePredictor::capacity() const
+{
+   Q_D(const QStereoPosePredictor);
+   return d->capacity;
+}
+
+
+void
+QStereoPosePredictor::setCapacity(const unsigned int& capacity)
+{
+   Q_D(QStereoPosePredictor);
+   QMutexLocker locker(&d->mutex);
+
+   // At least two samples are needed to interpolate, or to estimate velocities.
+   d->capacity = std::max(capacity, 2u);
+   const auto& excess = d->samples.size() - static_cast<int>(d->capacity);
+   if (excess > 0)
+      d->samples.remove(0, excess);
+
+   d->samples.reserve(d->capacity);
+}
+
+
+const double&
+QStereoPosePredictor::maximumPredictionInterval() const
+{
+   Q_D(const QStereoPosePredictor);
+   return d->maximumPredictionInterval;
+}
+
+
+void
+QStereoPosePredictor::setMaximumPredictionInterval(const double& seconds)
+{
+   Q_D(QStereoPosePredictor);
+   QMutexLocker locker(&d->mutex);
+   d->maximumPredictionInterval = std::max(seconds, 0.0);
+}
+
+
+void
+QStereoPosePredictor::addSample(const Pose& sample)
+{
+   Q_D(QStereoPosePredictor);
+   QMutexLocker locker(&d->mutex);
+
+   auto& samples = d->samples;
+   if (!samples.isEmpty())
+   {
+      // Samples are kept in chronological order. A sample that's older than the latest one is
+      // discarded, and one with the same timestamp replaces it.
+      const auto& latest = samples.last().time;
+      if (sample.time < latest)
+         return;
+      if (sample.time <= latest)
+         samples.remove(samples.size() - 1);
+   }
+
+   if (samples.size() >= static_cast<int>(d->capacity))
+      samples.remove(0);
+
+   samples.append(sample);
+}
+
+
+void
+QStereoPosePredictor::addSample(const double& time, const QQuaternion& orientation, const QVector3D& position)
+{
+   Pose sample = {time, orientation, position, QVector3D(0, 0, 0), QVector3D(0, 0, 0)};
+   {
+      // Without measured velocities, they are estimated from the previous sample.
+      Q_D(QStereoPosePredictor);
+      QMutexLocker locker(&d->mutex);
+      if (!d->samples.isEmpty())
+      {
+         const auto& previous = d->samples.last();
+         const auto& dt = time - previous.time;
+         if (dt > 0.0)
+         {
+            sample.angularVelocity = QStereoPosePredictorPrivate::angularVelocity(previous.orientation, orientation, dt);
+            sample.linearVelocity = (position - previous.position) / static_cast<float>(dt);
+         }
+      }
+   }
+   addSample(sample);
+}
+
+
+unsigned int
+QStereoPosePredictor::sampleCount() const
+{
+   Q_D(const QStereoPosePredictor);
+   QMutexLocker locker(&d->mutex);
+   return d->samples.size();
+}
+
+
+void
+QStereoPosePredictor::clear()
+{
+   Q_D(QStereoPosePredictor);
+   QMutexLocker locker(&d->mutex);
+   d->samples.clear();
+}
+
+
+QStereoPosePredictor::Pose
+QStereoPosePredictor::predict(const double& time) const
+{
+   Q_D(const QStereoPosePredictor);
+   QMutexLocker locker(&d->mutex);
+
+   const auto& samples = d->samples;
+   if (samples.isEmpty())
+      return Pose{time, QQuaternion(1.0, 0.0, 0.0, 0.0), QVector3D(0, 0, 0), QVector3D(0, 0, 0), QVector3D(0, 0, 0)};
+
+   // Future poses are extrapolated from the latest sample, while past ones are interpolated from the history.
+   if (time >= samples.last().time)
+      return QStereoPosePredictorPrivate::extrapolate(samples.last(), time, d->maximumPredictionInterval);
+
+   if (time <= samples.first().time)
+   {
+      auto pose = samples.first();
+      pose.time = time;
+      return pose;
+   }
+
+   const auto& next = std::lower_bound(samples.begin(), samples.end(), time, [](const Pose& sample, const double& t){ return sample.time < t; });
+   return QStereoPosePredictorPrivate::interpolate(*(next - 1), *next, time);
+}
@@ -0,0 +1,68 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOPOSEPREDICTOR_H
+#define QSTEREOPOSEPREDICTOR_H
+
+#include <QtCore/QObject>
+#include <QtGui/QQuaternion>
+#include <QtGui/QVector3D>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoPosePredictorPrivate;
+class QStereoPosePredictor : public QObject
+{
+public:
+   struct Pose
+   {
+      double time;
+      QQuaternion orientation;
+      QVector3D position;
+      QVector3D angularVelocity;
+      QVector3D linearVelocity;
+   };
+
+   explicit QStereoPosePredictor(QObject* const parent = nullptr);
+
+   const unsigned int& capacity() const;
+   void setCapacity(const unsigned int& capacity);
+
+   const double& maximumPredictionInterval() const;
+   void setMaximumPredictionInterval(const double& seconds);
+
+   void addSample(const Pose& sample);
+   void addSample(const double& time, const QQuaternion& orientation, const QVector3D& position);
+   unsigned int sampleCount() const;
+   void clear();
+
+   Pose predict(const double& time) const;
+private:
+   QStereoPosePredictorPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoPosePredictor);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOPOSEPREDICTOR_H
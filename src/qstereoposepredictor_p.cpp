@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoposepredictor_p.h"
+#include <QtCore/QtMath>
+#include <algorithm>
+#include <cmath>
+
+
+QStereoPosePredictorPrivate::QStereoPosePredictorPrivate(QStereoPosePredictor* const parent) :
+QObject(parent),
+capacity(64),
+maximumPredictionInterval(0.1)
+{
+   // Samples are added every frame, so the history is allocated once rather than as it grows.
+   samples.reserve(capacity);
+}
+
+
+QVector3D
+QStereoPosePredictorPrivate::angularVelocity(const QQuaternion& from, const QQuaternion& to, const double& dt)
+{
+   // The rotation from one orientation to the other, taken along the shortest arc.
+   auto delta = (to * from.conjugate()).normalized();
+   if (delta.scalar() < 0.0f)
+      delta = -delta;
+
+   const auto& axis = delta.vector();
+   const auto& sine = axis.length();
+   if (dt <= 0.0 || qFuzzyIsNull(sine))
+      return QVector3D(0, 0, 0);
+
+   const auto& angle = 2.0f * std::atan2(sine, delta.scalar());
+   return axis * static_cast<float>(angle / (sine * dt));
+}
+
+
+QQuaternion
+QStereoPosePredictorPrivate::integrate(const QQuaternion& orientation, const QVector3D& angularVelocity, const double& dt)
+{
+   const auto& speed = angularVelocity.length();
+   if (qFuzzyIsNull(speed) || dt <= 0.0)
+      return orientation;
+
+   // Angular velocities are given in the world's frame of reference, so the rotation is applied on the left.
+   const auto& angle = qRadiansToDegrees(speed * static_cast<float>(dt));
+   return (QQuaternion::fromAxisAndAngle(angularVelocity / speed, angle) * orientation).normalized();
+}
+
+
+QStereoPosePredictor::Pose
+QStereoPosePredictorPrivate::interpolate(const QStereoPosePredictor::Pose& a, const QStereoPosePredictor::Pose& b, const double& time)
+{
+   const auto& span = b.time - a.time;
+   const auto& t = static_cast<float>(span > 0.0 ? (time - a.time) / span : 0.0);
+
+   return QStereoPosePredictor::Pose
+   {
+      time,
+      QQuaternion::slerp(a.orientation, b.orientation, t),
+      a.position + (b.position - a.position) * t,
+      a.angularVelocity + (b.angularVelocity - a.angularVelocity) * t,
+      a.linearVelocity + (b.linearVelocity - a.linearVelocity) * t
+   };
+}
+
+
+QStereoPosePredictor::Pose
+QStereoPosePredictorPrivate::extrapolate(const QStereoPosePredictor::Pose& sample, const double& time, const double& maximumInterval)
+{
+   // Velocities are assumed to be constant over the prediction interval, which is clamped since errors
+   // grow quickly the further ahead a pose is predicted.
+   const auto& dt = std::min(time - sample.time, maximumInterval);
+
+   auto pose = sample;
+   pose.time = time;
+   pose.orientation = integrate(sample.orientation, sample.angularVelocity, dt);
+   pose.position = sample.position + sample.linearVelocity * static_cast<float>(dt);
+   return pose;
+}
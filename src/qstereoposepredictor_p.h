@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOPOSEPREDICTOR_P_H
+#define QSTEREOPOSEPREDICTOR_P_H
+
+#include "qstereoposepredictor.h"
+#include <QtCore/QMutex>
+#include <QtCore/QVector>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoPosePredictorPrivate : public QObject
+{
+public:
+   explicit QStereoPosePredictorPrivate(QStereoPosePredictor* const parent);
+
+   static QVector3D angularVelocity(const QQuaternion& from, const QQuaternion& to, const double& dt);
+   static QQuaternion integrate(const QQuaternion& orientation, const QVector3D& angularVelocity, const double& dt);
+   static QStereoPosePredictor::Pose interpolate(const QStereoPosePredictor::Pose& a, const QStereoPosePredictor::Pose& b, const double& time);
+   static QStereoPosePredictor::Pose extrapolate(const QStereoPosePredictor::Pose& sample, const double& time, const double& maximumInterval);
+
+   mutable QMutex mutex;
+   QVector<QStereoPosePredictor::Pose> samples;
+   unsigned int capacity;
+   double maximumPredictionInterval;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOPOSEPREDICTOR_P_H
@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoprojectionsettings.h"
+#include "qstereoprojectionsettings_p.h"
+
+
+QStereoProjectionSettings::QStereoProjectionSettings(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoProjectionSettingsPrivate(this))
+{}
+
+
+float
+QStereoProjectionSettings::nearClippingDistance() const
+{
+   return snapshot().nearClippingDistance;
+}
+
+
+void
+QStereoProjectionSettings::setNearClippingDistance(const float& distance)
+{
+   Q_D(QStereoProjectionSettings);
+   d->set(&Snapshot::nearClippingDistance, distance);
+}
+
+
+float
+QStereoProjectionSettings::farClippingDistance() const
+{
+   return snapshot().farClippingDistance;
+}
+
+
+void
+QStereoProjectionSettings::setFarClippingDistance(const float& distance)
+{
+   Q_D(QStereoProjectionSettings);
+   d->set(&Snapshot::farClippingDistance, distance);
+}
+
+
+float
+QStereoProjectionSettings::orthoDistance() const
+{
+   return snapshot().orthoDistance;
+}
+
+
+void
+QStereoProjectionSettings::setOrthoDistance(const float& distance)
+{
+   Q_D(QStereoProjectionSettings);
+   d->set(&Snapshot::orthoDistance, distance);
+}
+
+
+QStereoProjectionSettings::Snapshot
+QStereoProjectionSettings::snapshot() const
+{
+   Q_D(const QStereoProjectionSettings);
+   QMutexLocker locker(&d->mutex);
+   return d->snapshot;
+}
+
+
+bool
+QStereoProjectionSettings::takeChanges(Snapshot& snapshot)
+{
+   // The settings may be written from any thread, whereas the renderer only picks them up once per frame,
+   // so that both eyes of a frame are always projected with the same settings.
+   Q_D(QStereoProjectionSettings);
+   QMutexLocker locker(&d->mutex);
+   if (!d->changed)
+      return false;
+
+   snapshot = d->snapshot;
+   d->changed = false;
+   return true;
+}
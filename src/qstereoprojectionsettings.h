@@ -0,0 +1,63 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOPROJECTIONSETTINGS_H
+#define QSTEREOPROJECTIONSETTINGS_H
+
+#include <QtCore/QObject>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoProjectionSettingsPrivate;
+class QStereoProjectionSettings : public QObject
+{
+public:
+   struct Snapshot
+   {
+      float nearClippingDistance;
+      float farClippingDistance;
+      float orthoDistance;
+   };
+
+   explicit QStereoProjectionSettings(QObject* const parent = nullptr);
+
+   float nearClippingDistance() const;
+   void setNearClippingDistance(const float& distance);
+
+   float farClippingDistance() const;
+   void setFarClippingDistance(const float& distance);
+
+   float orthoDistance() const;
+   void setOrthoDistance(const float& distance);
+
+   Snapshot snapshot() const;
+   bool takeChanges(Snapshot& snapshot);
+private:
+   QStereoProjectionSettingsPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoProjectionSettings);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOPROJECTIONSETTINGS_H
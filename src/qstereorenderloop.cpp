@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereorenderloop.h"
+#include "qstereorenderloop_p.h"
+#include <QtGui/QOpenGLContext>
+
+
+QStereoRenderLoop::QStereoRenderLoop(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoRenderLoopPrivate(this))
+{}
+
+
+QStereoRenderLoop::~QStereoRenderLoop()
+{
+   stop();
+}
+
+
+bool
+QStereoRenderLoop::isRunning() const
+{
+   Q_D(const QStereoRenderLoop);
+   return d->renderThread.isRunning();
+}
+
+
+bool
+QStereoRenderLoop::start(QOpenGLContext& context, QSurface& surface, const Frame& frame)
+{
+   Q_D(QStereoRenderLoop);
+   if (Q_UNLIKELY(isRunning()))
+   {
+      qWarning("[QtStereoscopy] Warning: The render loop is already running.");
+      return false;
+   }
+   if (Q_UNLIKELY(!frame))
+   {
+      qWarning("[QtStereoscopy] Warning: A render loop requires a frame function.");
+      return false;
+   }
+
+   // A context can only be made current on the thread it lives in, so it's handed over to the
+   // render thread, which returns it once the loop is stopped.
+   if (QOpenGLContext::currentContext() == &context)
+      context.doneCurrent();
+
+   d->context = &context;
+   d->surface = &surface;
+   d->frame = frame;
+   d->stopping = false;
+   context.moveToThread(&d->renderThread);
+   d->renderThread.start(QThread::HighPriority);
+
+   return true;
+}
+
+
+void
+QStereoRenderLoop::stop()
+{
+   Q_D(QStereoRenderLoop);
+   d->stopping = true;
+   d->renderThread.wait();
+}
+
+
+quint64
+QStereoRenderLoop::frameCount() const
+{
+   Q_D(const QStereoRenderLoop);
+   return d->frameCount.load();
+}
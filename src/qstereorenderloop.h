@@ -0,0 +1,59 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREORENDERLOOP_H
+#define QSTEREORENDERLOOP_H
+
+#include <QtCore/QObject>
+#include <functional>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLContext;
+class QSurface;
+class QStereoRenderLoopPrivate;
+class QStereoRenderLoop : public QObject
+{
+public:
+   using Frame = std::function<void()>;
+
+   explicit QStereoRenderLoop(QObject* const parent = nullptr);
+   ~QStereoRenderLoop();
+
+   bool isRunning() const;
+   bool start(QOpenGLContext& context, QSurface& surface, const Frame& frame);
+   void stop();
+
+   quint64 frameCount() const;
+private:
+   explicit QStereoRenderLoop(const QStereoRenderLoop&) = delete;
+   QStereoRenderLoop& operator=(const QStereoRenderLoop&) = delete;
+
+   QStereoRenderLoopPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoRenderLoop);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREORENDERLOOP_H
@@ -0,0 +1,69 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereorenderloop_p.h"
+#include "qstereotrace.h"
+#include <QtGui/QOpenGLContext>
+
+
+QStereoRenderLoopPrivate::QStereoRenderLoopPrivate(QStereoRenderLoop* const parent) :
+QObject(parent),
+renderThread(*this),
+context(nullptr),
+surface(nullptr),
+stopping(false),
+frameCount(0)
+{}
+
+
+QStereoRenderLoopPrivate::Thread::Thread(QStereoRenderLoopPrivate& loop) :
+loop_(loop)
+{}
+
+
+void
+QStereoRenderLoopPrivate::Thread::run()
+{
+   loop_.run();
+}
+
+
+void
+QStereoRenderLoopPrivate::run()
+{
+   QStereoTrace::setThreadName("QStereoRenderLoop");
+   if (context->makeCurrent(surface))
+   {
+      while (!stopping.load())
+      {
+         frame();
+         ++frameCount;
+      }
+      context->doneCurrent();
+   }
+   else
+      qWarning("[QtStereoscopy] Warning: Could not make a render loop's context current.");
+
+   // The context is returned to the loop's thread, where it may be used or destroyed.
+   context->moveToThread(thread());
+}
@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREORENDERLOOP_P_H
+#define QSTEREORENDERLOOP_P_H
+
+#include "qstereorenderloop.h"
+#include <QtCore/QThread>
+#include <atomic>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoRenderLoopPrivate : public QObject
+{
+public:
+   explicit QStereoRenderLoopPrivate(QStereoRenderLoop* const parent);
+
+   class Thread : public QThread
+   {
+   public:
+      explicit Thread(QStereoRenderLoopPrivate& loop);
+   private:
+      void run() Q_DECL_OVERRIDE;
+
+      QStereoRenderLoopPrivate& loop_;
+   };
+   void run();
+
+   Thread renderThread;
+   QOpenGLContext* context;
+   QSurface* surface;
+   QStereoRenderLoop::Frame frame;
+   std::atomic<bool> stopping;
+   std::atomic<quint64> frameCount;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREORENDERLOOP_P_H
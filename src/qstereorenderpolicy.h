@@ -0,0 +1,77 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREORENDERPOLICY_H
+#define QSTEREORENDERPOLICY_H
+
+#include "qeye.h"
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoRenderFeature
+{
+public:
+   enum : unsigned int
+   {
+      NoFeatures      = 0x00,
+      FrameTiming     = 0x01,
+      LateLatch       = 0x02,
+      FrameCapture    = 0x04,
+      ResourceLoading = 0x08,
+      TaskScheduling  = 0x10,
+      AllFeatures     = 0x1f
+   };
+private:
+   QStereoRenderFeature() = delete;
+};
+
+
+template<unsigned int EyeCount = 2, QEye FirstEye = QEye::Left, unsigned int Features = QStereoRenderFeature::AllFeatures>
+class QStereoRenderPolicy
+{
+   static_assert(EyeCount == 1 || EyeCount == 2, "A stereo renderer draws either one or two eyes.");
+public:
+   static Q_DECL_CONSTEXPR bool staticDispatch(){ return true; }
+   static Q_DECL_CONSTEXPR unsigned int eyeCount(){ return EyeCount; }
+   static Q_DECL_CONSTEXPR QEye eye(const unsigned int& i){ return i == 0 ? FirstEye : (FirstEye == QEye::Left ? QEye::Right : QEye::Left); }
+   static Q_DECL_CONSTEXPR bool hasFeature(const unsigned int& feature){ return (Features & feature) == feature; }
+private:
+   QStereoRenderPolicy() = delete;
+};
+
+
+class QStereoDynamicRenderPolicy
+{
+public:
+   static Q_DECL_CONSTEXPR bool staticDispatch(){ return false; }
+   static Q_DECL_CONSTEXPR unsigned int eyeCount(){ return 2; }
+   static Q_DECL_CONSTEXPR QEye eye(const unsigned int& i){ return i == 0 ? QEye::Left : QEye::Right; }
+   static Q_DECL_CONSTEXPR bool hasFeature(const unsigned int&){ return true; }
+private:
+   QStereoDynamicRenderPolicy() = delete;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREORENDERPOLICY_H
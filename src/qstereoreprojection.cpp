@@ -0,0 +1,251 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoreprojection.h"
+#include "qstereoreprojection_p.h"
+#include "qstereoeyeparameters.h"
+#include "qstereotrace.h"
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFramebufferObject>
+#include <QtGui/QOpenGLFunctions_3_2_Core>
+
+
+QStereoReprojection::QStereoReprojection(QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoReprojectionPrivate(this))
+{}
+
+
+QStereoReprojection::~QStereoReprojection()
+{
+   // The textures can only be released while a context of their share group is current.
+   if (isCreated() && QOpenGLContext::currentContext() != nullptr)
+      destroy();
+}
+
+
+bool
+QStereoReprojection::create()
+{
+   if (isCreated())
+      return true;
+
+   auto* const context = QOpenGLContext::currentContext();
+   auto* const gl = context != nullptr ? context->versionFunctions<QOpenGLFunctions_3_2_Core>() : nullptr;
+   if (gl == nullptr || !gl->initializeOpenGLFunctions())
+   {
+      qWarning("[QtStereoscopy] Warning: Reprojection requires an OpenGL 3.2 context.");
+      return false;
+   }
+
+   Q_D(QStereoReprojection);
+   d->gl = gl;
+   if (!d->createProgram())
+   {
+      d->gl = nullptr;
+      return false;
+   }
+
+   // The grid is generated in the vertex shader, but drawing still requires a vertex array object.
+   gl->glGenVertexArrays(1, &d->vertexArray);
+   return true;
+}
+
+
+void
+QStereoReprojection::destroy()
+{
+   Q_D(QStereoReprojection);
+   if (d->gl == nullptr)
+      return;
+
+   d->destroyHistory();
+   d->gl->glDeleteVertexArrays(1, &d->vertexArray);
+   d->vertexArray = 0;
+   d->program.reset();
+   d->gl = nullptr;
+}
+
+
+bool
+QStereoReprojection::isCreated() const
+{
+   Q_D(const QStereoReprojection);
+   return d->gl != nullptr;
+}
+
+
+const unsigned int&
+QStereoReprojection::gridResolution() const
+{
+   Q_D(const QStereoReprojection);
+   return d->gridResolution;
+}
+
+
+void
+QStereoReprojection::setGridResolution(const unsigned int& resolution)
+{
+   Q_D(QStereoReprojection);
+   d->gridResolution = qMax(1u, resolution);
+}
+
+
+bool
+QStereoReprojection::reverseDepth() const
+{
+   Q_D(const QStereoReprojection);
+   return d->reverseDepth;
+}
+
+
+void
+QStereoReprojection::setReverseDepth(const bool reverse)
+{
+   Q_D(QStereoReprojection);
+   d->reverseDepth = reverse;
+}
+
+
+bool
+QStereoReprojection::hasHistory(const QEye& eye) const
+{
+   Q_D(const QStereoReprojection);
+   return d->eyeStored[static_cast<int>(eye)];
+}
+
+
+void
+QStereoReprojection::clearHistory()
+{
+   Q_D(QStereoReprojection);
+   d->eyeStored = {false, false};
+}
+
+
+void
+QStereoReprojection::store(const QOpenGLFramebufferObject& framebuffer, const QStereoEyeParameters& parameters)
+{
+   Q_D(QStereoReprojection);
+   if (d->gl == nullptr)
+      return;
+
+   d->gl->glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.handle());
+   if (!d->configureHistory(framebuffer))
+      return;
+
+   QSTEREO_TRACE_ZONE("QStereoReprojection::store");
+
+   // The eye's image and depth are copied as they are once the eye has been drawn, so that a later frame
+   // can be synthesized from them. A multisampled framebuffer is resolved by the copy.
+   const auto& i = static_cast<int>(parameters.eye());
+   const auto& viewport = parameters.viewport();
+   const auto& x0 = viewport.x();
+   const auto& y0 = viewport.y();
+   const auto& x1 = x0 + viewport.width();
+   const auto& y1 = y0 + viewport.height();
+
+   d->gl->glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.handle());
+   d->gl->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, d->historyFramebuffer);
+   d->gl->glBlitFramebuffer(x0, y0, x1, y1, x0, y0, x1, y1, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+   d->gl->glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.handle());
+
+   d->eyeViewProjection[i] = QStereoReprojectionPrivate::viewProjection(parameters);
+   d->eyeViewport[i] = viewport;
+   d->eyeStored[i] = true;
+}
+
+
+bool
+QStereoReprojection::reproject(const QStereoEyeParameters& parameters)
+{
+   Q_D(QStereoReprojection);
+   const auto& i = static_cast<int>(parameters.eye());
+   if (d->gl == nullptr || !d->eyeStored[i])
+      return false;
+
+   QSTEREO_TRACE_ZONE("QStereoReprojection::reproject");
+   auto* const gl = d->gl;
+
+   const auto& viewport = parameters.viewport();
+   const auto& stored = d->eyeViewport[i];
+   const auto& w = static_cast<float>(d->historySize.width());
+   const auto& h = static_cast<float>(d->historySize.height());
+
+   GLint previousTexture = 0;
+   gl->glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+   GLint previousDepthFunc = GL_LESS;
+   gl->glGetIntegerv(GL_DEPTH_FUNC, &previousDepthFunc);
+   const auto& depthTest = gl->glIsEnabled(GL_DEPTH_TEST);
+   const auto& scissorTest = gl->glIsEnabled(GL_SCISSOR_TEST);
+
+   // A reversed depth buffer is cleared to the far plane at 0, and closer surfaces have greater depths.
+   gl->glViewport(viewport.x(), viewport.y(), viewport.width(), viewport.height());
+   gl->glEnable(GL_SCISSOR_TEST);
+   gl->glScissor(viewport.x(), viewport.y(), viewport.width(), viewport.height());
+   gl->glClearDepth(d->reverseDepth ? 0.0 : 1.0);
+   gl->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+   gl->glClearDepth(1.0);
+   gl->glEnable(GL_DEPTH_TEST);
+   gl->glDepthFunc(d->reverseDepth ? GL_GREATER : GL_LESS);
+
+   // The reprojection maps the previous image's normalized device coordinates into the newest pose's clip space.
+   const auto& reprojection = QStereoReprojectionPrivate::viewProjection(parameters) * d->eyeViewProjection[i].inverted();
+   const auto& grid = static_cast<int>(d->gridResolution);
+
+   d->program->bind();
+   d->program->setUniformValue("reprojection", reprojection);
+   d->program->setUniformValue("viewport", QVector4D(stored.x() / w, stored.y() / h, stored.width() / w, stored.height() / h));
+   d->program->setUniformValue("resolution", grid);
+   d->program->setUniformValue("reverseDepth", static_cast<GLint>(d->reverseDepth));
+   d->program->setUniformValue("color", 0);
+   d->program->setUniformValue("depth", 1);
+
+   gl->glActiveTexture(GL_TEXTURE1);
+   gl->glBindTexture(GL_TEXTURE_2D, d->historyDepth);
+   gl->glActiveTexture(GL_TEXTURE0);
+   gl->glBindTexture(GL_TEXTURE_2D, d->historyColor);
+   gl->glBindVertexArray(d->vertexArray);
+   gl->glDrawArrays(GL_TRIANGLES, 0, 6 * grid * grid);
+   gl->glBindVertexArray(0);
+   gl->glActiveTexture(GL_TEXTURE1);
+   gl->glBindTexture(GL_TEXTURE_2D, 0);
+   gl->glActiveTexture(GL_TEXTURE0);
+   gl->glBindTexture(GL_TEXTURE_2D, previousTexture);
+   d->program->release();
+
+   gl->glDepthFunc(previousDepthFunc);
+   if (!depthTest)
+      gl->glDisable(GL_DEPTH_TEST);
+   if (!scissorTest)
+      gl->glDisable(GL_SCISSOR_TEST);
+
+   return true;
+}
+
+
+QMatrix4x4
+QStereoReprojection::matrix(const QStereoEyeParameters& from, const QStereoEyeParameters& to)
+{
+   return QStereoReprojectionPrivate::viewProjection(to) * QStereoReprojectionPrivate::viewProjection(from).inverted();
+}
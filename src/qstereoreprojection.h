@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOREPROJECTION_H
+#define QSTEREOREPROJECTION_H
+
+#include "qeye.h"
+#include <QtCore/QObject>
+#include <QtGui/QMatrix4x4>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLFramebufferObject;
+class QStereoEyeParameters;
+class QStereoReprojectionPrivate;
+class QStereoReprojection : public QObject
+{
+public:
+   explicit QStereoReprojection(QObject* const parent = nullptr);
+   ~QStereoReprojection();
+
+   bool create();
+   void destroy();
+   bool isCreated() const;
+
+   const unsigned int& gridResolution() const;
+   void setGridResolution(const unsigned int& resolution);
+
+   bool reverseDepth() const;
+   void setReverseDepth(const bool reverse);
+
+   bool hasHistory(const QEye& eye) const;
+   void clearHistory();
+
+   void store(const QOpenGLFramebufferObject& framebuffer, const QStereoEyeParameters& parameters);
+   bool reproject(const QStereoEyeParameters& parameters);
+
+   static QMatrix4x4 matrix(const QStereoEyeParameters& from, const QStereoEyeParameters& to);
+private:
+   QStereoReprojectionPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoReprojection);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOREPROJECTION_H
@@ -0,0 +1,184 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoreprojection_p.h"
+#include "qstereoeyeparameters.h"
+#include <QtGui/QOpenGLFramebufferObject>
+#include <QtGui/QOpenGLFunctions_3_2_Core>
+
+
+QStereoReprojectionPrivate::QStereoReprojectionPrivate(QStereoReprojection* const parent) :
+QObject(parent),
+gl(nullptr),
+program(nullptr),
+vertexArray(0),
+gridResolution(64),
+reverseDepth(false),
+historyFramebuffer(0),
+historyColor(0),
+historyDepth(0),
+historyDepthFormat(0),
+eyeStored({false, false})
+{}
+
+
+bool
+QStereoReprojectionPrivate::createProgram()
+{
+   // The eye is covered by a grid of cells, two triangles each, generated from the vertex ID so that no
+   // vertex data is needed. Each grid vertex is moved to where the surface it sees in the previous image,
+   // at the depth stored for it, appears from the newest pose. Where the grid folds over itself, the depth
+   // test keeps the closest surface. A reversed depth buffer already holds normalized device depth, since
+   // its clip space depth ranges from 0 to 1.
+   static const char* const vertexShader =
+      "#version 150\n"
+      "uniform sampler2D depth;\n"
+      "uniform mat4 reprojection;\n"
+      "uniform vec4 viewport;\n"
+      "uniform int resolution;\n"
+      "uniform bool reverseDepth;\n"
+      "out vec2 texCoord;\n"
+      "const ivec2 corners[6] = ivec2[6](ivec2(0, 0), ivec2(1, 0), ivec2(0, 1), ivec2(0, 1), ivec2(1, 0), ivec2(1, 1));\n"
+      "void main()\n"
+      "{\n"
+      "   int cell = gl_VertexID / 6;\n"
+      "   vec2 grid = vec2(ivec2(cell % resolution, cell / resolution) + corners[gl_VertexID % 6]) / float(resolution);\n"
+      "   texCoord = viewport.xy + grid * viewport.zw;\n"
+      "   float z = textureLod(depth, texCoord, 0.0).r;\n"
+      "   gl_Position = reprojection * vec4(2.0 * grid - 1.0, reverseDepth ? z : 2.0 * z - 1.0, 1.0);\n"
+      "}\n";
+   static const char* const fragmentShader =
+      "#version 150\n"
+      "uniform sampler2D color;\n"
+      "in vec2 texCoord;\n"
+      "out vec4 fragColor;\n"
+      "void main()\n"
+      "{\n"
+      "   fragColor = texture(color, texCoord);\n"
+      "}\n";
+
+   program.reset(new QOpenGLShaderProgram);
+   program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShader);
+   program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShader);
+   if (!program->link())
+   {
+      qWarning("[QtStereoscopy] Warning: Could not link the reprojection's shader program.");
+      program.reset();
+      return false;
+   }
+   return true;
+}
+
+
+bool
+QStereoReprojectionPrivate::configureHistory(const QOpenGLFramebufferObject& framebuffer)
+{
+   // Depth can only be blitted between buffers of the same format, so the history's depth texture
+   // matches the framebuffer's depth attachment, which is bound when this is called.
+   GLint depthSize = 0;
+   GLint depthType = 0;
+   gl->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, &depthSize);
+   gl->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &depthType);
+   if (depthSize == 0)
+   {
+      qWarning("[QtStereoscopy] Warning: Reprojection requires a framebuffer with a depth attachment.");
+      return false;
+   }
+
+   GLenum depthFormat = GL_DEPTH_COMPONENT24;
+   if (depthType == GL_FLOAT)
+      depthFormat = GL_DEPTH_COMPONENT32F;
+   else if (depthSize <= 16)
+      depthFormat = GL_DEPTH_COMPONENT16;
+   else if (depthSize > 24)
+      depthFormat = GL_DEPTH_COMPONENT32;
+
+   const auto& size = framebuffer.size();
+   if (historyFramebuffer != 0 && historySize == size && historyDepthFormat == depthFormat)
+      return true;
+
+   destroyHistory();
+   historySize = size;
+   historyDepthFormat = depthFormat;
+
+   GLint previousTexture = 0;
+   gl->glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+
+   const auto& createTexture = [this, &size](GLuint& texture, const GLenum& internalFormat, const GLenum& format, const GLenum& type)
+   {
+      gl->glGenTextures(1, &texture);
+      gl->glBindTexture(GL_TEXTURE_2D, texture);
+      gl->glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, size.width(), size.height(), 0, format, type, nullptr);
+      gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+      gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+      gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+   };
+   createTexture(historyColor, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+   createTexture(historyDepth, depthFormat, GL_DEPTH_COMPONENT, depthType == GL_FLOAT ? GL_FLOAT : GL_UNSIGNED_INT);
+   gl->glBindTexture(GL_TEXTURE_2D, previousTexture);
+
+   gl->glGenFramebuffers(1, &historyFramebuffer);
+   gl->glBindFramebuffer(GL_FRAMEBUFFER, historyFramebuffer);
+   gl->glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, historyColor, 0);
+   gl->glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, historyDepth, 0);
+   const auto& complete = gl->glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+   gl->glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.handle());
+
+   if (!complete)
+   {
+      qWarning("[QtStereoscopy] Warning: Could not create the reprojection's history framebuffer.");
+      destroyHistory();
+      return false;
+   }
+   return true;
+}
+
+
+void
+QStereoReprojectionPrivate::destroyHistory()
+{
+   if (gl != nullptr)
+   {
+      gl->glDeleteFramebuffers(1, &historyFramebuffer);
+      gl->glDeleteTextures(1, &historyColor);
+      gl->glDeleteTextures(1, &historyDepth);
+   }
+   historyFramebuffer = 0;
+   historyColor = 0;
+   historyDepth = 0;
+   historyDepthFormat = 0;
+   historySize = QSize();
+   eyeStored = {false, false};
+}
+
+
+QMatrix4x4
+QStereoReprojectionPrivate::viewProjection(const QStereoEyeParameters& parameters)
+{
+   // The eye's view matrix leaves out the head's position, which reprojection must account for.
+   QMatrix4x4 view = parameters.view();
+   view.translate(-parameters.headPosition());
+
+   return parameters.perspective() * view;
+}
@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOREPROJECTION_P_H
+#define QSTEREOREPROJECTION_P_H
+
+#include "qstereoreprojection.h"
+#include <QtCore/QRect>
+#include <QtCore/QSize>
+#include <QtGui/QOpenGLShaderProgram>
+#include <array>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLFunctions_3_2_Core;
+class QStereoReprojectionPrivate : public QObject
+{
+public:
+   explicit QStereoReprojectionPrivate(QStereoReprojection* const parent);
+
+   bool createProgram();
+   bool configureHistory(const QOpenGLFramebufferObject& framebuffer);
+   void destroyHistory();
+
+   static QMatrix4x4 viewProjection(const QStereoEyeParameters& parameters);
+
+   QOpenGLFunctions_3_2_Core* gl;
+   QScopedPointer<QOpenGLShaderProgram> program;
+   GLuint vertexArray;
+   unsigned int gridResolution;
+   bool reverseDepth;
+
+   GLuint historyFramebuffer;
+   GLuint historyColor;
+   GLuint historyDepth;
+   GLenum historyDepthFormat;
+   QSize historySize;
+
+   std::array<QMatrix4x4, 2> eyeViewProjection;
+   std::array<QRect,      2> eyeViewport;
+   std::array<bool,       2> eyeStored;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOREPROJECTION_P_H
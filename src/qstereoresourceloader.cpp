@@ -0,0 +1,132 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoresourceloader.h"
+#include "qstereoresourceloader_p.h"
+
+
+QStereoResourceLoader::QStereoResourceLoader(QOpenGLContext& shareContext, const unsigned int& workerCount, QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoResourceLoaderPrivate(this, shareContext, workerCount))
+{}
+
+
+QStereoResourceLoader::~QStereoResourceLoader()
+{
+   Q_D(QStereoResourceLoader);
+   d->stop();
+}
+
+
+const unsigned int&
+QStereoResourceLoader::workerCount() const
+{
+   Q_D(const QStereoResourceLoader);
+   return d->workerCount;
+}
+
+
+bool
+QStereoResourceLoader::started() const
+{
+   Q_D(const QStereoResourceLoader);
+   return !d->workers.isEmpty();
+}
+
+
+bool
+QStereoResourceLoader::start()
+{
+   Q_D(QStereoResourceLoader);
+   if (Q_UNLIKELY(!d->shareContext.isValid()))
+   {
+      qWarning("[QtStereoscopy] Warning: Resource loader workers require a valid share context.");
+      return false;
+   }
+   return d->start();
+}
+
+
+quint64
+QStereoResourceLoader::submit(const Job& job)
+{
+   Q_D(QStereoResourceLoader);
+   QMutexLocker locker(&d->mutex);
+
+   const auto ticket = d->nextTicket++;
+   d->tasks.enqueue({ticket, job});
+   ++d->pendingJobCount;
+   d->condition.wakeOne();
+
+   return ticket;
+}
+
+
+quint64
+QStereoResourceLoader::uploadTexture(const QImage& image, const bool generateMipmaps)
+{
+   return submit([image, generateMipmaps](QOpenGLContext& context)
+   {
+      return QStereoResourceLoaderPrivate::uploadTexture(context, image, generateMipmaps);
+   });
+}
+
+
+quint64
+QStereoResourceLoader::uploadBuffer(const QByteArray& data, const GLenum& target, const GLenum& usage)
+{
+   return submit([data, target, usage](QOpenGLContext& context)
+   {
+      return QStereoResourceLoaderPrivate::uploadBuffer(context, data, target, usage);
+   });
+}
+
+
+unsigned int
+QStereoResourceLoader::pendingJobCount() const
+{
+   Q_D(const QStereoResourceLoader);
+   QMutexLocker locker(&d->mutex);
+   return d->pendingJobCount;
+}
+
+
+void
+QStereoResourceLoader::collect()
+{
+   Q_D(QStereoResourceLoader);
+
+   // Workers are started the first time there's work for them, unless start() was called beforehand.
+   if (d->workers.isEmpty() && d->shareContext.isValid() && pendingJobCount() > 0)
+      d->start();
+
+   QVector<QStereoResourceLoaderPrivate::Result> results;
+   {
+      QMutexLocker locker(&d->mutex);
+      results.swap(d->results);
+      d->pendingJobCount -= results.size();
+   }
+
+   for (const auto& result : results)
+      emit resourceReady(result.ticket, result.name);
+}
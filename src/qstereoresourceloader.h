@@ -0,0 +1,66 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREORESOURCELOADER_H
+#define QSTEREORESOURCELOADER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtGui/QImage>
+#include <QtGui/qopengl.h>
+#include <functional>
+
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLContext;
+class QStereoResourceLoaderPrivate;
+class QStereoResourceLoader : public QObject
+{
+   Q_OBJECT
+public:
+   using Job = std::function<GLuint(QOpenGLContext& context)>;
+
+   explicit QStereoResourceLoader(QOpenGLContext& shareContext, const unsigned int& workerCount = 1, QObject* const parent = nullptr);
+   ~QStereoResourceLoader();
+
+   const unsigned int& workerCount() const;
+   bool started() const;
+   bool start();
+
+   quint64 submit(const Job& job);
+   quint64 uploadTexture(const QImage& image, const bool generateMipmaps = false);
+   quint64 uploadBuffer(const QByteArray& data, const GLenum& target = GL_ARRAY_BUFFER, const GLenum& usage = GL_STATIC_DRAW);
+
+   unsigned int pendingJobCount() const;
+   void collect();
+signals:
+   void resourceReady(const quint64& ticket, const GLuint& name);
+private:
+   QStereoResourceLoaderPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoResourceLoader);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREORESOURCELOADER_H
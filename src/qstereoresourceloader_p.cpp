@@ -0,0 +1,202 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoresourceloader_p.h"
+#include "qstereotrace.h"
+#include <QtGui/QOpenGLFunctions>
+#include <QtGui/QOpenGLFunctions_3_2_Core>
+#include <algorithm>
+
+
+QStereoResourceLoaderPrivate::QStereoResourceLoaderPrivate
+(
+   QStereoResourceLoader* const parent,
+   QOpenGLContext& shareContext,
+   const unsigned int& workerCount
+) :
+QObject(parent),
+shareContext(shareContext),
+workerCount(std::max(workerCount, 1u)),
+nextTicket(1),
+pendingJobCount(0),
+stopping(false)
+{}
+
+
+bool
+QStereoResourceLoaderPrivate::start()
+{
+   if (!workers.isEmpty())
+      return true;
+
+   // Offscreen surfaces and contexts are created on the thread that owns the share context, after
+   // which each context is handed over to the worker that makes it current.
+   const auto& format = shareContext.format();
+   for (unsigned int i = 0; i < workerCount; ++i)
+   {
+      auto* const worker = new Worker(*this);
+      worker->surface.setFormat(format);
+      worker->surface.create();
+      worker->context.setFormat(format);
+      worker->context.setShareContext(&shareContext);
+      if (!worker->context.create())
+      {
+         delete worker;
+         qWarning("[QtStereoscopy] Warning: Could not create a shared OpenGL context for a resource loader worker.");
+         break;
+      }
+      worker->context.moveToThread(worker);
+      worker->start(QThread::LowPriority);
+      workers.append(worker);
+   }
+   return !workers.isEmpty();
+}
+
+
+void
+QStereoResourceLoaderPrivate::stop()
+{
+   {
+      QMutexLocker locker(&mutex);
+      stopping = true;
+      condition.wakeAll();
+   }
+   for (auto* const worker : workers)
+      worker->wait();
+
+   qDeleteAll(workers);
+   workers.clear();
+}
+
+
+QStereoResourceLoaderPrivate::Worker::Worker(QStereoResourceLoaderPrivate& loader) :
+loader_(loader)
+{}
+
+
+void
+QStereoResourceLoaderPrivate::Worker::run()
+{
+   loader_.run(*this);
+}
+
+
+void
+QStereoResourceLoaderPrivate::run(Worker& worker)
+{
+   QStereoTrace::setThreadName("QStereoResourceLoader");
+   if (!worker.context.makeCurrent(&worker.surface))
+   {
+      qWarning("[QtStereoscopy] Warning: Could not make a resource loader worker's context current.");
+      return;
+   }
+
+   // Fences require OpenGL 3.2. Without them, the worker waits for all of its commands to complete instead.
+   auto* const gl = worker.context.functions();
+   auto* const sync = worker.context.versionFunctions<QOpenGLFunctions_3_2_Core>();
+   if (sync != nullptr && !sync->initializeOpenGLFunctions())
+      qFatal("[QtStereoscopy] Error: Could not initialize OpenGL 3.2 functions.");
+
+   forever
+   {
+      Task task;
+      {
+         QMutexLocker locker(&mutex);
+         while (tasks.isEmpty() && !stopping)
+            condition.wait(&mutex);
+
+         if (stopping)
+            break;
+
+         task = tasks.dequeue();
+      }
+
+      QSTEREO_TRACE_ZONE("QStereoResourceLoader::run");
+      const auto& name = task.job(worker.context);
+
+      // A resource is only published once the GPU has finished with it, so it's never used by the
+      // render context while an upload is still in flight. Only this worker waits on the fence.
+      if (sync != nullptr)
+      {
+         const auto fence = sync->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+         GLenum status = GL_TIMEOUT_EXPIRED;
+         while (status == GL_TIMEOUT_EXPIRED)
+            status = sync->glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+         sync->glDeleteSync(fence);
+         if (Q_UNLIKELY(status == GL_WAIT_FAILED))
+            qWarning("[QtStereoscopy] Warning: Could not wait for a resource upload to complete.");
+      }
+      else
+         gl->glFinish();
+
+      QMutexLocker locker(&mutex);
+      results.append({task.ticket, name});
+   }
+
+   // The context is returned to the loader's thread, where it's destroyed.
+   worker.context.doneCurrent();
+   worker.context.moveToThread(thread());
+}
+
+
+GLuint
+QStereoResourceLoaderPrivate::uploadTexture(QOpenGLContext& context, const QImage& image, const bool generateMipmaps)
+{
+   QSTEREO_TRACE_ZONE("QStereoResourceLoader::uploadTexture");
+
+   // OpenGL expects rows from bottom to top, and the conversion is done here rather than on the render thread.
+   const auto& pixels = image.convertToFormat(QImage::Format_RGBA8888).mirrored();
+   auto* const gl = context.functions();
+
+   GLuint texture = 0;
+   gl->glGenTextures(1, &texture);
+   gl->glBindTexture(GL_TEXTURE_2D, texture);
+   gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pixels.width(), pixels.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.constBits());
+   gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+   if (generateMipmaps)
+   {
+      gl->glGenerateMipmap(GL_TEXTURE_2D);
+      gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+   }
+   else
+      gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+   gl->glBindTexture(GL_TEXTURE_2D, 0);
+   return texture;
+}
+
+
+GLuint
+QStereoResourceLoaderPrivate::uploadBuffer(QOpenGLContext& context, const QByteArray& data, const GLenum& target, const GLenum& usage)
+{
+   QSTEREO_TRACE_ZONE("QStereoResourceLoader::uploadBuffer");
+   auto* const gl = context.functions();
+
+   GLuint buffer = 0;
+   gl->glGenBuffers(1, &buffer);
+   gl->glBindBuffer(target, buffer);
+   gl->glBufferData(target, data.size(), data.constData(), usage);
+   gl->glBindBuffer(target, 0);
+   return buffer;
+}
@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREORESOURCELOADER_P_H
+#define QSTEREORESOURCELOADER_P_H
+
+#include "qstereoresourceloader.h"
+#include <QtCore/QMutex>
+#include <QtCore/QQueue>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoResourceLoaderPrivate : public QObject
+{
+public:
+   QStereoResourceLoaderPrivate(QStereoResourceLoader* const parent, QOpenGLContext& shareContext, const unsigned int& workerCount);
+
+   bool start();
+   void stop();
+
+   class Worker : public QThread
+   {
+   public:
+      explicit Worker(QStereoResourceLoaderPrivate& loader);
+
+      QOffscreenSurface surface;
+      QOpenGLContext context;
+   private:
+      void run() Q_DECL_OVERRIDE;
+
+      QStereoResourceLoaderPrivate& loader_;
+   };
+   void run(Worker& worker);
+
+   static GLuint uploadTexture(QOpenGLContext& context, const QImage& image, const bool generateMipmaps);
+   static GLuint uploadBuffer(QOpenGLContext& context, const QByteArray& data, const GLenum& target, const GLenum& usage);
+
+   struct Task
+   {
+      quint64 ticket;
+      QStereoResourceLoader::Job job;
+   };
+
+   struct Result
+   {
+      quint64 ticket;
+      GLuint name;
+   };
+
+   QOpenGLContext& shareContext;
+   const unsigned int workerCount;
+   QVector<Worker*> workers;
+
+   mutable QMutex mutex;
+   QWaitCondition condition;
+   QQueue<Task> tasks;
+   QVector<Result> results;
+   quint64 nextTicket;
+   unsigned int pendingJobCount;
+   bool stopping;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREORESOURCELOADER_P_H
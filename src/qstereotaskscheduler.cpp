@@ -0,0 +1,145 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereotaskscheduler.h"
+#include "qstereotaskscheduler_p.h"
+#include "qstereoframestatistics.h"
+
+
+Q_GLOBAL_STATIC(QStereoTaskScheduler, globalScheduler)
+
+
+QStereoTaskScheduler::QStereoTaskScheduler(const unsigned int& workerCount, QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoTaskSchedulerPrivate(this, workerCount))
+{
+   Q_D(QStereoTaskScheduler);
+   d->start();
+}
+
+
+QStereoTaskScheduler::~QStereoTaskScheduler()
+{
+   Q_D(QStereoTaskScheduler);
+   d->stop();
+}
+
+
+QStereoTaskScheduler*
+QStereoTaskScheduler::globalInstance()
+{
+   return globalScheduler();
+}
+
+
+const unsigned int&
+QStereoTaskScheduler::workerCount() const
+{
+   Q_D(const QStereoTaskScheduler);
+   return d->workerCount;
+}
+
+
+QStereoTaskScheduler::Handle
+QStereoTaskScheduler::submit(const QByteArray& name, const Task& task, const Deadline& deadline, const QVector<Handle>& dependencies)
+{
+   Q_D(QStereoTaskScheduler);
+   QMutexLocker locker(&d->mutex);
+
+   auto* const record = new QStereoTaskSchedulerPrivate::Record{d->nextHandle++, name, task, deadline, 0, {}};
+   d->records.insert(record->handle, record);
+   ++d->pending[static_cast<unsigned int>(deadline)];
+
+   // Dependencies that have already finished are no longer recorded, and are therefore satisfied.
+   for (const auto& handle : dependencies)
+   {
+      auto* const dependency = d->records.value(handle, nullptr);
+      if (dependency != nullptr)
+      {
+         dependency->dependents.append(record);
+         ++record->unfinishedDependencies;
+      }
+   }
+   if (record->unfinishedDependencies == 0)
+      d->push(record);
+
+   return record->handle;
+}
+
+
+bool
+QStereoTaskScheduler::isFinished(const Handle& handle) const
+{
+   Q_D(const QStereoTaskScheduler);
+   QMutexLocker locker(&d->mutex);
+   return !d->records.contains(handle);
+}
+
+
+void
+QStereoTaskScheduler::wait(const Handle& handle)
+{
+   Q_D(QStereoTaskScheduler);
+   d->waitUntil([d, &handle]{ return !d->records.contains(handle); });
+}
+
+
+unsigned int
+QStereoTaskScheduler::pendingTaskCount(const Deadline& deadline) const
+{
+   Q_D(const QStereoTaskScheduler);
+   QMutexLocker locker(&d->mutex);
+   return d->pending[static_cast<unsigned int>(deadline)];
+}
+
+
+void
+QStereoTaskScheduler::beginFrame()
+{
+   Q_D(QStereoTaskScheduler);
+   QMutexLocker locker(&d->mutex);
+   d->promote();
+}
+
+
+void
+QStereoTaskScheduler::endFrame(QStereoFrameStatistics* const statistics)
+{
+   Q_D(QStereoTaskScheduler);
+
+   // The frame cannot be submitted until every task that is due this frame has finished.
+   const auto& current = static_cast<unsigned int>(Deadline::CurrentFrame);
+   d->waitUntil([d, &current]{ return d->pending[current] == 0; });
+
+   QVector<QPair<QByteArray, double>> timings;
+   {
+      QMutexLocker locker(&d->mutex);
+      timings.swap(d->timings);
+   }
+   if (statistics != nullptr)
+   {
+      for (const auto& timing : timings)
+         statistics->recordTask(timing.first, timing.second);
+   }
+}
+
@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOTASKSCHEDULER_H
+#define QSTEREOTASKSCHEDULER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+#include <functional>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoFrameStatistics;
+class QStereoTaskSchedulerPrivate;
+class QStereoTaskScheduler : public QObject
+{
+public:
+   enum class Deadline
+   {
+      CurrentFrame,
+      NextFrame,
+      None
+   };
+   using Task = std::function<void()>;
+   using Handle = quint64;
+
+   explicit QStereoTaskScheduler(const unsigned int& workerCount = 0, QObject* const parent = nullptr);
+   ~QStereoTaskScheduler();
+
+   static QStereoTaskScheduler* globalInstance();
+
+   const unsigned int& workerCount() const;
+
+   Handle submit(const QByteArray& name, const Task& task, const Deadline& deadline = Deadline::CurrentFrame, const QVector<Handle>& dependencies = QVector<Handle>());
+   bool isFinished(const Handle& handle) const;
+   void wait(const Handle& handle);
+   unsigned int pendingTaskCount(const Deadline& deadline) const;
+
+   void beginFrame();
+   void endFrame(QStereoFrameStatistics* const statistics = nullptr);
+
+   static Q_DECL_CONSTEXPR unsigned int deadlineCount(){ return 3; }
+private:
+   explicit QStereoTaskScheduler(const QStereoTaskScheduler&) = delete;
+   QStereoTaskScheduler& operator=(const QStereoTaskScheduler&) = delete;
+
+   QStereoTaskSchedulerPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoTaskScheduler);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOTASKSCHEDULER_H
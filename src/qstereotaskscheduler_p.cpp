@@ -0,0 +1,274 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereotaskscheduler_p.h"
+#include "qstereotrace.h"
+#include <QtCore/QElapsedTimer>
+#include <algorithm>
+#include <numeric>
+
+
+QStereoTaskSchedulerPrivate::QStereoTaskSchedulerPrivate(QStereoTaskScheduler* const parent, const unsigned int& count) :
+QObject(parent),
+workerCount(count > 0 ? count : static_cast<unsigned int>(std::max(QThread::idealThreadCount() - 1, 1))),
+nextQueue(0),
+nextHandle(1),
+pending({{0, 0, 0}}),
+ready({{0, 0, 0}}),
+stopping(false)
+{}
+
+
+void
+QStereoTaskSchedulerPrivate::start()
+{
+   for (unsigned int i = 0; i < workerCount; ++i)
+      queues.append(new Queue);
+
+   for (unsigned int i = 0; i < workerCount; ++i)
+   {
+      auto* const worker = new Worker(*this, i);
+      worker->start();
+      workers.append(worker);
+   }
+}
+
+
+void
+QStereoTaskSchedulerPrivate::stop()
+{
+   {
+      QMutexLocker locker(&mutex);
+      stopping = true;
+      taskAvailable.wakeAll();
+   }
+   for (auto* const worker : workers)
+      worker->wait();
+
+   // Tasks that never ran are discarded along with their queues.
+   qDeleteAll(workers);
+   qDeleteAll(queues);
+   qDeleteAll(records);
+   workers.clear();
+   queues.clear();
+   records.clear();
+}
+
+
+QStereoTaskSchedulerPrivate::Worker::Worker(QStereoTaskSchedulerPrivate& scheduler, const unsigned int& index) :
+scheduler_(scheduler),
+index_(index)
+{}
+
+
+void
+QStereoTaskSchedulerPrivate::Worker::run()
+{
+   scheduler_.run(index_);
+}
+
+
+void
+QStereoTaskSchedulerPrivate::run(const unsigned int& index)
+{
+   QStereoTrace::setThreadName(QString("QStereoTaskScheduler %1").arg(index));
+   forever
+   {
+      auto* const record = take(static_cast<int>(index), QStereoTaskScheduler::Deadline::None);
+      if (record != nullptr)
+      {
+         execute(record);
+         continue;
+      }
+
+      QMutexLocker locker(&mutex);
+      while (std::accumulate(ready.begin(), ready.end(), 0u) == 0 && !stopping)
+         taskAvailable.wait(&mutex);
+
+      if (stopping)
+         break;
+   }
+}
+
+
+int
+QStereoTaskSchedulerPrivate::currentWorker() const
+{
+   const auto* const thread = QThread::currentThread();
+   for (int i = 0; i < workers.size(); ++i)
+   {
+      if (workers[i] == thread)
+         return i;
+   }
+   return -1;
+}
+
+
+void
+QStereoTaskSchedulerPrivate::push(Record* const record)
+{
+   // Called with the mutex locked. Tasks spawned by a worker stay in its own queue, whereas tasks
+   // submitted by any other thread are spread across the workers.
+   auto index = currentWorker();
+   if (index < 0)
+      index = static_cast<int>(nextQueue++ % workerCount);
+
+   const auto& deadline = static_cast<unsigned int>(record->deadline);
+   {
+      auto& queue = *queues[index];
+      QMutexLocker locker(&queue.mutex);
+      queue.tasks[deadline].push_back(record);
+   }
+   ++ready[deadline];
+   taskAvailable.wakeOne();
+   taskChanged.wakeAll();
+}
+
+
+QStereoTaskSchedulerPrivate::Record*
+QStereoTaskSchedulerPrivate::take(const int& self, const QStereoTaskScheduler::Deadline& latest)
+{
+   // Tasks are taken by order of urgency: a task due this frame is always run before a task that is
+   // due next frame, whichever queue it's in. Within a deadline, a thread empties its own queue first.
+   // The mutex is locked before any queue, like push() and promote() do, so that a task is popped and
+   // its ready count decremented without a frame beginning in between.
+   QMutexLocker locker(&mutex);
+   const auto& count = static_cast<int>(workerCount);
+   for (unsigned int d = 0; d <= static_cast<unsigned int>(latest); ++d)
+   {
+      if (ready[d] == 0)
+         continue;
+
+      for (int i = 0; i < count; ++i)
+      {
+         const auto& index = self < 0 ? i : (self + i) % count;
+         auto& queue = *queues[index];
+         QMutexLocker queueLocker(&queue.mutex);
+         auto& tasks = queue.tasks[d];
+         if (tasks.empty())
+            continue;
+
+         Record* record = nullptr;
+         if (index == self)
+         {
+            record = tasks.back();
+            tasks.pop_back();
+         }
+         else
+         {
+            record = tasks.front();
+            tasks.pop_front();
+         }
+         --ready[d];
+         return record;
+      }
+   }
+   return nullptr;
+}
+
+
+void
+QStereoTaskSchedulerPrivate::execute(Record* const record)
+{
+   QElapsedTimer timer;
+   timer.start();
+   {
+      QSTEREO_TRACE_ZONE("QStereoTaskScheduler::execute");
+      if (record->task)
+         record->task();
+   }
+   const auto& seconds = 1e-9 * timer.nsecsElapsed();
+
+   // Once finished, the task releases its dependents, which may then be run.
+   // Timings are kept until the end of the frame. If frames are not being ended, the oldest are dropped.
+   QMutexLocker locker(&mutex);
+   if (timings.size() < maximumTimingCount())
+      timings.append(qMakePair(record->name, seconds));
+   --pending[static_cast<unsigned int>(record->deadline)];
+   records.remove(record->handle);
+   for (auto* const dependent : record->dependents)
+   {
+      if (--dependent->unfinishedDependencies == 0)
+         push(dependent);
+   }
+   delete record;
+   taskChanged.wakeAll();
+}
+
+
+void
+QStereoTaskSchedulerPrivate::waitUntil(const std::function<bool()>& done)
+{
+   // Rather than blocking, a waiting thread helps with pending tasks. A thread other than a worker,
+   // such as the render thread, only helps with tasks due this frame, since picking up later work
+   // could delay the frame it is waiting on.
+   const auto& self = currentWorker();
+   const auto& latest = self < 0 ? QStereoTaskScheduler::Deadline::CurrentFrame : QStereoTaskScheduler::Deadline::None;
+   forever
+   {
+      {
+         QMutexLocker locker(&mutex);
+         if (done())
+            return;
+      }
+
+      auto* const record = take(self, latest);
+      if (record != nullptr)
+      {
+         execute(record);
+         continue;
+      }
+
+      QMutexLocker locker(&mutex);
+      while (!done() && std::accumulate(ready.begin(), ready.begin() + static_cast<unsigned int>(latest) + 1, 0u) == 0)
+         taskChanged.wait(&mutex);
+   }
+}
+
+
+void
+QStereoTaskSchedulerPrivate::promote()
+{
+   // Called with the mutex locked. Tasks that were due next frame are now due this frame.
+   const auto& current = static_cast<unsigned int>(QStereoTaskScheduler::Deadline::CurrentFrame);
+   const auto& next = static_cast<unsigned int>(QStereoTaskScheduler::Deadline::NextFrame);
+   for (auto* const record : records)
+   {
+      if (record->deadline == QStereoTaskScheduler::Deadline::NextFrame)
+         record->deadline = QStereoTaskScheduler::Deadline::CurrentFrame;
+   }
+   pending[current] += pending[next];
+   pending[next] = 0;
+
+   for (auto* const queue : queues)
+   {
+      QMutexLocker locker(&queue->mutex);
+      auto& from = queue->tasks[next];
+      auto& to = queue->tasks[current];
+      to.insert(to.end(), from.begin(), from.end());
+      from.clear();
+   }
+   ready[current] += ready[next];
+   ready[next] = 0;
+   taskChanged.wakeAll();
+}
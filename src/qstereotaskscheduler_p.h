@@ -0,0 +1,105 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOTASKSCHEDULER_P_H
+#define QSTEREOTASKSCHEDULER_P_H
+
+#include "qstereotaskscheduler.h"
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QPair>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+#include <array>
+#include <deque>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoTaskSchedulerPrivate : public QObject
+{
+public:
+   QStereoTaskSchedulerPrivate(QStereoTaskScheduler* const parent, const unsigned int& workerCount);
+
+   static Q_DECL_CONSTEXPR int maximumTimingCount(){ return 4096; }
+
+   struct Record
+   {
+      QStereoTaskScheduler::Handle handle;
+      QByteArray name;
+      QStereoTaskScheduler::Task task;
+      QStereoTaskScheduler::Deadline deadline;
+      unsigned int unfinishedDependencies;
+      QVector<Record*> dependents;
+   };
+
+   // Each worker owns a double-ended queue per deadline. A worker pops its own most recent task,
+   // which is likely to still be in its cache, while idle threads steal the oldest tasks of others.
+   struct Queue
+   {
+      QMutex mutex;
+      std::array<std::deque<Record*>, QStereoTaskScheduler::deadlineCount()> tasks;
+   };
+
+   class Worker : public QThread
+   {
+   public:
+      Worker(QStereoTaskSchedulerPrivate& scheduler, const unsigned int& index);
+   private:
+      void run() Q_DECL_OVERRIDE;
+
+      QStereoTaskSchedulerPrivate& scheduler_;
+      const unsigned int index_;
+   };
+
+   void start();
+   void stop();
+   void run(const unsigned int& index);
+
+   int currentWorker() const;
+   void push(Record* const record);
+   Record* take(const int& self, const QStereoTaskScheduler::Deadline& latest);
+   void execute(Record* const record);
+   void waitUntil(const std::function<bool()>& done);
+   void promote();
+
+   const unsigned int workerCount;
+   QVector<Worker*> workers;
+   QVector<Queue*> queues;
+   unsigned int nextQueue;
+
+   mutable QMutex mutex;
+   QWaitCondition taskAvailable;
+   QWaitCondition taskChanged;
+   QHash<QStereoTaskScheduler::Handle, Record*> records;
+   QStereoTaskScheduler::Handle nextHandle;
+   std::array<unsigned int, QStereoTaskScheduler::deadlineCount()> pending;
+   std::array<unsigned int, QStereoTaskScheduler::deadlineCount()> ready;
+   bool stopping;
+
+   QVector<QPair<QByteArray, double>> timings;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOTASKSCHEDULER_P_H
@@ -0,0 +1,255 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereotextrenderer.h"
+#include "qstereotextrenderer_p.h"
+#include "qstereoeyeparameters.h"
+#include "qstereotrace.h"
+#include <cstddef>
+
+
+QStereoTextRenderer::QStereoTextRenderer(const QFont& font, QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoTextRendererPrivate(this, font))
+{}
+
+
+const QFont&
+QStereoTextRenderer::font() const
+{
+   Q_D(const QStereoTextRenderer);
+   return d->font;
+}
+
+
+void
+QStereoTextRenderer::setFont(const QFont& font)
+{
+   Q_D(QStereoTextRenderer);
+   if (d->font == font)
+      return;
+
+   // Cached glyphs belong to the previous font, so every string is laid out again from a new atlas.
+   d->font = font;
+   d->resetAtlas();
+   d->atlasFull = false;
+   for (auto& text : d->texts)
+      d->layout(text);
+}
+
+
+int
+QStereoTextRenderer::addText(const QString& string, const QPointF& position, const QColor& color)
+{
+   Q_D(QStereoTextRenderer);
+
+   QStereoTextRendererPrivate::Text text;
+   text.string = string;
+   text.position = position;
+   text.color = color;
+   d->layout(text);
+
+   const auto& id = d->nextId++;
+   d->texts.insert(id, text);
+   return id;
+}
+
+
+void
+QStereoTextRenderer::setText(const int& id, const QString& string)
+{
+   Q_D(QStereoTextRenderer);
+   auto i = d->texts.find(id);
+   if (i == d->texts.end() || i->string == string)
+      return;
+
+   i->string = string;
+   d->layout(*i);
+}
+
+
+void
+QStereoTextRenderer::setPosition(const int& id, const QPointF& position)
+{
+   Q_D(QStereoTextRenderer);
+   auto i = d->texts.find(id);
+   if (i == d->texts.end() || i->position == position)
+      return;
+
+   i->position = position;
+   d->layout(*i);
+}
+
+
+void
+QStereoTextRenderer::setColor(const int& id, const QColor& color)
+{
+   Q_D(QStereoTextRenderer);
+   auto i = d->texts.find(id);
+   if (i == d->texts.end() || i->color == color)
+      return;
+
+   i->color = color;
+   d->layout(*i);
+}
+
+
+void
+QStereoTextRenderer::removeText(const int& id)
+{
+   Q_D(QStereoTextRenderer);
+   if (d->texts.remove(id) > 0)
+   {
+      // The removed string's glyphs stay cached, but the atlas may be rebuilt without them once it fills up.
+      d->batchChanged = true;
+      d->atlasFull = false;
+   }
+}
+
+
+void
+QStereoTextRenderer::clear()
+{
+   Q_D(QStereoTextRenderer);
+   d->texts.clear();
+   d->batchChanged = true;
+   d->atlasFull = false;
+}
+
+
+QRectF
+QStereoTextRenderer::boundingRect(const int& id) const
+{
+   Q_D(const QStereoTextRenderer);
+   const auto& i = d->texts.constFind(id);
+   if (i == d->texts.constEnd() || i->vertices.isEmpty())
+      return QRectF();
+
+   // The bounds cover the quads the string was laid out into, padding included.
+   const auto& first = i->vertices.first();
+   auto left = first.x, top = first.y, right = first.x, bottom = first.y;
+   for (const auto& vertex : i->vertices)
+   {
+      left = qMin(left, vertex.x);
+      top = qMin(top, vertex.y);
+      right = qMax(right, vertex.x);
+      bottom = qMax(bottom, vertex.y);
+   }
+   return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+
+const QImage&
+QStereoTextRenderer::atlas() const
+{
+   Q_D(const QStereoTextRenderer);
+   return d->atlas;
+}
+
+
+int
+QStereoTextRenderer::glyphCount() const
+{
+   Q_D(const QStereoTextRenderer);
+   return d->glyphs.size();
+}
+
+
+void
+QStereoTextRenderer::render(const QStereoEyeParameters& parameters)
+{
+   Q_D(QStereoTextRenderer);
+   QSTEREO_TRACE_ZONE("QStereoTextRenderer::render");
+   if (!d->initialized)
+   {
+      initializeOpenGLFunctions();
+      d->initialized = d->createProgram() && d->vertexBuffer.create();
+      if (!d->initialized)
+         return;
+   }
+
+   // The atlas and the vertex buffer are only uploaded when they've changed, which is at most once per
+   // frame since both eyes share them. Unchanged strings keep the vertices they were laid out with.
+   if (d->atlasChanged)
+   {
+      d->texture.reset(new QOpenGLTexture(d->atlas, QOpenGLTexture::DontGenerateMipMaps));
+      d->texture->setMinMagFilters(QOpenGLTexture::Linear, QOpenGLTexture::Linear);
+      d->texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+      d->atlasChanged = false;
+   }
+   if (d->batchChanged)
+   {
+      d->batch.clear();
+      for (const auto& text : d->texts)
+         d->batch += text.vertices;
+
+      const auto& size = static_cast<int>(d->batch.size() * sizeof(QStereoTextRendererPrivate::Vertex));
+      d->vertexBuffer.bind();
+      if (size > d->vertexBuffer.size())
+         d->vertexBuffer.allocate(d->batch.constData(), size);
+      else if (size > 0)
+         d->vertexBuffer.write(0, d->batch.constData(), size);
+      d->vertexBuffer.release();
+      d->batchChanged = false;
+   }
+   if (d->batch.isEmpty())
+      return;
+
+   const auto& depthTest = glIsEnabled(GL_DEPTH_TEST);
+   const auto& blend = glIsEnabled(GL_BLEND);
+   GLint blendFunc[4];
+   glGetIntegerv(GL_BLEND_SRC_RGB, &blendFunc[0]);
+   glGetIntegerv(GL_BLEND_DST_RGB, &blendFunc[1]);
+   glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendFunc[2]);
+   glGetIntegerv(GL_BLEND_DST_ALPHA, &blendFunc[3]);
+
+   glDisable(GL_DEPTH_TEST);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+   const auto& stride = static_cast<int>(sizeof(QStereoTextRendererPrivate::Vertex));
+   d->program->bind();
+   d->program->setUniformValue("transform", parameters.ortho());
+   d->program->setUniformValue("atlas", 0);
+   d->texture->bind(0);
+   d->vertexBuffer.bind();
+   d->program->enableAttributeArray(0);
+   d->program->enableAttributeArray(1);
+   d->program->enableAttributeArray(2);
+   d->program->setAttributeBuffer(0, GL_FLOAT, offsetof(QStereoTextRendererPrivate::Vertex, x), 2, stride);
+   d->program->setAttributeBuffer(1, GL_FLOAT, offsetof(QStereoTextRendererPrivate::Vertex, s), 2, stride);
+   d->program->setAttributeBuffer(2, GL_FLOAT, offsetof(QStereoTextRendererPrivate::Vertex, r), 4, stride);
+   glDrawArrays(GL_TRIANGLES, 0, d->batch.size());
+   d->program->disableAttributeArray(2);
+   d->program->disableAttributeArray(1);
+   d->program->disableAttributeArray(0);
+   d->vertexBuffer.release();
+   d->texture->release(0);
+   d->program->release();
+
+   glBlendFuncSeparate(blendFunc[0], blendFunc[1], blendFunc[2], blendFunc[3]);
+   if (!blend)
+      glDisable(GL_BLEND);
+   if (depthTest)
+      glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,70 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOTEXTRENDERER_H
+#define QSTEREOTEXTRENDERER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QPointF>
+#include <QtCore/QRectF>
+#include <QtCore/QString>
+#include <QtGui/QColor>
+#include <QtGui/QFont>
+#include <QtGui/QImage>
+#include <QtGui/QOpenGLFunctions>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoEyeParameters;
+class QStereoTextRendererPrivate;
+class QStereoTextRenderer : public QObject, protected QOpenGLFunctions
+{
+public:
+   explicit QStereoTextRenderer(const QFont& font = QFont(), QObject* const parent = nullptr);
+
+   const QFont& font() const;
+   void setFont(const QFont& font);
+
+   int addText(const QString& text, const QPointF& position, const QColor& color = QColor(Qt::white));
+   void setText(const int& id, const QString& text);
+   void setPosition(const int& id, const QPointF& position);
+   void setColor(const int& id, const QColor& color);
+   void removeText(const int& id);
+   void clear();
+   QRectF boundingRect(const int& id) const;
+
+   const QImage& atlas() const;
+   int glyphCount() const;
+
+   void render(const QStereoEyeParameters& parameters);
+
+   static Q_DECL_CONSTEXPR int atlasSize(){ return 1024; }
+private:
+   QStereoTextRendererPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoTextRenderer);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOTEXTRENDERER_H
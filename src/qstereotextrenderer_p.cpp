@@ -0,0 +1,244 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereotextrenderer_p.h"
+#include <QtGui/QFontMetricsF>
+#include <QtGui/QPainter>
+#include <cmath>
+
+
+QStereoTextRendererPrivate::QStereoTextRendererPrivate(QStereoTextRenderer* const parent, const QFont& font) :
+QObject(parent),
+font(font),
+atlasRowHeight(0),
+atlasChanged(true),
+atlasFull(false),
+nextId(0),
+batchChanged(true),
+texture(nullptr),
+vertexBuffer(QOpenGLBuffer::VertexBuffer),
+program(nullptr),
+initialized(false)
+{
+   vertexBuffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+   resetAtlas();
+}
+
+
+void
+QStereoTextRendererPrivate::resetAtlas()
+{
+   const auto& size = QStereoTextRenderer::atlasSize();
+   atlas = QImage(size, size, QImage::Format_RGBA8888_Premultiplied);
+   atlas.fill(Qt::transparent);
+   atlasCursor = QPoint(0, 0);
+   atlasRowHeight = 0;
+   atlasChanged = true;
+   glyphs.clear();
+}
+
+
+void
+QStereoTextRendererPrivate::rebuildAtlas(const Text& text)
+{
+   // Glyphs are never evicted one by one. Instead, a full atlas is redrawn with only the glyphs of the
+   // strings that are still in use, starting with the string being laid out, and every other string is
+   // then laid out again with its new cells.
+   resetAtlas();
+   auto cached = cacheGlyphs(text.codePoints);
+   for (const auto& t : texts)
+      cached = cacheGlyphs(t.codePoints) && cached;
+   if (!cached)
+   {
+      qWarning("[QtStereoscopy] Warning: The glyph atlas cannot hold every glyph in use. Some glyphs will not be drawn.");
+      atlasFull = true;
+   }
+   for (auto& t : texts)
+   {
+      if (&t != &text)
+         buildVertices(t);
+   }
+}
+
+
+const QStereoTextRendererPrivate::Glyph*
+QStereoTextRendererPrivate::glyph(const uint& codePoint)
+{
+   const auto& i = glyphs.constFind(codePoint);
+   if (i != glyphs.constEnd())
+      return &i.value();
+
+   // Each glyph is drawn once into a cell that fits its bounding rectangle, which may extend past its
+   // advance, with a pixel of padding on every side so that linear filtering never picks up a neighbouring
+   // glyph. Cells are packed into rows from left to right. Glyphs that draw nothing only need an advance.
+   const QFontMetricsF metrics(font);
+   const auto& string = QString::fromUcs4(&codePoint, 1);
+   const auto& bounds = QChar::requiresSurrogates(codePoint) ? metrics.boundingRect(string) : metrics.boundingRect(QChar(codePoint));
+   Glyph glyph;
+   glyph.advance = metrics.width(string);
+   if (!QChar::isSpace(codePoint) && !bounds.isEmpty())
+   {
+      const auto& left = std::floor(bounds.left());
+      const auto& top = std::floor(bounds.top());
+      const auto& w = static_cast<int>(std::ceil(bounds.right()) - left) + 2;
+      const auto& h = static_cast<int>(std::ceil(bounds.bottom()) - top) + 2;
+      if (atlasCursor.x() + w > atlas.width())
+         atlasCursor = QPoint(0, atlasCursor.y() + atlasRowHeight);
+      if (atlasCursor.y() + h > atlas.height())
+         return nullptr;
+
+      const QRect cell(atlasCursor, QSize(w, h));
+      QPainter painter(&atlas);
+      painter.setFont(font);
+      painter.setPen(Qt::white);
+      painter.drawText(QPointF(cell.x() + 1 - left, cell.y() + 1 - top), string);
+      atlasCursor.rx() += w;
+      atlasRowHeight = qMax(atlasRowHeight, h);
+      atlasChanged = true;
+
+      // The cell is stored relative to the pen position on the baseline, where y increases downwards.
+      const auto& size = static_cast<qreal>(atlas.width());
+      glyph.cell = QRectF(left - 1.0, top - 1.0, w, h);
+      glyph.texCoords = QRectF(cell.x() / size, cell.y() / size, w / size, h / size);
+   }
+   return &glyphs.insert(codePoint, glyph).value();
+}
+
+
+bool
+QStereoTextRendererPrivate::cacheGlyphs(const QVector<uint>& codePoints)
+{
+   auto cached = true;
+   for (const auto& codePoint : codePoints)
+   {
+      if (codePoint != '\n' && glyph(codePoint) == nullptr)
+         cached = false;
+   }
+   return cached;
+}
+
+
+void
+QStereoTextRendererPrivate::layout(Text& text)
+{
+   // Strings are laid out per code point, so that characters outside the Basic Multilingual Plane are a
+   // single glyph rather than two surrogates.
+   text.codePoints = text.string.toUcs4();
+   if (!cacheGlyphs(text.codePoints) && !atlasFull)
+      rebuildAtlas(text);
+
+   buildVertices(text);
+}
+
+
+void
+QStereoTextRendererPrivate::buildVertices(Text& text)
+{
+   text.vertices.clear();
+   text.vertices.reserve(6 * text.codePoints.size());
+
+   const auto& r = static_cast<GLfloat>(text.color.redF());
+   const auto& g = static_cast<GLfloat>(text.color.greenF());
+   const auto& b = static_cast<GLfloat>(text.color.blueF());
+   const auto& a = static_cast<GLfloat>(text.color.alphaF());
+   const auto& lineSpacing = QFontMetricsF(font).lineSpacing();
+
+   auto pen = text.position;
+   for (const auto& codePoint : text.codePoints)
+   {
+      if (codePoint == '\n')
+      {
+         pen = QPointF(text.position.x(), pen.y() + lineSpacing);
+         continue;
+      }
+
+      // Glyphs that did not fit into the atlas are skipped.
+      const auto& i = glyphs.constFind(codePoint);
+      if (i == glyphs.constEnd())
+         continue;
+
+      const auto& glyph = i.value();
+      if (!glyph.cell.isEmpty())
+      {
+         const auto& cell = glyph.cell.translated(pen);
+         const auto& uv = glyph.texCoords;
+         const auto x0 = static_cast<GLfloat>(cell.left()),   y0 = static_cast<GLfloat>(cell.top());
+         const auto x1 = static_cast<GLfloat>(cell.right()),  y1 = static_cast<GLfloat>(cell.bottom());
+         const auto s0 = static_cast<GLfloat>(uv.left()),     t0 = static_cast<GLfloat>(uv.top());
+         const auto s1 = static_cast<GLfloat>(uv.right()),    t1 = static_cast<GLfloat>(uv.bottom());
+
+         // Two triangles per glyph, so that every string in the batch is drawn with a single call.
+         text.vertices.append({x0, y0, s0, t0, r, g, b, a});
+         text.vertices.append({x0, y1, s0, t1, r, g, b, a});
+         text.vertices.append({x1, y0, s1, t0, r, g, b, a});
+         text.vertices.append({x1, y0, s1, t0, r, g, b, a});
+         text.vertices.append({x0, y1, s0, t1, r, g, b, a});
+         text.vertices.append({x1, y1, s1, t1, r, g, b, a});
+      }
+      pen.rx() += glyph.advance;
+   }
+   batchChanged = true;
+}
+
+
+bool
+QStereoTextRendererPrivate::createProgram()
+{
+   static const char* const vertexShader =
+      "#version 120\n"
+      "attribute vec2 vertex;\n"
+      "attribute vec2 texCoord;\n"
+      "attribute vec4 color;\n"
+      "uniform mat4 transform;\n"
+      "varying vec2 glyphCoord;\n"
+      "varying vec4 glyphColor;\n"
+      "void main()\n"
+      "{\n"
+      "   glyphCoord = texCoord;\n"
+      "   glyphColor = vec4(color.rgb * color.a, color.a);\n"
+      "   gl_Position = transform * vec4(vertex, 0.0, 1.0);\n"
+      "}\n";
+   static const char* const fragmentShader =
+      "#version 120\n"
+      "uniform sampler2D atlas;\n"
+      "varying vec2 glyphCoord;\n"
+      "varying vec4 glyphColor;\n"
+      "void main()\n"
+      "{\n"
+      "   gl_FragColor = glyphColor * texture2D(atlas, glyphCoord).a;\n"
+      "}\n";
+
+   program.reset(new QOpenGLShaderProgram);
+   program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShader);
+   program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShader);
+   program->bindAttributeLocation("vertex", 0);
+   program->bindAttributeLocation("texCoord", 1);
+   program->bindAttributeLocation("color", 2);
+   if (!program->link())
+   {
+      qWarning("[QtStereoscopy] Warning: Could not link the text renderer's shader program.");
+      program.reset();
+      return false;
+   }
+   return true;
+}
@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOTEXTRENDERER_P_H
+#define QSTEREOTEXTRENDERER_P_H
+
+#include "qstereotextrenderer.h"
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QRectF>
+#include <QtCore/QVector>
+#include <QtGui/QOpenGLBuffer>
+#include <QtGui/QOpenGLShaderProgram>
+#include <QtGui/QOpenGLTexture>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoTextRendererPrivate : public QObject
+{
+public:
+   struct Vertex
+   {
+      GLfloat x, y;
+      GLfloat s, t;
+      GLfloat r, g, b, a;
+   };
+   struct Glyph
+   {
+      QRectF cell;
+      QRectF texCoords;
+      qreal advance;
+   };
+   struct Text
+   {
+      QString string;
+      QPointF position;
+      QColor color;
+      QVector<uint> codePoints;
+      QVector<Vertex> vertices;
+   };
+
+   QStereoTextRendererPrivate(QStereoTextRenderer* const parent, const QFont& font);
+
+   void resetAtlas();
+   void rebuildAtlas(const Text& text);
+   const Glyph* glyph(const uint& codePoint);
+   bool cacheGlyphs(const QVector<uint>& codePoints);
+   void layout(Text& text);
+   void buildVertices(Text& text);
+   bool createProgram();
+
+   QFont font;
+   QImage atlas;
+   QPoint atlasCursor;
+   int atlasRowHeight;
+   bool atlasChanged;
+   bool atlasFull;
+   QHash<uint, Glyph> glyphs;
+
+   QMap<int, Text> texts;
+   int nextId;
+
+   QVector<Vertex> batch;
+   bool batchChanged;
+
+   QScopedPointer<QOpenGLTexture> texture;
+   QOpenGLBuffer vertexBuffer;
+   QScopedPointer<QOpenGLShaderProgram> program;
+   bool initialized;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOTEXTRENDERER_P_H
@@ -0,0 +1,121 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereotrace.h"
+#include "qstereotrace_p.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QMutexLocker>
+
+
+void
+QStereoTrace::setThreadName(const QString& name)
+{
+   auto& buffer = QStereoTracePrivate::threadBuffer();
+   auto& d = QStereoTracePrivate::instance();
+
+   QMutexLocker locker(&d.mutex);
+   buffer.threadName = name.toUtf8();
+}
+
+
+QByteArray
+QStereoTrace::toJson()
+{
+   auto& d = QStereoTracePrivate::instance();
+   QMutexLocker locker(&d.mutex);
+
+   // Write each zone as a complete event in the Chrome trace event format, which can be loaded
+   // by chrome://tracing as well as the Perfetto UI. Times are given in microseconds.
+   const auto& escape = [](QByteArray name)
+   {
+      return name.replace('\\', "\\\\").replace('"', "\\\"");
+   };
+
+   QByteArray json("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+   bool first = true;
+   for (const auto* const buffer : d.buffers)
+   {
+      const auto& tid = QByteArray::number(buffer->threadId);
+
+      json += first ? "" : ",";
+      json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid;
+      json += ",\"args\":{\"name\":\"" + escape(buffer->threadName) + "\"}}";
+      first = false;
+
+      for (const auto& event : buffer->events())
+      {
+         json += ",{\"name\":\"" + escape(QByteArray(event.name)) + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid;
+         json += ",\"ts\":" + QByteArray::number(1e-3 * (event.begin - d.origin), 'f', 3);
+         json += ",\"dur\":" + QByteArray::number(1e-3 * (event.end - event.begin), 'f', 3) + "}";
+      }
+   }
+   json += "]}";
+   return json;
+}
+
+
+bool
+QStereoTrace::save(const QString& fileName)
+{
+   QFile file(fileName);
+   if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(toJson()) < 0)
+   {
+      qWarning("[QtStereoscopy] Warning: Could not save the trace to '%s'.", qPrintable(fileName));
+      return false;
+   }
+   return true;
+}
+
+
+void
+QStereoTrace::saveOnExit(const QString& fileName)
+{
+   auto& d = QStereoTracePrivate::instance();
+   QMutexLocker locker(&d.mutex);
+
+   d.exitFileName = fileName;
+   if (!d.saveOnExitRegistered)
+   {
+      qAddPostRoutine(&QStereoTracePrivate::saveOnExit);
+      d.saveOnExitRegistered = true;
+   }
+}
+
+
+void
+QStereoTrace::clear()
+{
+   auto& d = QStereoTracePrivate::instance();
+   QMutexLocker locker(&d.mutex);
+
+   for (auto* const buffer : d.buffers)
+      buffer->clear();
+}
+
+
+void
+QStereoTrace::record(const char* const name, const qint64& begin, const qint64& end)
+{
+   QStereoTracePrivate::threadBuffer().append(name, begin, end);
+}
@@ -0,0 +1,98 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOTRACE_H
+#define QSTEREOTRACE_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <chrono>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoTrace
+{
+public:
+   class Zone
+   {
+   public:
+      explicit Zone(const char* const name);
+      ~Zone();
+   private:
+      explicit Zone(const Zone&) = delete;
+      Zone& operator=(const Zone&) = delete;
+
+      const char* const name_;
+      const qint64 begin_;
+   };
+
+   static void setThreadName(const QString& name);
+
+   static QByteArray toJson();
+   static bool save(const QString& fileName);
+   static void saveOnExit(const QString& fileName);
+   static void clear();
+
+   static qint64 now();
+   static void record(const char* const name, const qint64& begin, const qint64& end);
+
+   static Q_DECL_CONSTEXPR unsigned int eventsPerThread(){ return 65536; }
+private:
+   QStereoTrace() = delete;
+};
+
+
+inline
+QStereoTrace::Zone::Zone(const char* const name) :
+name_(name),
+begin_(QStereoTrace::now())
+{}
+
+
+inline
+QStereoTrace::Zone::~Zone()
+{
+   QStereoTrace::record(name_, begin_, QStereoTrace::now());
+}
+
+
+inline qint64
+QStereoTrace::now()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+QT_END_NAMESPACE
+
+#define QSTEREO_TRACE_CONCAT_(a, b) a##b
+#define QSTEREO_TRACE_CONCAT(a, b) QSTEREO_TRACE_CONCAT_(a, b)
+
+// Trace zones are only compiled in when QTSTEREOSCOPY_TRACE is defined. Otherwise, they cost nothing.
+#if defined(QTSTEREOSCOPY_TRACE)
+#define QSTEREO_TRACE_ZONE(name) const QStereoTrace::Zone QSTEREO_TRACE_CONCAT(qstereoTraceZone, __LINE__)(name)
+#else
+#define QSTEREO_TRACE_ZONE(name) static_cast<void>(0)
+#endif
+
+#endif // QSTEREOTRACE_H
@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereotrace_p.h"
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+#include <algorithm>
+
+
+QStereoTraceBuffer::QStereoTraceBuffer(const unsigned int& id, const QByteArray& name) :
+head(0),
+tail(0),
+threadId(id),
+threadName(name)
+{}
+
+
+void
+QStereoTraceBuffer::append(const char* const name, const qint64& begin, const qint64& end)
+{
+   const auto& i = head.load(std::memory_order_relaxed);
+   buffer[i % buffer.size()] = {name, begin, end};
+   head.store(i + 1, std::memory_order_release);
+}
+
+
+QVector<QStereoTraceBuffer::Event>
+QStereoTraceBuffer::events() const
+{
+   // When the buffer is full, the oldest events are overwritten.
+   const auto& size = static_cast<quint64>(buffer.size());
+   const auto& h = head.load(std::memory_order_acquire);
+   const auto& t = std::max(tail.load(std::memory_order_acquire), h > size ? h - size : 0);
+
+   QVector<Event> events;
+   events.reserve(static_cast<int>(h - t));
+   for (auto i = t; i < h; ++i)
+      events.append(buffer[i % size]);
+
+   // The writer may have wrapped around while the events were being copied, in which case the
+   // oldest copies could be torn and are discarded.
+   const auto& overwritten = head.load(std::memory_order_acquire);
+   if (overwritten > t + size)
+      events.remove(0, std::min(static_cast<int>(overwritten - size - t), events.size()));
+
+   return events;
+}
+
+
+void
+QStereoTraceBuffer::clear()
+{
+   tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+
+QStereoTracePrivate::QStereoTracePrivate() :
+origin(QStereoTrace::now()),
+saveOnExitRegistered(false)
+{}
+
+
+QStereoTracePrivate::~QStereoTracePrivate()
+{
+   qDeleteAll(buffers);
+}
+
+
+QStereoTracePrivate&
+QStereoTracePrivate::instance()
+{
+   static QStereoTracePrivate instance;
+   return instance;
+}
+
+
+QStereoTraceBuffer&
+QStereoTracePrivate::threadBuffer()
+{
+   // Each thread is given its own buffer the first time it records an event. Buffers are never
+   // released before the process exits so that a trace may still be saved after a thread ends.
+   static thread_local QStereoTraceBuffer* buffer = nullptr;
+   if (Q_UNLIKELY(buffer == nullptr))
+   {
+      auto& d = instance();
+      QMutexLocker locker(&d.mutex);
+
+      const auto& id = static_cast<unsigned int>(d.buffers.size()) + 1;
+      const auto& threadName = QThread::currentThread()->objectName();
+      const auto& name = threadName.isEmpty() ? QByteArray("Thread ") + QByteArray::number(id) : threadName.toUtf8();
+
+      buffer = new QStereoTraceBuffer(id, name);
+      d.buffers.append(buffer);
+   }
+   return *buffer;
+}
+
+
+void
+QStereoTracePrivate::saveOnExit()
+{
+   auto& d = instance();
+
+   QString fileName;
+   {
+      QMutexLocker locker(&d.mutex);
+      fileName = d.exitFileName;
+   }
+   if (!fileName.isEmpty())
+      QStereoTrace::save(fileName);
+}
@@ -0,0 +1,83 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOTRACE_P_H
+#define QSTEREOTRACE_P_H
+
+#include "qstereotrace.h"
+#include <QtCore/QMutex>
+#include <QtCore/QVector>
+#include <array>
+#include <atomic>
+
+
+QT_BEGIN_NAMESPACE
+
+struct QStereoTraceBuffer
+{
+public:
+   struct Event
+   {
+      const char* name;
+      qint64 begin;
+      qint64 end;
+   };
+
+   QStereoTraceBuffer(const unsigned int& threadId, const QByteArray& threadName);
+
+   void append(const char* const name, const qint64& begin, const qint64& end);
+   QVector<Event> events() const;
+   void clear();
+
+   // Only the thread that owns the buffer writes to it, so appending an event requires no lock.
+   // The head counts every event ever written while the tail marks where the buffer was last
+   // cleared, which lets other threads read or clear the buffer without stalling the writer.
+   std::array<Event, QStereoTrace::eventsPerThread()> buffer;
+   std::atomic<quint64> head;
+   std::atomic<quint64> tail;
+
+   const unsigned int threadId;
+   QByteArray threadName;
+};
+
+
+struct QStereoTracePrivate
+{
+public:
+   static QStereoTracePrivate& instance();
+   static QStereoTraceBuffer& threadBuffer();
+   static void saveOnExit();
+
+   QMutex mutex;
+   QVector<QStereoTraceBuffer*> buffers;
+   qint64 origin;
+   QString exitFileName;
+   bool saveOnExitRegistered;
+private:
+   QStereoTracePrivate();
+   ~QStereoTracePrivate();
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOTRACE_P_H
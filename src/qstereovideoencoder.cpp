@@ -0,0 +1,168 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereovideoencoder_p.h"
+#include <algorithm>
+
+
+QStereoVideoEncoder::QStereoVideoEncoder(const QString& fileName, QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoVideoEncoderPrivate(this, fileName))
+{}
+
+
+QStereoVideoEncoder::~QStereoVideoEncoder()
+{
+   close();
+}
+
+
+const QString&
+QStereoVideoEncoder::fileName() const
+{
+   Q_D(const QStereoVideoEncoder);
+   return d->fileName;
+}
+
+
+const unsigned int&
+QStereoVideoEncoder::frameRate() const
+{
+   Q_D(const QStereoVideoEncoder);
+   return d->frameRate;
+}
+
+
+void
+QStereoVideoEncoder::setFrameRate(const unsigned int& rate)
+{
+   if (isOpen())
+      qWarning("[QtStereoscopy] Warning: The frame rate cannot be changed while the encoder is open.");
+   else
+   {
+      Q_D(QStereoVideoEncoder);
+      d->frameRate = std::max(rate, 1u);
+   }
+}
+
+
+const unsigned int&
+QStereoVideoEncoder::queueCapacity() const
+{
+   Q_D(const QStereoVideoEncoder);
+   return d->queueCapacity;
+}
+
+
+void
+QStereoVideoEncoder::setQueueCapacity(const unsigned int& capacity)
+{
+   Q_D(QStereoVideoEncoder);
+   d->queueCapacity = std::max(capacity, 1u);
+}
+
+
+int
+QStereoVideoEncoder::workerCount() const
+{
+   Q_D(const QStereoVideoEncoder);
+   return d->workers.maxThreadCount();
+}
+
+
+void
+QStereoVideoEncoder::setWorkerCount(const int& count)
+{
+   Q_D(QStereoVideoEncoder);
+   d->workers.setMaxThreadCount(std::max(count, 1));
+}
+
+
+bool
+QStereoVideoEncoder::open()
+{
+   Q_D(QStereoVideoEncoder);
+   return d->open();
+}
+
+
+void
+QStereoVideoEncoder::close()
+{
+   Q_D(QStereoVideoEncoder);
+   d->close();
+}
+
+
+bool
+QStereoVideoEncoder::isOpen() const
+{
+   Q_D(const QStereoVideoEncoder);
+   return d->isOpen();
+}
+
+
+bool
+QStereoVideoEncoder::isFull() const
+{
+   Q_D(const QStereoVideoEncoder);
+   return d->framesInFlight.load() >= d->queueCapacity;
+}
+
+
+bool
+QStereoVideoEncoder::submit(const QStereoFrameCapture::Frame& frame)
+{
+   Q_D(QStereoVideoEncoder);
+   return d->submit(frame);
+}
+
+
+quint64
+QStereoVideoEncoder::encodedFrameCount() const
+{
+   Q_D(const QStereoVideoEncoder);
+   return d->encodedFrameCount.load();
+}
+
+
+quint64
+QStereoVideoEncoder::droppedFrameCount() const
+{
+   Q_D(const QStereoVideoEncoder);
+   return d->droppedFrameCount.load();
+}
+
+
+QByteArray
+QStereoVideoEncoder::streamHeader(const QSize& size, const unsigned int& frameRate)
+{
+   return QStereoVideoEncoderPrivate::streamHeader(size, frameRate);
+}
+
+
+void
+QStereoVideoEncoder::convertToI420(const QStereoFrameCapture::Frame& frame, const QSize& size, uchar* const output)
+{
+   QStereoVideoEncoderPrivate::convertToI420(frame, size, output);
+}
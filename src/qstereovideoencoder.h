@@ -0,0 +1,71 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOVIDEOENCODER_H
+#define QSTEREOVIDEOENCODER_H
+
+#include "qstereoframecapture.h"
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoVideoEncoderPrivate;
+class QStereoVideoEncoder : public QObject
+{
+public:
+   explicit QStereoVideoEncoder(const QString& fileName, QObject* const parent = nullptr);
+   ~QStereoVideoEncoder();
+
+   const QString& fileName() const;
+
+   const unsigned int& frameRate() const;
+   void setFrameRate(const unsigned int& rate);
+
+   const unsigned int& queueCapacity() const;
+   void setQueueCapacity(const unsigned int& capacity);
+
+   int workerCount() const;
+   void setWorkerCount(const int& count);
+
+   bool open();
+   void close();
+   bool isOpen() const;
+
+   bool isFull() const;
+   bool submit(const QStereoFrameCapture::Frame& frame);
+
+   quint64 encodedFrameCount() const;
+   quint64 droppedFrameCount() const;
+
+   static QByteArray streamHeader(const QSize& size, const unsigned int& frameRate);
+   static void convertToI420(const QStereoFrameCapture::Frame& frame, const QSize& size, uchar* const output);
+private:
+   QStereoVideoEncoderPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoVideoEncoder);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOVIDEOENCODER_H
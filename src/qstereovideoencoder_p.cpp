@@ -0,0 +1,353 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereovideoencoder_p.h"
+#include <QtCore/QMutexLocker>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+class EncodingJob : public QRunnable
+{
+public:
+   EncodingJob(QStereoVideoEncoderPrivate& encoder, const quint64& sequence, const QStereoFrameCapture::Frame& frame) :
+   encoder_(encoder),
+   sequence_(sequence),
+   frame_(frame)
+   {}
+
+   void run() Q_DECL_OVERRIDE
+   {
+      encoder_.encode(sequence_, frame_);
+   }
+private:
+   QStereoVideoEncoderPrivate& encoder_;
+   const quint64 sequence_;
+   const QStereoFrameCapture::Frame frame_;
+};
+
+
+// BT.601 limited-range conversion in 8-bit fixed point.
+inline uchar
+luma(const uchar* const p)
+{
+   return static_cast<uchar>(((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+}
+
+
+inline uchar
+chromaBlue(const int& r, const int& g, const int& b)
+{
+   return static_cast<uchar>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+
+inline uchar
+chromaRed(const int& r, const int& g, const int& b)
+{
+   return static_cast<uchar>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+
+void
+lumaRow(const uchar* const rgba, uchar* const y, const int& width)
+{
+   int x = 0;
+#if defined(__SSE2__)
+   // Convert four RGBA pixels per iteration: widen the channels to 16 bits, multiply-add them
+   // against the luma coefficients, then fold each pixel's two partial sums together.
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i coefficients = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+   const __m128i rounding = _mm_set1_epi32(128);
+   const __m128i offset = _mm_set1_epi32(16);
+   for (; x + 4 <= width; x += 4)
+   {
+      const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + (x << 2)));
+      __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), coefficients);
+      __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), coefficients);
+      lo = _mm_add_epi32(lo, _mm_srli_epi64(lo, 32));
+      hi = _mm_add_epi32(hi, _mm_srli_epi64(hi, 32));
+      lo = _mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 3, 2, 0));
+      hi = _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 3, 2, 0));
+
+      __m128i values = _mm_unpacklo_epi64(lo, hi);
+      values = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(values, rounding), 8), offset);
+      values = _mm_packs_epi32(values, values);
+      values = _mm_packus_epi16(values, values);
+
+      const int packed = _mm_cvtsi128_si32(values);
+      std::memcpy(y + x, &packed, sizeof(packed));
+   }
+#endif
+   for (; x < width; ++x)
+      y[x] = luma(rgba + (x << 2));
+}
+
+
+#if defined(__SSE2__)
+// Returns the rounded averages of the two 2x2 blocks covered by four pixels of each row, as 16-bit RGBA.
+inline __m128i
+blockAverages(const uchar* const top, const uchar* const bottom)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top));
+   const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom));
+
+   // Add the rows, then each block's two columns.
+   const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+   const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+   const __m128i sums = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+
+   return _mm_srli_epi16(_mm_add_epi16(sums, _mm_set1_epi16(2)), 2);
+}
+
+
+// Returns the chroma of two blocks in the first two 32-bit lanes, before rounding and offset.
+inline __m128i
+chromaSums(const __m128i& blocks, const __m128i& coefficients)
+{
+   __m128i sums = _mm_madd_epi16(blocks, coefficients);
+   sums = _mm_add_epi32(sums, _mm_srli_epi64(sums, 32));
+   return _mm_shuffle_epi32(sums, _MM_SHUFFLE(3, 3, 2, 0));
+}
+
+
+inline void
+storeChroma(const __m128i& lo, const __m128i& hi, uchar* const output)
+{
+   __m128i values = _mm_unpacklo_epi64(lo, hi);
+   values = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(values, _mm_set1_epi32(128)), 8), _mm_set1_epi32(128));
+   values = _mm_packs_epi32(values, values);
+   values = _mm_packus_epi16(values, values);
+
+   const int packed = _mm_cvtsi128_si32(values);
+   std::memcpy(output, &packed, sizeof(packed));
+}
+#endif
+
+
+void
+chromaRow(const uchar* const top, const uchar* const bottom, uchar* const u, uchar* const v, const int& width)
+{
+   int x = 0;
+#if defined(__SSE2__)
+   // Convert four 2x2 blocks per iteration. The averaged blocks are reused for both chroma planes.
+   const __m128i blue = _mm_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0);
+   const __m128i red = _mm_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0);
+   for (; x + 8 <= width; x += 8)
+   {
+      const __m128i lo = blockAverages(top + (x << 2), bottom + (x << 2));
+      const __m128i hi = blockAverages(top + ((x + 4) << 2), bottom + ((x + 4) << 2));
+
+      storeChroma(chromaSums(lo, blue), chromaSums(hi, blue), u + (x >> 1));
+      storeChroma(chromaSums(lo, red), chromaSums(hi, red), v + (x >> 1));
+   }
+#endif
+   for (; x < width; x += 2)
+   {
+      const uchar* const a = top + (x << 2);
+      const uchar* const b = bottom + (x << 2);
+      const int r = (a[0] + a[4] + b[0] + b[4] + 2) >> 2;
+      const int g = (a[1] + a[5] + b[1] + b[5] + 2) >> 2;
+      const int bl = (a[2] + a[6] + b[2] + b[6] + 2) >> 2;
+
+      u[x >> 1] = chromaBlue(r, g, bl);
+      v[x >> 1] = chromaRed(r, g, bl);
+   }
+}
+} // namespace
+
+
+QStereoVideoEncoderPrivate::QStereoVideoEncoderPrivate(QStereoVideoEncoder* const parent, const QString& file) :
+QObject(parent),
+fileName(file),
+frameRate(75),
+queueCapacity(4),
+framesInFlight(0),
+encodedFrameCount(0),
+droppedFrameCount(0),
+nextSequence_(0),
+nextWrite_(0),
+headerWritten_(false)
+{
+   output_.setFileName(fileName);
+   workers.setMaxThreadCount(std::max(QThread::idealThreadCount() / 2, 1));
+}
+
+
+bool
+QStereoVideoEncoderPrivate::open()
+{
+   QMutexLocker lock(&outputMutex_);
+   if (output_.isOpen())
+      return true;
+
+   // A dash is the conventional name for the standard output, which allows the stream to be piped
+   // into an external encoder.
+   const bool opened = fileName == QLatin1String("-") ?
+   output_.open(stdout, QIODevice::WriteOnly | QIODevice::Unbuffered) :
+   output_.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+   if (!opened)
+   {
+      qCritical("[QtStereoscopy] Error: Could not open '%s' for writing.", qPrintable(fileName));
+      return false;
+   }
+
+   frameSize_ = QSize();
+   encodedFrames_.clear();
+   nextSequence_ = 0;
+   nextWrite_ = 0;
+   headerWritten_ = false;
+   return true;
+}
+
+
+void
+QStereoVideoEncoderPrivate::close()
+{
+   workers.waitForDone();
+
+   QMutexLocker lock(&outputMutex_);
+   if (output_.isOpen())
+   {
+      output_.flush();
+      output_.close();
+   }
+}
+
+
+bool
+QStereoVideoEncoderPrivate::isOpen() const
+{
+   QMutexLocker lock(&outputMutex_);
+   return output_.isOpen();
+}
+
+
+bool
+QStereoVideoEncoderPrivate::submit(const QStereoFrameCapture::Frame& frame)
+{
+   // Back-pressure is handled by dropping frames: the render thread must never wait on the encoder.
+   if (!isOpen() || framesInFlight.load() >= queueCapacity)
+   {
+      ++droppedFrameCount;
+      return false;
+   }
+
+   // The stream's resolution is fixed by the first frame. 4:2:0 subsampling requires even dimensions.
+   const auto& size = QSize(frame.size.width() & ~1, frame.size.height() & ~1);
+   if (!frameSize_.isValid())
+      frameSize_ = size;
+   else if (frameSize_ != size)
+   {
+      ++droppedFrameCount;
+      return false;
+   }
+
+   ++framesInFlight;
+   workers.start(new EncodingJob(*this, nextSequence_++, frame));
+   return true;
+}
+
+
+void
+QStereoVideoEncoderPrivate::encode(const quint64& sequence, const QStereoFrameCapture::Frame& frame)
+{
+   const auto& planeSize = frameSize_.width() * frameSize_.height();
+
+   QByteArray encoded(planeSize + (planeSize >> 1), Qt::Uninitialized);
+   convertToI420(frame, frameSize_, reinterpret_cast<uchar*>(encoded.data()));
+
+   // Frames may complete out of order, so hold them back until all of their predecessors have been written.
+   QMutexLocker lock(&outputMutex_);
+   encodedFrames_.insert(sequence, encoded);
+   for (auto it = encodedFrames_.find(nextWrite_); it != encodedFrames_.end(); it = encodedFrames_.find(nextWrite_))
+   {
+      write(it.value());
+      encodedFrames_.erase(it);
+
+      ++nextWrite_;
+      ++encodedFrameCount;
+      --framesInFlight;
+   }
+}
+
+
+void
+QStereoVideoEncoderPrivate::write(const QByteArray& frame)
+{
+   if (!headerWritten_)
+   {
+      output_.write(streamHeader(frameSize_, frameRate));
+      headerWritten_ = true;
+   }
+   output_.write("FRAME\n", 6);
+   output_.write(frame);
+}
+
+
+QByteArray
+QStereoVideoEncoderPrivate::streamHeader(const QSize& size, const unsigned int& frameRate)
+{
+   return QString("YUV4MPEG2 W%1 H%2 F%3:1 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n")
+          .arg(size.width())
+          .arg(size.height())
+          .arg(frameRate)
+          .toLatin1();
+}
+
+
+void
+QStereoVideoEncoderPrivate::convertToI420(const QStereoFrameCapture::Frame& frame, const QSize& size, uchar* const output)
+{
+   const auto& width = size.width();
+   const auto& height = size.height();
+   const auto& stride = frame.size.width() << 2;
+   const auto* const pixels = reinterpret_cast<const uchar*>(frame.pixels.constData());
+
+   uchar* const Y = output;
+   uchar* const U = Y + width * height;
+   uchar* const V = U + ((width >> 1) * (height >> 1));
+
+   // Frames are read back from OpenGL bottom-up, so rows are flipped during conversion.
+   for (int row = 0; row < height; row += 2)
+   {
+      const uchar* const top = pixels + (frame.size.height() - 1 - row) * stride;
+      const uchar* const bottom = top - stride;
+
+      lumaRow(top, Y + row * width, width);
+      lumaRow(bottom, Y + (row + 1) * width, width);
+
+      const auto& offset = (row >> 1) * (width >> 1);
+      chromaRow(top, bottom, U + offset, V + offset, width);
+   }
+}
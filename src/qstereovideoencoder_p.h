@@ -0,0 +1,74 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOVIDEOENCODER_P_H
+#define QSTEREOVIDEOENCODER_P_H
+
+#include "qstereovideoencoder.h"
+#include <QtCore/QFile>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QThreadPool>
+#include <atomic>
+
+
+QT_BEGIN_NAMESPACE
+
+class QStereoVideoEncoderPrivate : public QObject
+{
+public:
+   QStereoVideoEncoderPrivate(QStereoVideoEncoder* const parent, const QString& fileName);
+
+   bool open();
+   void close();
+   bool isOpen() const;
+
+   bool submit(const QStereoFrameCapture::Frame& frame);
+   void encode(const quint64& sequence, const QStereoFrameCapture::Frame& frame);
+
+   static QByteArray streamHeader(const QSize& size, const unsigned int& frameRate);
+   static void convertToI420(const QStereoFrameCapture::Frame& frame, const QSize& size, uchar* const output);
+
+   const QString fileName;
+   unsigned int frameRate;
+   unsigned int queueCapacity;
+   QThreadPool workers;
+
+   std::atomic<unsigned int> framesInFlight;
+   std::atomic<quint64> encodedFrameCount;
+   std::atomic<quint64> droppedFrameCount;
+private:
+   void write(const QByteArray& frame);
+
+   mutable QMutex outputMutex_;
+   QFile output_;
+   QSize frameSize_;
+   QMap<quint64, QByteArray> encodedFrames_;
+   quint64 nextSequence_;
+   quint64 nextWrite_;
+   bool headerWritten_;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOVIDEOENCODER_P_H
@@ -24,16 +24,22 @@
 #ifndef QSTEREOWINDOW_H
 #define QSTEREOWINDOW_H
 
-#include <QtCore/QCoreApplication>
+#include <QtCore/QBasicTimer>
+#include <QtCore/QPointer>
 #include <QtGui/QOpenGLContext>
 #include <QtGui/QWindow>
+#include "qabstractstereorenderer.h"
+#include "qstereoframecapture.h"
+#include "qstereoframesequence.h"
+#include "qstereorenderloop.h"
+#include "qstereoresourceloader.h"
+#include "qstereotrace.h"
+#include "qstereowindowgroup.h"
 
 
 QT_BEGIN_NAMESPACE
 
-class QAbstractStereoRenderer;
-
-template<class Renderer>
+template<class Renderer, class Policy>
 class QStereoWindow Q_DECL_FINAL : public QWindow
 {
    static_assert(std::is_base_of<QAbstractStereoRenderer, Renderer>::value, "Renderer must derive from QAbstractStereoRenderer.");
@@ -44,9 +50,20 @@ public:
    QStereoWindow(const QString& title, QStereoWindow* const parent = nullptr);
    QStereoWindow(Renderer& renderer, QStereoWindow* const parent = nullptr);
    QStereoWindow(Renderer& renderer, const QString& title, QStereoWindow* const parent = nullptr);
+   ~QStereoWindow();
 
    QOpenGLContext& context();
    Renderer& renderer();
+   QStereoResourceLoader& resourceLoader();
+
+   QStereoFrameCapture* frameCapture() const;
+   void setFrameCapture(QStereoFrameCapture* const capture);
+
+   QStereoWindowGroup* windowGroup() const;
+   void setWindowGroup(QStereoWindowGroup* const group);
+
+   bool threadedRendering() const;
+   void enableThreadedRendering(const bool enable = true);
 private:
    QStereoWindow(Renderer* const renderer, QStereoWindow* const parent);
    QStereoWindow(Renderer* const renderer, const QString& title, QStereoWindow* const parent);
@@ -61,13 +78,18 @@ private:
    void exposeEvent(QExposeEvent* const e) Q_DECL_OVERRIDE;
 
    QOpenGLContext context_;
+   QStereoResourceLoader resourceLoader_;
    Renderer* const renderer_;
-   bool updateRequestPending_;
+   QStereoFrameCapture* capture_;
+   QPointer<QStereoWindowGroup> group_;
+   QStereoRenderLoop renderLoop_;
+   QBasicTimer updateTimer_;
+   bool threadedRendering_;
 };
 
 
-template<class T>
-QStereoWindow<T>::QStereoWindow(QStereoWindow* const parent) :
+template<class T, class P>
+QStereoWindow<T, P>::QStereoWindow(QStereoWindow* const parent) :
 QStereoWindow(new T, parent)
 {
    // Change the renderer's ownership to manage dynamic memory automatically.
@@ -75,30 +97,33 @@ QStereoWindow(new T, parent)
 }
 
 
-template<class T>
-QStereoWindow<T>::QStereoWindow(const QString& title, QStereoWindow* const parent) :
+template<class T, class P>
+QStereoWindow<T, P>::QStereoWindow(const QString& title, QStereoWindow* const parent) :
 QStereoWindow(parent)
 {
    setTitle(title);
 }
 
 
-template<class T>
-QStereoWindow<T>::QStereoWindow(T& renderer, QStereoWindow* const parent) :
+template<class T, class P>
+QStereoWindow<T, P>::QStereoWindow(T& renderer, QStereoWindow* const parent) :
 QStereoWindow(&renderer, parent)
 {}
 
 
-template<class T>
-QStereoWindow<T>::QStereoWindow(T& renderer, const QString& title, QStereoWindow* const parent) :
+template<class T, class P>
+QStereoWindow<T, P>::QStereoWindow(T& renderer, const QString& title, QStereoWindow* const parent) :
 QStereoWindow(&renderer, title, parent)
 {}
 
 
-template<class T>
-QStereoWindow<T>::QStereoWindow(T* const renderer, QStereoWindow* const parent) :
+template<class T, class P>
+QStereoWindow<T, P>::QStereoWindow(T* const renderer, QStereoWindow* const parent) :
+resourceLoader_(context_),
 renderer_(renderer),
-updateRequestPending_(false)
+capture_(nullptr),
+group_(nullptr),
+threadedRendering_(false)
 {
    setSurfaceType(QWindow::OpenGLSurface);
    if (Q_UNLIKELY(!supportsOpenGL()))
@@ -112,76 +137,168 @@ updateRequestPending_(false)
 }
 
 
-template<class T>
-QStereoWindow<T>::QStereoWindow(T* const renderer, const QString& title, QStereoWindow* const parent) :
+template<class T, class P>
+QStereoWindow<T, P>::QStereoWindow(T* const renderer, const QString& title, QStereoWindow* const parent) :
 QStereoWindow(renderer, parent)
 {
    setTitle(title);
 }
 
 
-template<class T> QOpenGLContext&
-QStereoWindow<T>::context()
+template<class T, class P>
+QStereoWindow<T, P>::~QStereoWindow()
+{
+   // The render thread must be done with the context and renderer before they are destroyed.
+   renderLoop_.stop();
+   if (group_ != nullptr)
+      group_->removeRenderer(*renderer_);
+}
+
+
+template<class T, class P> QOpenGLContext&
+QStereoWindow<T, P>::context()
 {
    return context_;
 }
 
 
-template<class T> T&
-QStereoWindow<T>::renderer()
+template<class T, class P> T&
+QStereoWindow<T, P>::renderer()
 {
    return *renderer_;
 }
 
 
-template<class T> void
-QStereoWindow<T>::update()
+template<class T, class P> QStereoResourceLoader&
+QStereoWindow<T, P>::resourceLoader()
+{
+   return resourceLoader_;
+}
+
+
+template<class T, class P> QStereoFrameCapture*
+QStereoWindow<T, P>::frameCapture() const
+{
+   return capture_;
+}
+
+
+template<class T, class P> void
+QStereoWindow<T, P>::setFrameCapture(QStereoFrameCapture* const capture)
+{
+   capture_ = capture;
+}
+
+
+template<class T, class P> QStereoWindowGroup*
+QStereoWindow<T, P>::windowGroup() const
+{
+   return group_.data();
+}
+
+
+template<class T, class P> void
+QStereoWindow<T, P>::setWindowGroup(QStereoWindowGroup* const group)
+{
+   // The share context is set when the window's context is created, and cannot be changed afterwards.
+   if (context_.isValid())
+   {
+      qWarning("[QtStereoscopy] Warning: A window group must be set before the window is exposed.");
+      return;
+   }
+   if (group_ != nullptr)
+      group_->removeRenderer(*renderer_);
+
+   group_ = group;
+   if (group_ != nullptr)
+      group_->addRenderer(*renderer_);
+}
+
+
+template<class T, class P> bool
+QStereoWindow<T, P>::threadedRendering() const
+{
+   return threadedRendering_;
+}
+
+
+template<class T, class P> void
+QStereoWindow<T, P>::enableThreadedRendering(const bool enable)
 {
-   // Post an update request event in the event pool. Since overflowing the
-   // pool is a bad idea, coalesce update requests by adding the aforementioned
-   // event iff no prior events of the same kind are pending.
-   if (!updateRequestPending_)
+   if (context_.isValid())
    {
-      updateRequestPending_ = true;
-      QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateRequest));
+      qWarning("[QtStereoscopy] Warning: Threaded rendering must be enabled before the window is exposed.");
+      return;
    }
+   threadedRendering_ = enable;
 }
 
 
-template<class T> void
-QStereoWindow<T>::paintGL()
+template<class T, class P> void
+QStereoWindow<T, P>::update()
 {
-   renderer_->apply();
-   renderer_->swapBuffers(context_, *this);
+   // A zero-interval timer fires once every time the event loop has processed its pending events, which
+   // draws frames back to back without flooding the event queue. Unlike posting an update request,
+   // which allocates an event every frame, the timer's event is not allocated on the heap.
+   if (!updateTimer_.isActive())
+      updateTimer_.start(0, this);
 }
 
 
-template<class T> bool
-QStereoWindow<T>::event(QEvent* const e)
+template<class T, class P> void
+QStereoWindow<T, P>::paintGL()
 {
-   // When an update request is received, this means it is time to draw a new frame. Perform said
-   // action and make another update request (or else no more draw calls are performed.)
-   if (e->type() == QEvent::UpdateRequest && context_.makeCurrent(this))
+   QSTEREO_TRACE_ZONE("QStereoWindow::paintGL");
+
+   // The group's resource loader is shared by all windows in the group, so each of them collects from it.
+   auto* const groupLoader = group_ != nullptr ? &group_->resourceLoader() : nullptr;
+   QStereoFrameSequence<T, P>::renderFrame(*renderer_, {&resourceLoader_, groupLoader}, capture_, [this]
    {
-      updateRequestPending_ = false; // The pending request is being handled.
-      paintGL();
-      update();
+      renderer_->swapBuffers(context_, *this);
+   });
+}
+
+
+template<class T, class P> bool
+QStereoWindow<T, P>::event(QEvent* const e)
+{
+   // When the update timer fires, this means it is time to draw a new frame. The timer keeps
+   // firing, so there's no need to request another update.
+   if (e->type() == QEvent::Timer && static_cast<QTimerEvent*>(e)->timerId() == updateTimer_.timerId())
+   {
+      if (!renderLoop_.isRunning() && context_.makeCurrent(this))
+         paintGL();
+
+      return true;
    }
    return QWindow::event(e);
 }
 
 
-template<class T> void
-QStereoWindow<T>::exposeEvent(QExposeEvent* const e)
+template<class T, class P> void
+QStereoWindow<T, P>::exposeEvent(QExposeEvent* const e)
 {
    // When the window is exposed the first time, its OpenGL context and renderer need to be initialized.
    if (isExposed() && !context_.isValid())
    {
+      // Windows in the same group share their resources, so that assets are only uploaded once.
       context_.setFormat(requestedFormat());
+      if (group_ != nullptr)
+         context_.setShareContext(&group_->shareContext());
+
       if (context_.create() && context_.makeCurrent(this))
       {
          renderer_->initialize(*this);
-         update();
+
+         // A threaded window renders continuously on its own thread rather than on the update timer,
+         // so that waiting on one device's swap does not hold up the other devices.
+         if (threadedRendering_)
+         {
+            resourceLoader_.start();
+            renderLoop_.start(context_, *this, [this]{ paintGL(); });
+         }
+         else
+            update();
       }
       else
          qFatal("[QtStereoscopy] Error: Could not create an OpenGL context.");
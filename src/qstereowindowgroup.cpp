@@ -0,0 +1,103 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereowindowgroup.h"
+#include "qstereowindowgroup_p.h"
+#include "qabstractstereorenderer.h"
+#include <algorithm>
+
+
+QStereoWindowGroup::QStereoWindowGroup(const QSurfaceFormat& format, QObject* const parent) :
+QObject(parent),
+d_ptr(new QStereoWindowGroupPrivate(this, format))
+{}
+
+
+QOpenGLContext&
+QStereoWindowGroup::shareContext()
+{
+   Q_D(QStereoWindowGroup);
+   return d->shareContext;
+}
+
+
+QStereoResourceLoader&
+QStereoWindowGroup::resourceLoader()
+{
+   Q_D(QStereoWindowGroup);
+   return d->resourceLoader;
+}
+
+
+void
+QStereoWindowGroup::addRenderer(QAbstractStereoRenderer& renderer)
+{
+   Q_D(QStereoWindowGroup);
+   if (d->renderers.contains(&renderer))
+      return;
+
+   // A destroyed renderer leaves the group, so that the group never refers to it.
+   d->renderers.append(&renderer);
+   connect(&renderer, &QObject::destroyed, d, [d](QObject* const object)
+   {
+      auto& renderers = d->renderers;
+      const auto& destroyed = [object](QAbstractStereoRenderer* const r){ return static_cast<QObject*>(r) == object; };
+      renderers.erase(std::remove_if(renderers.begin(), renderers.end(), destroyed), renderers.end());
+   });
+}
+
+
+void
+QStereoWindowGroup::removeRenderer(QAbstractStereoRenderer& renderer)
+{
+   Q_D(QStereoWindowGroup);
+   const auto& i = d->renderers.indexOf(&renderer);
+   if (i >= 0)
+   {
+      d->renderers.remove(i);
+      disconnect(&renderer, nullptr, d, nullptr);
+   }
+}
+
+
+const QVector<QAbstractStereoRenderer*>&
+QStereoWindowGroup::renderers() const
+{
+   Q_D(const QStereoWindowGroup);
+   return d->renderers;
+}
+
+
+QVector<QStereoFrameStatistics*>
+QStereoWindowGroup::frameStatistics() const
+{
+   Q_D(const QStereoWindowGroup);
+
+   // Statistics are listed per device, in the same order as the renderers.
+   QVector<QStereoFrameStatistics*> statistics;
+   statistics.reserve(d->renderers.size());
+   for (auto* const renderer : d->renderers)
+      statistics.append(renderer->frameStatistics());
+
+   return statistics;
+}
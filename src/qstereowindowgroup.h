@@ -0,0 +1,61 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSTEREOWINDOWGROUP_H
+#define QSTEREOWINDOWGROUP_H
+
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+#include <QtGui/QSurfaceFormat>
+
+
+QT_BEGIN_NAMESPACE
+
+class QAbstractStereoRenderer;
+class QOpenGLContext;
+class QStereoFrameStatistics;
+class QStereoResourceLoader;
+class QStereoWindowGroupPrivate;
+class QStereoWindowGroup : public QObject
+{
+public:
+   explicit QStereoWindowGroup(const QSurfaceFormat& format = QSurfaceFormat(), QObject* const parent = nullptr);
+
+   QOpenGLContext& shareContext();
+   QStereoResourceLoader& resourceLoader();
+
+   void addRenderer(QAbstractStereoRenderer& renderer);
+   void removeRenderer(QAbstractStereoRenderer& renderer);
+   const QVector<QAbstractStereoRenderer*>& renderers() const;
+   QVector<QStereoFrameStatistics*> frameStatistics() const;
+private:
+   explicit QStereoWindowGroup(const QStereoWindowGroup&) = delete;
+   QStereoWindowGroup& operator=(const QStereoWindowGroup&) = delete;
+
+   QStereoWindowGroupPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QStereoWindowGroup);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTEREOWINDOWGROUP_H
@@ -0,0 +1,40 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereowindowgroup_p.h"
+
+
+QStereoWindowGroupPrivate::QStereoWindowGroupPrivate(QStereoWindowGroup* const parent, const QSurfaceFormat& format) :
+QObject(parent),
+resourceLoader(shareContext)
+{
+   // The share context is never made current. It only anchors the share group, so that
+   // resources outlive any one of the group's windows.
+   shareContext.setFormat(format);
+   if (Q_UNLIKELY(!shareContext.create()))
+      qFatal("[QtStereoscopy] Error: Could not create a window group's share context.");
+
+   // Workers are started here because the group's windows may collect resources from their
+   // render threads, where offscreen surfaces cannot be created.
+   resourceLoader.start();
+}
@@ -0,0 +1,402 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qsimulatedstereodisplay.h"
+#include "qsimulatedstereodisplay_p.h"
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+#include <algorithm>
+
+
+QSimulatedStereoDisplay::QSimulatedStereoDisplay(const QSize& resolution, const unsigned int& refreshRate) :
+d_ptr(new QSimulatedStereoDisplayPrivate(this, resolution, refreshRate))
+{}
+
+
+QString
+QSimulatedStereoDisplay::productName() const
+{
+   return QString("Simulated Stereo Display");
+}
+
+
+QString
+QSimulatedStereoDisplay::manufacturerName() const
+{
+   return QString("QtStereoscopy");
+}
+
+
+QSize
+QSimulatedStereoDisplay::resolution() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->resolution;
+}
+
+
+void
+QSimulatedStereoDisplay::setResolution(const QSize& resolution)
+{
+   if (Q_UNLIKELY(resolution.isEmpty()))
+      qWarning("[QtStereoscopy] Warning: Ignoring an empty simulated display resolution.");
+   else
+   {
+      Q_D(QSimulatedStereoDisplay);
+      d->resolution = resolution;
+   }
+}
+
+
+unsigned int
+QSimulatedStereoDisplay::refreshRate() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->refreshRate;
+}
+
+
+void
+QSimulatedStereoDisplay::setRefreshRate(const unsigned int& rate)
+{
+   if (Q_UNLIKELY(rate == 0))
+      qWarning("[QtStereoscopy] Warning: Ignoring a null simulated display refresh rate.");
+   else
+   {
+      Q_D(QSimulatedStereoDisplay);
+      d->refreshRate = rate;
+   }
+}
+
+
+bool
+QSimulatedStereoDisplay::vsyncEnabled() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->vsyncEnabled;
+}
+
+
+void
+QSimulatedStereoDisplay::enableVsync(const bool enable)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->vsyncEnabled = enable;
+}
+
+
+float
+QSimulatedStereoDisplay::interpupillaryDistance() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->interpupillaryDistance;
+}
+
+
+void
+QSimulatedStereoDisplay::setInterpupillaryDistance(const float& distance)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->interpupillaryDistance = std::max(distance, 0.0f);
+}
+
+
+float
+QSimulatedStereoDisplay::eyeHeight() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->eyeHeight;
+}
+
+
+void
+QSimulatedStereoDisplay::setEyeHeight(const float& height)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->eyeHeight = height;
+}
+
+
+const float&
+QSimulatedStereoDisplay::fieldOfView() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->fieldOfView;
+}
+
+
+void
+QSimulatedStereoDisplay::setFieldOfView(const float& degrees)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->fieldOfView =
+   degrees < 1.0f   ? 1.0f   :
+   degrees > 179.0f ? 179.0f : degrees;
+}
+
+
+bool
+QSimulatedStereoDisplay::trackingAvailable() const
+{
+   return true;
+}
+
+
+bool
+QSimulatedStereoDisplay::orientationTrackingAvailable() const
+{
+   return true;
+}
+
+
+bool
+QSimulatedStereoDisplay::orientationTrackingEnabled() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->orientationTrackingEnabled;
+}
+
+
+void
+QSimulatedStereoDisplay::enableOrientationTracking(const bool enable)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->orientationTrackingEnabled = enable;
+}
+
+
+QQuaternion
+QSimulatedStereoDisplay::headOrientation() const
+{
+   if (orientationTrackingEnabled())
+   {
+      Q_D(const QSimulatedStereoDisplay);
+      return d->headPose().orientation;
+   }
+   return QQuaternion(1.0, 0.0, 0.0, 0.0);
+}
+
+
+bool
+QSimulatedStereoDisplay::positionalTrackingAvailable() const
+{
+   return true;
+}
+
+
+bool
+QSimulatedStereoDisplay::positionalTrackingEnabled() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->positionalTrackingEnabled;
+}
+
+
+void
+QSimulatedStereoDisplay::enablePositionalTracking(const bool enable)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->positionalTrackingEnabled = enable;
+}
+
+
+QVector3D
+QSimulatedStereoDisplay::headPosition() const
+{
+   if (positionalTrackingEnabled())
+   {
+      Q_D(const QSimulatedStereoDisplay);
+      return d->headPose().position;
+   }
+   return QVector3D(0, 0, 0);
+}
+
+
+bool
+QSimulatedStereoDisplay::eyeTrackingAvailable() const
+{
+   return false;
+}
+
+
+bool
+QSimulatedStereoDisplay::eyeTrackingEnabled(const QEye&) const
+{
+   return false;
+}
+
+
+void
+QSimulatedStereoDisplay::enableEyeTracking(const QEye&, const bool)
+{}
+
+
+QPointF
+QSimulatedStereoDisplay::gazePoint(const QEye&) const
+{
+   return QPointF(0, 0);
+}
+
+
+QSimulatedStereoDisplay::HeadPose
+QSimulatedStereoDisplay::headPose() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+
+   auto pose = d->headPose();
+   if (!d->orientationTrackingEnabled)
+      pose.orientation = QQuaternion(1.0, 0.0, 0.0, 0.0);
+   if (!d->positionalTrackingEnabled)
+      pose.position = QVector3D(0, 0, 0);
+
+   return pose;
+}
+
+
+void
+QSimulatedStereoDisplay::setHeadMotion(const HeadMotion& motion)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->motion = motion;
+   d->posePredictor.clear();
+}
+
+
+void
+QSimulatedStereoDisplay::setHeadMotion(const QVector<HeadPose>& samples)
+{
+   if (samples.isEmpty())
+      setHeadMotion(HeadMotion(nullptr));
+   else
+   {
+      auto sorted = samples;
+      std::stable_sort(sorted.begin(), sorted.end(), [](const HeadPose& a, const HeadPose& b){ return a.time < b.time; });
+      setHeadMotion([sorted](const float& time){ return QSimulatedStereoDisplayPrivate::interpolate(sorted, time); });
+   }
+}
+
+
+bool
+QSimulatedStereoDisplay::loadHeadMotion(const QString& fileName)
+{
+   QFile file(fileName);
+   if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+   {
+      qWarning("[QtStereoscopy] Warning: Could not open the head motion recording '%s'.", qPrintable(fileName));
+      return false;
+   }
+
+   // Each line of a recording holds a sample in the form 'time w x y z px py pz', where time is
+   // given in seconds, (w, x, y, z) is the head's orientation and (px, py, pz) is its position.
+   QVector<HeadPose> samples;
+   for (unsigned int lineNumber = 1; !file.atEnd(); ++lineNumber)
+   {
+      const auto& line = QString::fromLatin1(file.readLine()).simplified();
+      if (line.isEmpty() || line.startsWith('#'))
+         continue;
+
+      const auto& fields = line.split(' ');
+      bool valid = fields.size() == 8;
+
+      float values[8] = {0};
+      for (int i = 0; valid && i < 8; ++i)
+         values[i] = fields[i].toFloat(&valid);
+
+      if (!valid)
+      {
+         qWarning("[QtStereoscopy] Warning: Malformed head motion sample on line %u of '%s'.", lineNumber, qPrintable(fileName));
+         return false;
+      }
+      samples.append(HeadPose
+      {
+         values[0],
+         QQuaternion(values[1], values[2], values[3], values[4]).normalized(),
+         QVector3D(values[5], values[6], values[7])
+      });
+   }
+
+   if (samples.isEmpty())
+   {
+      qWarning("[QtStereoscopy] Warning: The head motion recording '%s' is empty.", qPrintable(fileName));
+      return false;
+   }
+   setHeadMotion(samples);
+   return true;
+}
+
+
+QStereoPosePredictor::Pose
+QSimulatedStereoDisplay::predictHeadPose(const double& time) const
+{
+   Q_D(const QSimulatedStereoDisplay);
+
+   auto pose = d->posePredictor.predict(time);
+   if (!d->orientationTrackingEnabled)
+   {
+      pose.orientation = QQuaternion(1.0, 0.0, 0.0, 0.0);
+      pose.angularVelocity = QVector3D(0, 0, 0);
+   }
+   if (!d->positionalTrackingEnabled)
+   {
+      pose.position = QVector3D(0, 0, 0);
+      pose.linearVelocity = QVector3D(0, 0, 0);
+   }
+   return pose;
+}
+
+
+QStereoPosePredictor&
+QSimulatedStereoDisplay::posePredictor()
+{
+   Q_D(QSimulatedStereoDisplay);
+   return d->posePredictor;
+}
+
+
+const float&
+QSimulatedStereoDisplay::time() const
+{
+   Q_D(const QSimulatedStereoDisplay);
+   return d->time;
+}
+
+
+void
+QSimulatedStereoDisplay::setTime(const float& seconds)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->time = seconds;
+
+   // Jumping in time invalidates the sample history.
+   d->posePredictor.clear();
+   d->recordHeadPose();
+}
+
+
+void
+QSimulatedStereoDisplay::advance(const float& dt)
+{
+   Q_D(QSimulatedStereoDisplay);
+   d->time += dt;
+   d->recordHeadPose();
+}
@@ -0,0 +1,105 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSIMULATEDSTEREODISPLAY_H
+#define QSIMULATEDSTEREODISPLAY_H
+
+#include "qabstractstereodisplay.h"
+#include "qstereoposepredictor.h"
+#include <QtCore/QVector>
+#include <QtGui/QVector3D>
+#include <functional>
+
+
+QT_BEGIN_NAMESPACE
+
+class QSimulatedStereoDisplayPrivate;
+class QSimulatedStereoDisplay Q_DECL_FINAL : public QAbstractStereoDisplay
+{
+public:
+   struct HeadPose
+   {
+      float time;
+      QQuaternion orientation;
+      QVector3D position;
+   };
+   using HeadMotion = std::function<HeadPose(const float& time)>;
+
+   QSimulatedStereoDisplay(const QSize& resolution = QSize(1920, 1080), const unsigned int& refreshRate = 60);
+
+   QString productName() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   QString manufacturerName() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   QSize resolution() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void setResolution(const QSize& resolution);
+   unsigned int refreshRate() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void setRefreshRate(const unsigned int& rate);
+
+   bool vsyncEnabled() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void enableVsync(const bool enable = true) Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   float interpupillaryDistance() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void setInterpupillaryDistance(const float& distance) Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   float eyeHeight() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void setEyeHeight(const float& height) Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   const float& fieldOfView() const;
+   void setFieldOfView(const float& degrees);
+
+   bool trackingAvailable() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   bool orientationTrackingAvailable() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   bool orientationTrackingEnabled() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void enableOrientationTracking(const bool enable = true) Q_DECL_OVERRIDE Q_DECL_FINAL;
+   QQuaternion headOrientation() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   bool positionalTrackingAvailable() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   bool positionalTrackingEnabled() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void enablePositionalTracking(const bool enable = true) Q_DECL_OVERRIDE Q_DECL_FINAL;
+   QVector3D headPosition() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   bool eyeTrackingAvailable() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   bool eyeTrackingEnabled(const QEye& eye) const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void enableEyeTracking(const QEye& eye, const bool enable) Q_DECL_OVERRIDE Q_DECL_FINAL;
+   QPointF gazePoint(const QEye& eye) const Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   HeadPose headPose() const;
+   void setHeadMotion(const HeadMotion& motion);
+   void setHeadMotion(const QVector<HeadPose>& samples);
+   bool loadHeadMotion(const QString& fileName);
+
+   QStereoPosePredictor::Pose predictHeadPose(const double& time) const;
+   QStereoPosePredictor& posePredictor();
+
+   const float& time() const;
+   void setTime(const float& seconds);
+   void advance(const float& dt);
+private:
+   QSimulatedStereoDisplayPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QSimulatedStereoDisplay);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSIMULATEDSTEREODISPLAY_H
@@ -0,0 +1,104 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qsimulatedstereodisplay_p.h"
+#include <algorithm>
+#include <cmath>
+
+
+QSimulatedStereoDisplayPrivate::QSimulatedStereoDisplayPrivate
+(
+   QSimulatedStereoDisplay* const parent,
+   const QSize& resolution,
+   const unsigned int& refreshRate
+) :
+QObject(parent),
+resolution(resolution),
+refreshRate(refreshRate),
+vsyncEnabled(true),
+interpupillaryDistance(0.064f),
+eyeHeight(1.675f),
+fieldOfView(90.0f),
+orientationTrackingEnabled(true),
+positionalTrackingEnabled(true),
+motion(nullptr),
+time(0.0f)
+{
+   if (Q_UNLIKELY(resolution.isEmpty() || refreshRate == 0))
+      qFatal("[QtStereoscopy] Error: A simulated display requires a valid resolution and refresh rate.");
+}
+
+
+QSimulatedStereoDisplay::HeadPose
+QSimulatedStereoDisplayPrivate::headPose() const
+{
+   if (motion)
+   {
+      auto pose = motion(time);
+      pose.time = time;
+      return pose;
+   }
+   return QSimulatedStereoDisplay::HeadPose({time, QQuaternion(1.0f, 0.0f, 0.0f, 0.0f), QVector3D(0.0f, 0.0f, 0.0f)});
+}
+
+
+void
+QSimulatedStereoDisplayPrivate::recordHeadPose()
+{
+   // The simulated motion provides no velocities, so the predictor estimates them from
+   // consecutive samples.
+   const auto& pose = headPose();
+   posePredictor.addSample(pose.time, pose.orientation, pose.position);
+}
+
+
+QSimulatedStereoDisplay::HeadPose
+QSimulatedStereoDisplayPrivate::interpolate(const QVector<QSimulatedStereoDisplay::HeadPose>& samples, const float& time)
+{
+   const auto& first = samples.first();
+   const auto& last = samples.last();
+   const auto& duration = last.time - first.time;
+   if (samples.size() < 2 || duration <= 0.0f)
+      return first;
+
+   // The recording is replayed in a loop, so wrap the time into the recorded interval.
+   auto t = std::fmod(time - first.time, duration);
+   if (t < 0.0f)
+      t += duration;
+   t += first.time;
+
+   // Find the pair of samples surrounding the requested time, then blend them.
+   const auto& compare = [](const float& value, const QSimulatedStereoDisplay::HeadPose& pose){ return value < pose.time; };
+   const auto* const b = std::min(std::upper_bound(samples.begin() + 1, samples.end(), t, compare), samples.end() - 1);
+   const auto* const a = b - 1;
+
+   const auto& span = b->time - a->time;
+   const auto& s = span > 0.0f ? (t - a->time) / span : 0.0f;
+
+   return QSimulatedStereoDisplay::HeadPose
+   {
+      time,
+      QQuaternion::slerp(a->orientation, b->orientation, s),
+      a->position + (b->position - a->position) * s
+   };
+}
@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSIMULATEDSTEREODISPLAY_P_H
+#define QSIMULATEDSTEREODISPLAY_P_H
+
+#include "qsimulatedstereodisplay.h"
+
+
+QT_BEGIN_NAMESPACE
+
+class QSimulatedStereoDisplayPrivate : public QObject
+{
+public:
+   QSimulatedStereoDisplayPrivate(QSimulatedStereoDisplay* const parent, const QSize& resolution, const unsigned int& refreshRate);
+
+   QSimulatedStereoDisplay::HeadPose headPose() const;
+   void recordHeadPose();
+
+   static QSimulatedStereoDisplay::HeadPose interpolate(const QVector<QSimulatedStereoDisplay::HeadPose>& samples, const float& time);
+
+   QSize resolution;
+   unsigned int refreshRate;
+   bool vsyncEnabled;
+   float interpupillaryDistance;
+   float eyeHeight;
+   float fieldOfView;
+   bool orientationTrackingEnabled;
+   bool positionalTrackingEnabled;
+
+   QSimulatedStereoDisplay::HeadMotion motion;
+   float time;
+   QStereoPosePredictor posePredictor;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSIMULATEDSTEREODISPLAY_P_H
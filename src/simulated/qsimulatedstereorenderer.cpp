@@ -0,0 +1,202 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qsimulatedstereorenderer.h"
+#include "qsimulatedstereorenderer_p.h"
+#include "qstereotrace.h"
+
+
+QSimulatedStereoRenderer::QSimulatedStereoRenderer() :
+d_ptr(new QSimulatedStereoRendererPrivate(this))
+{}
+
+
+void
+QSimulatedStereoRenderer::apply()
+{
+   QSTEREO_TRACE_ZONE("QSimulatedStereoRenderer::apply");
+   Q_D(QSimulatedStereoRenderer);
+
+   // Make sure the framebuffer matches the display before rendering is performed.
+   d->configureGL();
+
+   // The simulated clock advances by one display refresh per frame, regardless of how long the
+   // frame actually took to render. This keeps scripted and replayed head motion reproducible.
+   auto& display = d->display();
+   const auto& dt = 1.0f / display.refreshRate();
+   display.advance(dt);
+
+   const auto& pose = display.headPose();
+
+   // An ignored eye is neither prepared nor painted. It's synthesized from the last image it was painted
+   // with when reprojection is enabled, and keeps that image as it is otherwise.
+   std::array<const QStereoEyeParameters*, 2> parameters = {{nullptr, nullptr}};
+   for (const auto& eye : {QEye::Left, QEye::Right})
+   {
+      if (!d->eyeUpdatesIgnored(eye))
+         parameters[static_cast<int>(eye)] = &d->eyeParameters(eye, pose);
+   }
+
+   auto& timing = d->frameTiming();
+   timing.beginFrame(dt);
+   prepareEyes(parameters, dt);
+   d->bindFBO();
+   for (const auto& eye : {QEye::Left, QEye::Right})
+   {
+      const auto* const eyeParameters = parameters[static_cast<int>(eye)];
+      if (eyeParameters == nullptr)
+      {
+         if (d->reprojectionEnabled())
+            d->reprojection().reproject(d->eyeParameters(eye, pose));
+         continue;
+      }
+
+      const auto& viewport = eyeParameters->viewport();
+
+      glEnable(GL_SCISSOR_TEST);
+      glScissor(viewport.x(), viewport.y(), viewport.width(), viewport.height());
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      glDisable(GL_SCISSOR_TEST);
+
+      // The pose is evaluated at the very time the frame is displayed, so there's no latency to predict.
+      QSTEREO_TRACE_ZONE(eye == QEye::Left ? "QSimulatedStereoRenderer::paintGL (left eye)" : "QSimulatedStereoRenderer::paintGL (right eye)");
+      timing.beginEye(eye, 0.0);
+      paintGL(*eyeParameters, dt);
+      timing.endEye(eye);
+
+      if (d->reprojectionEnabled())
+         d->reprojection().store(*d->framebufferObject(), *eyeParameters);
+   }
+   d->releaseFBO();
+   timing.endFrame();
+   d->present();
+}
+
+
+void
+QSimulatedStereoRenderer::ignoreEyeUpdates(const QEye& eye, const bool freeze)
+{
+   checkRenderThread("QSimulatedStereoRenderer::ignoreEyeUpdates");
+   Q_D(QSimulatedStereoRenderer);
+   d->ignoreEyeUpdates(eye, freeze);
+}
+
+
+const QOpenGLFramebufferObject*
+QSimulatedStereoRenderer::framebufferObject() const
+{
+   Q_D(const QSimulatedStereoRenderer);
+   return d->framebufferObject();
+}
+
+
+const QOpenGLFramebufferObject*
+QSimulatedStereoRenderer::framebufferObject(const QEye&) const
+{
+   // Both eyes are rendered side by side into the same framebuffer object.
+   Q_D(const QSimulatedStereoRenderer);
+   return d->framebufferObject();
+}
+
+
+QStereoFrameTiming*
+QSimulatedStereoRenderer::frameTiming()
+{
+   Q_D(QSimulatedStereoRenderer);
+   return &d->frameTiming();
+}
+
+
+QStereoFrameStatistics*
+QSimulatedStereoRenderer::frameStatistics()
+{
+   Q_D(QSimulatedStereoRenderer);
+   return &d->frameStatistics();
+}
+
+
+QSimulatedStereoDisplay&
+QSimulatedStereoRenderer::display()
+{
+   Q_D(QSimulatedStereoRenderer);
+   return d->display();
+}
+
+
+const QSimulatedStereoDisplay&
+QSimulatedStereoRenderer::const_display() const
+{
+   Q_D(const QSimulatedStereoRenderer);
+   return d->const_display();
+}
+
+
+bool
+QSimulatedStereoRenderer::reprojectionEnabled() const
+{
+   Q_D(const QSimulatedStereoRenderer);
+   return d->reprojectionEnabled();
+}
+
+
+void
+QSimulatedStereoRenderer::enableReprojection(const bool enable)
+{
+   checkRenderThread("QSimulatedStereoRenderer::enableReprojection");
+   Q_D(QSimulatedStereoRenderer);
+   d->enableReprojection(enable);
+}
+
+
+QStereoReprojection&
+QSimulatedStereoRenderer::reprojection()
+{
+   Q_D(QSimulatedStereoRenderer);
+   return d->reprojection();
+}
+
+
+QStereoProjectionSettings&
+QSimulatedStereoRenderer::projectionSettings()
+{
+   Q_D(QSimulatedStereoRenderer);
+   return d->projectionSettings();
+}
+
+
+void
+QSimulatedStereoRenderer::initializeOffscreen()
+{
+   Q_D(QSimulatedStereoRenderer);
+   d->configureOffscreen();
+}
+
+
+void
+QSimulatedStereoRenderer::initializeGL()
+{}
+
+
+void
+QSimulatedStereoRenderer::paintGL(const QStereoEyeParameters&, const float&)
+{}
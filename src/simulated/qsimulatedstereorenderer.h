@@ -0,0 +1,71 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSIMULATEDSTEREORENDERER_H
+#define QSIMULATEDSTEREORENDERER_H
+
+#include "qabstractstereorenderer.h"
+#include "qsimulatedstereodisplay.h"
+#include "qstereoeyeparameters.h"
+#include "qstereoframestatistics.h"
+#include "qstereoframetiming.h"
+#include "qstereoprojectionsettings.h"
+#include "qstereoreprojection.h"
+
+
+QT_BEGIN_NAMESPACE
+
+class QSimulatedStereoRendererPrivate;
+class QSimulatedStereoRenderer : public QAbstractStereoRenderer
+{
+   Q_OBJECT
+public:
+   QSimulatedStereoRenderer();
+
+   void apply() Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void ignoreEyeUpdates(const QEye& eye, const bool freeze = true) Q_DECL_OVERRIDE Q_DECL_FINAL;
+   const QOpenGLFramebufferObject* framebufferObject() const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   const QOpenGLFramebufferObject* framebufferObject(const QEye& eye) const Q_DECL_OVERRIDE Q_DECL_FINAL;
+   QStereoFrameTiming* frameTiming() Q_DECL_OVERRIDE Q_DECL_FINAL;
+   QStereoFrameStatistics* frameStatistics() Q_DECL_OVERRIDE Q_DECL_FINAL;
+
+   QSimulatedStereoDisplay& display();
+   const QSimulatedStereoDisplay& const_display() const;
+
+   QStereoProjectionSettings& projectionSettings();
+
+   bool reprojectionEnabled() const;
+   void enableReprojection(const bool enable = true);
+   QStereoReprojection& reprojection();
+protected:
+   void initializeOffscreen() Q_DECL_OVERRIDE Q_DECL_FINAL;
+   void initializeGL() Q_DECL_OVERRIDE;
+   void paintGL(const QStereoEyeParameters&, const float&) Q_DECL_OVERRIDE;
+private:
+   QSimulatedStereoRendererPrivate* const d_ptr;
+   Q_DECLARE_PRIVATE(QSimulatedStereoRenderer);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSIMULATEDSTEREORENDERER_H
@@ -0,0 +1,255 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qsimulatedstereorenderer.h"
+#include "qsimulatedstereorenderer_p.h"
+#include <QtGui/QMatrix4x4>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFramebufferObject>
+
+
+QSimulatedStereoRendererPrivate::QSimulatedStereoRendererPrivate(QSimulatedStereoRenderer* const parent) :
+QObject(parent),
+projection_(projectionSettings_.snapshot()),
+fbo_(nullptr),
+blitSupported_(false),
+eyeUpdatesIgnored_({false, false}),
+reprojectionEnabled_(false),
+reprojectionChanged_(false),
+offscreen_(false)
+{
+   fboFormat_.setAttachment(QOpenGLFramebufferObject::Depth);
+   fboFormat_.setTextureTarget(GL_TEXTURE_2D);
+
+   // Initialize eye value for each eye parameter.
+   for (int i = 0; i < 2; ++i)
+      eyeParameters_[i].setEye(static_cast<QEye>(i));
+
+   // Frame statistics are collected from the frame timing, which is therefore enabled by default.
+   QObject::connect(&frameTiming_, &QStereoFrameTiming::frameTimingAvailable, &frameStatistics_, &QStereoFrameStatistics::record);
+   frameTiming_.enable();
+}
+
+
+void
+QSimulatedStereoRendererPrivate::configureOffscreen()
+{
+   offscreen_ = true;
+}
+
+
+void
+QSimulatedStereoRendererPrivate::configureGL()
+{
+   // The framebuffer object always matches the display's resolution.
+   if (fbo_ == nullptr || fbo_->size() != display_.resolution())
+      configureFBO();
+
+   if (reprojectionChanged_)
+   {
+      if (!reprojectionEnabled_)
+         reprojection_.destroy();
+      else if (!reprojection_.create())
+         reprojectionEnabled_ = false;
+      reprojectionChanged_ = false;
+   }
+
+   // The projections are rebuilt for every eye, so the settings only need to be picked up once per frame
+   // for both eyes to be projected alike.
+   projectionSettings_.takeChanges(projection_);
+}
+
+
+QSimulatedStereoDisplay&
+QSimulatedStereoRendererPrivate::display()
+{
+   return display_;
+}
+
+
+const QSimulatedStereoDisplay&
+QSimulatedStereoRendererPrivate::const_display() const
+{
+   return display_;
+}
+
+
+QStereoFrameTiming&
+QSimulatedStereoRendererPrivate::frameTiming()
+{
+   return frameTiming_;
+}
+
+
+QStereoFrameStatistics&
+QSimulatedStereoRendererPrivate::frameStatistics()
+{
+   return frameStatistics_;
+}
+
+
+void
+QSimulatedStereoRendererPrivate::bindFBO()
+{
+   fbo_->bind();
+}
+
+
+void
+QSimulatedStereoRendererPrivate::releaseFBO()
+{
+   fbo_->release();
+}
+
+
+void
+QSimulatedStereoRendererPrivate::present()
+{
+   // Offscreen, the framebuffer object is the final output and there is nothing to present.
+   if (offscreen_ || !blitSupported_)
+      return;
+
+   const auto* const context = QOpenGLContext::currentContext();
+   if (context != nullptr && context->surface() != nullptr)
+   {
+      const auto& source = QRect(QPoint(0, 0), fbo_->size());
+      const auto& target = QRect(QPoint(0, 0), context->surface()->size());
+      QOpenGLFramebufferObject::blitFramebuffer(nullptr, target, fbo_.data(), source, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+   }
+}
+
+
+const QOpenGLFramebufferObject*
+QSimulatedStereoRendererPrivate::framebufferObject() const
+{
+   return fbo_.data();
+}
+
+
+bool
+QSimulatedStereoRendererPrivate::eyeUpdatesIgnored(const QEye& eye) const
+{
+   return eyeUpdatesIgnored_[static_cast<int>(eye)];
+}
+
+
+void
+QSimulatedStereoRendererPrivate::ignoreEyeUpdates(const QEye& eye, const bool ignore)
+{
+   eyeUpdatesIgnored_[static_cast<int>(eye)] = ignore;
+}
+
+
+bool
+QSimulatedStereoRendererPrivate::reprojectionEnabled() const
+{
+   return reprojectionEnabled_;
+}
+
+
+void
+QSimulatedStereoRendererPrivate::enableReprojection(const bool enable)
+{
+   if (reprojectionEnabled_ != enable)
+   {
+      reprojectionEnabled_ = enable;
+      reprojectionChanged_ = true;
+   }
+}
+
+
+QStereoReprojection&
+QSimulatedStereoRendererPrivate::reprojection()
+{
+   return reprojection_;
+}
+
+
+QStereoProjectionSettings&
+QSimulatedStereoRendererPrivate::projectionSettings()
+{
+   return projectionSettings_;
+}
+
+
+const QStereoEyeParameters&
+QSimulatedStereoRendererPrivate::eyeParameters(const QEye& eye, const QSimulatedStereoDisplay::HeadPose& pose)
+{
+         auto& eyeParams = eyeParameters_[static_cast<int>(eye)];
+   const auto& viewport = eyeParams.viewport();
+
+   // The eyes are offset by half the interpupillary distance on either side of the head's center.
+   const auto& halfIPD = 0.5f * display_.interpupillaryDistance();
+   const auto& eyeViewAdjust = QVector3D(eye == QEye::Left ? halfIPD : -halfIPD, 0.0f, 0.0f);
+
+   QMatrix4x4 view;
+   view.translate(eyeViewAdjust);
+   view.rotate(pose.orientation.conjugate());
+
+   eyeParams.setViewAdjust(eyeViewAdjust);
+   eyeParams.setHeadOrientation(pose.orientation);
+   eyeParams.setHeadPosition(pose.position);
+   eyeParams.setView(view);
+
+   const auto& znear = projection_.nearClippingDistance;
+   const auto& zfar = projection_.farClippingDistance;
+   const auto& w = static_cast<float>(viewport.width());
+   const auto& h = static_cast<float>(viewport.height());
+
+   QMatrix4x4 perspective;
+   perspective.perspective(display_.fieldOfView(), w / h, znear, zfar);
+   eyeParams.setPerspective(perspective);
+
+   // Like LibOVR's orthographic sub-projection, one unit maps to one pixel, with the origin at the eye's
+   // center and the y axis pointing down.
+   QMatrix4x4 ortho;
+   ortho.ortho(-0.5f * w, 0.5f * w, 0.5f * h, -0.5f * h, -1.0f, 1.0f);
+   eyeParams.setOrtho(ortho);
+
+   return eyeParams;
+}
+
+
+void
+QSimulatedStereoRendererPrivate::configureFBO()
+{
+   const auto& size = display_.resolution();
+
+   // Reset the FBO by allocating a new one.
+   fbo_.reset(new QOpenGLFramebufferObject(size, fboFormat_));
+   if (fbo_ == nullptr || fbo_->size() != size || !fbo_->isValid())
+      qFatal("[QtStereoscopy] Error: Could not resize the framebuffer object.");
+
+   blitSupported_ = QOpenGLFramebufferObject::hasOpenGLFramebufferBlit();
+   if (!offscreen_ && !blitSupported_)
+      qWarning("[QtStereoscopy] Warning: Framebuffer blitting is not supported. Frames will not be presented.");
+
+   // The eyes are laid out side by side, each covering half of the framebuffer.
+   const auto& w = size.width();
+   const auto& h = size.height();
+   eyeParameters_[static_cast<int>(QEye::Left)].setViewport(QRect(0, 0, w / 2, h));
+   eyeParameters_[static_cast<int>(QEye::Right)].setViewport(QRect(w / 2, 0, w - w / 2, h));
+
+   // The eyes' previous images don't fit the new framebuffer, so they can no longer be reprojected.
+   reprojection_.clearHistory();
+}
@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef QSIMULATEDSTEREORENDERER_P_H
+#define QSIMULATEDSTEREORENDERER_P_H
+
+#include "qsimulatedstereodisplay.h"
+#include "qstereoeyeparameters.h"
+#include "qstereoframestatistics.h"
+#include "qstereoframetiming.h"
+#include "qstereoprojectionsettings.h"
+#include "qstereoreprojection.h"
+#include <QtGui/QOpenGLFramebufferObjectFormat>
+#include <array>
+
+
+QT_BEGIN_NAMESPACE
+
+class QSimulatedStereoRenderer;
+class QSimulatedStereoRendererPrivate : public QObject
+{
+public:
+   explicit QSimulatedStereoRendererPrivate(QSimulatedStereoRenderer* const parent);
+
+   void configureOffscreen();
+   void configureGL();
+
+   QSimulatedStereoDisplay& display();
+   const QSimulatedStereoDisplay& const_display() const;
+   QStereoFrameTiming& frameTiming();
+   QStereoFrameStatistics& frameStatistics();
+
+   void bindFBO();
+   void releaseFBO();
+   void present();
+   const QOpenGLFramebufferObject* framebufferObject() const;
+
+   bool eyeUpdatesIgnored(const QEye& eye) const;
+   void ignoreEyeUpdates(const QEye& eye, const bool ignore);
+
+   bool reprojectionEnabled() const;
+   void enableReprojection(const bool enable);
+   QStereoReprojection& reprojection();
+
+   QStereoProjectionSettings& projectionSettings();
+
+   const QStereoEyeParameters& eyeParameters(const QEye& eye, const QSimulatedStereoDisplay::HeadPose& pose);
+private:
+   void configureFBO();
+
+   QSimulatedStereoDisplay display_;
+   QStereoFrameTiming frameTiming_;
+   QStereoFrameStatistics frameStatistics_;
+   QStereoReprojection reprojection_;
+   QStereoProjectionSettings projectionSettings_;
+   QStereoProjectionSettings::Snapshot projection_;
+
+   QScopedPointer<QOpenGLFramebufferObject> fbo_;
+   QOpenGLFramebufferObjectFormat fboFormat_;
+   bool blitSupported_;
+
+   std::array<QStereoEyeParameters, 2> eyeParameters_;
+   std::array<bool, 2> eyeUpdatesIgnored_;
+   bool reprojectionEnabled_;
+   bool reprojectionChanged_;
+   bool offscreen_;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSIMULATEDSTEREORENDERER_P_H
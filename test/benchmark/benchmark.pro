@@ -1,2 +1,2 @@
 TEMPLATE = subdirs
-SUBDIRS = oculusvr_benchmarks
+SUBDIRS = oculusvr_benchmarks simulated_benchmarks
@@ -23,10 +23,14 @@
  */
 #include "qoculusrift_benchmark.h"
 #include "qoculusriftstereorenderer_benchmark.h"
+#include <QtGui/QGuiApplication>
 
 
 int main(int argc, char** argv)
 {
+   // Offscreen surfaces require a GUI application instance.
+   QGuiApplication application(argc, argv);
+
    QVector<QObject*> benchmarks =
    {
       new QOculusRiftBenchmark,
@@ -22,3 +22,59 @@
  * THE SOFTWARE.
  */
 #include "qoculusriftstereorenderer_benchmark.h"
+#include "QOculusRiftRenderer"
+#include "QStereoOffscreenSurface"
+
+
+void
+QOculusRiftStereoRendererBenchmark::benchmarkOffscreenThroughput()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QStereoOffscreenSurface<QOculusRiftRenderer> surface(renderer);
+
+   // Render a first frame outside of the measurement to initialize the context and renderer.
+   surface.renderFrame();
+
+   QBENCHMARK
+   {
+      surface.renderFrames(100);
+   }
+}
+
+
+void
+QOculusRiftStereoRendererBenchmark::benchmarkMultisampling()
+{
+   QFETCH(float, pixelDensity);
+   QFETCH(unsigned int, sampleCount);
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   renderer.setPixelDensity(pixelDensity);
+   renderer.setSampleCount(sampleCount);
+
+   QStereoOffscreenSurface<QOculusRiftRenderer> surface(renderer);
+   surface.renderFrame();
+
+   QBENCHMARK
+   {
+      surface.renderFrames(100);
+   }
+}
+
+
+void
+QOculusRiftStereoRendererBenchmark::benchmarkMultisampling_data()
+{
+   QTest::addColumn<float>("pixelDensity");
+   QTest::addColumn<unsigned int>("sampleCount");
+
+   QTest::newRow("1.0x density, no MSAA") << 1.0f << 0u;
+   QTest::newRow("1.0x density, 2x MSAA") << 1.0f << 2u;
+   QTest::newRow("1.0x density, 4x MSAA") << 1.0f << 4u;
+   QTest::newRow("1.0x density, 8x MSAA") << 1.0f << 8u;
+   QTest::newRow("1.5x density, no MSAA") << 1.5f << 0u;
+   QTest::newRow("1.5x density, 4x MSAA") << 1.5f << 4u;
+   QTest::newRow("2.0x density, no MSAA") << 2.0f << 0u;
+}
@@ -33,6 +33,9 @@ class QOculusRiftStereoRendererBenchmark : public QObject
 {
    Q_OBJECT
 private slots:
+   void benchmarkOffscreenThroughput();
+   void benchmarkMultisampling();
+   void benchmarkMultisampling_data();
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,56 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qsimulatedstereorenderer_benchmark.h"
+#include "QSimulatedStereoRenderer"
+#include "QStereoOffscreenSurface"
+
+
+void
+QSimulatedStereoRendererBenchmark::benchmarkOffscreenThroughput_data()
+{
+   QTest::addColumn<QSize>("resolution");
+
+   QTest::newRow("1280x800") << QSize(1280, 800);
+   QTest::newRow("1920x1080") << QSize(1920, 1080);
+   QTest::newRow("2560x1440") << QSize(2560, 1440);
+}
+
+
+void
+QSimulatedStereoRendererBenchmark::benchmarkOffscreenThroughput()
+{
+   QFETCH(QSize, resolution);
+
+   QSimulatedStereoRenderer renderer;
+   renderer.display().setResolution(resolution);
+   QStereoOffscreenSurface<QSimulatedStereoRenderer> surface(renderer);
+
+   // Render a first frame outside of the measurement to initialize the context and renderer.
+   surface.renderFrame();
+
+   QBENCHMARK
+   {
+      surface.renderFrames(100);
+   }
+}
@@ -0,0 +1,11 @@
+include(../../../install/simulated.pri)
+include(../benchmark.pri)
+
+TARGET = simulated_benchmarks
+
+HEADERS +=\
+   qsimulatedstereorenderer_benchmark.h
+
+SOURCES +=\
+   qsimulatedstereorenderer_benchmark.cpp\
+   simulated_benchmarks.cpp
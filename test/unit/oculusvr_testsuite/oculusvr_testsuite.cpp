@@ -22,14 +22,20 @@
  * THE SOFTWARE.
  */
 #include "qoculusrift_test.h"
+#include "qoculusriftqualitygovernor_test.h"
 #include "qoculusriftrenderer_test.h"
+#include <QtGui/QGuiApplication>
 
 
 int main(int argc, char** argv)
 {
+   // Offscreen surfaces require a GUI application instance.
+   QGuiApplication application(argc, argv);
+
    QVector<QObject*> tests =
    {
       new QOculusRiftTest,
+      new QOculusRiftQualityGovernorTest,
       new QOculusRiftRendererTest,
    };
 
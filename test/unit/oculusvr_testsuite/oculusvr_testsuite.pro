@@ -5,9 +5,11 @@ TARGET = oculusvr_testsuite
 
 HEADERS +=\
    qoculusrift_test.h\
+   qoculusriftqualitygovernor_test.h\
    qoculusriftrenderer_test.h
 
 SOURCES +=\
    qoculusrift_test.cpp\
+   qoculusriftqualitygovernor_test.cpp\
    qoculusriftrenderer_test.cpp\
    oculusvr_testsuite.cpp
@@ -0,0 +1,263 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qoculusriftqualitygovernor_test.h"
+#include "QOculusRiftQualityGovernor"
+#include "QOculusRiftRenderer"
+#include "QStereoAllocationCounter"
+#include <chrono>
+#include <thread>
+
+
+namespace
+{
+   // Returns a frame whose CPU and GPU times are the given fractions of the frame budget.
+   QStereoFrameTiming::Frame
+   frame(const QOculusRiftQualityGovernor& governor, const double& cpuLoad, const double& gpuLoad)
+   {
+      static quint64 index = 1;
+      const auto& budget = governor.frameBudget();
+
+      QStereoFrameTiming::Frame f;
+      f.index = index++;
+      f.beginFrameTime = 1.0;
+      f.beginEyeTime = {-1.0, -1.0};
+      f.endEyeTime = {-1.0, -1.0};
+      f.endFrameTime = 1.0 + cpuLoad * budget;
+      f.swapTime = -1.0;
+      f.eyeGpuDuration = {0.5 * gpuLoad * budget, 0.5 * gpuLoad * budget};
+      f.predictedLatency = {-1.0, -1.0};
+      f.droppedFrames = 0;
+      f.allocations = 0;
+      return f;
+   }
+
+
+   // Records a frame the way the frame loop does, once the levels queued for the render thread have been applied.
+   void
+   record(QOculusRiftRenderer& renderer, QOculusRiftQualityGovernor& governor, const QStereoFrameTiming::Frame& frame)
+   {
+      renderer.processInvocations();
+      governor.record(frame);
+   }
+}
+
+
+void
+QOculusRiftQualityGovernorTest::testDebugDeviceInitialState()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QOculusRiftQualityGovernor governor(renderer);
+
+   QCOMPARE(governor.enabled(), true);
+   QCOMPARE(governor.level(), 0);
+   QCOMPARE(governor.levels().size(), QOculusRiftQualityGovernor::defaultLevels().size());
+   QCOMPARE(governor.frameBudget(), 1.0 / renderer.const_display().refreshRate());
+
+   // The highest quality level is applied on the render thread once the governor is attached.
+   renderer.processInvocations();
+   const auto& level = governor.levels().first();
+   QCOMPARE(renderer.pixelDensity(), level.pixelDensity);
+   QCOMPARE(renderer.sampleCount(), level.sampleCount);
+   QCOMPARE(renderer.halfRateEyesEnabled(), level.halfRateEyes);
+}
+
+
+void
+QOculusRiftQualityGovernorTest::testDebugDeviceLevels()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QOculusRiftQualityGovernor governor(renderer);
+   QSignalSpy spy(&governor, SIGNAL(levelChanged(const int&)));
+
+   governor.setLevels({{2.0f, 8, true, true, false}, {0.5f, 0, false, false, true}});
+   renderer.processInvocations();
+   QCOMPARE(governor.level(), 0);
+   QCOMPARE(renderer.pixelDensity(), 2.0f);
+   QCOMPARE(renderer.sampleCount(), 8u);
+
+   governor.setLevel(1);
+   QCOMPARE(governor.level(), 1);
+   QCOMPARE(renderer.pixelDensity(), 2.0f);
+
+   renderer.processInvocations();
+   QCOMPARE(renderer.pixelDensity(), 0.5f);
+   QCOMPARE(renderer.sampleCount(), 0u);
+   QCOMPARE(renderer.chromaticAberrationCorrectionEnabled(), false);
+   QCOMPARE(renderer.vignetteEnabled(), false);
+   QCOMPARE(renderer.halfRateEyesEnabled(), true);
+
+   // Levels outside the ladder are clamped, and an empty ladder is rejected.
+   governor.setLevel(5);
+   QCOMPARE(governor.level(), 1);
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: A quality governor requires at least one level.");
+   governor.setLevels({});
+   QCOMPARE(governor.levels().size(), 2);
+   QCOMPARE(spy.count(), 1);
+}
+
+
+void
+QOculusRiftQualityGovernorTest::testDebugDeviceDowngrade()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QOculusRiftQualityGovernor governor(renderer);
+   QSignalSpy spy(&governor, SIGNAL(levelChanged(const int&)));
+
+   // The GPU is the bottleneck here, so the CPU time alone must not hide it.
+   for (unsigned int i = 1; i < governor.downgradeFrameCount(); ++i)
+      record(renderer, governor, frame(governor, 0.2, 1.1));
+   QCOMPARE(governor.level(), 0);
+
+   record(renderer, governor, frame(governor, 0.2, 1.1));
+   QCOMPARE(governor.level(), 1);
+   QCOMPARE(spy.count(), 1);
+   QCOMPARE(spy.takeFirst().at(0).toInt(), 1);
+
+   // The lowest level is never exceeded.
+   for (int i = 0; i < 100; ++i)
+      record(renderer, governor, frame(governor, 2.0, 2.0));
+   QCOMPARE(governor.level(), governor.levels().size() - 1);
+}
+
+
+void
+QOculusRiftQualityGovernorTest::testDebugDeviceUpgrade()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QOculusRiftQualityGovernor governor(renderer);
+   governor.setLevel(2);
+   governor.setUpgradeFrameCount(10);
+
+   for (int i = 0; i < 9; ++i)
+      record(renderer, governor, frame(governor, 0.3, 0.3));
+   QCOMPARE(governor.level(), 2);
+
+   record(renderer, governor, frame(governor, 0.3, 0.3));
+   QCOMPARE(governor.level(), 1);
+
+   // A disabled governor leaves the renderer alone.
+   governor.enable(false);
+   for (int i = 0; i < 100; ++i)
+      record(renderer, governor, frame(governor, 0.3, 0.3));
+   QCOMPARE(governor.level(), 1);
+}
+
+
+void
+QOculusRiftQualityGovernorTest::testDebugDeviceHysteresis()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QOculusRiftQualityGovernor governor(renderer);
+   governor.setLevel(1);
+   governor.setDowngradeFrameCount(3);
+   governor.setUpgradeFrameCount(3);
+
+   // Isolated spikes and loads between both thresholds don't change the level.
+   for (int i = 0; i < 30; ++i)
+   {
+      record(renderer, governor, frame(governor, 1.5, 0.5));
+      record(renderer, governor, frame(governor, 0.8, 0.8));
+      record(renderer, governor, frame(governor, 0.5, 0.5));
+   }
+   QCOMPARE(governor.level(), 1);
+
+   // A dropped frame counts as a frame over budget, whatever its measured times.
+   for (int i = 0; i < 3; ++i)
+   {
+      auto f = frame(governor, 0.5, 0.5);
+      f.droppedFrames = 1;
+      record(renderer, governor, f);
+   }
+   QCOMPARE(governor.level(), 2);
+}
+
+
+void
+QOculusRiftQualityGovernorTest::testDebugDeviceSettling()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QOculusRiftQualityGovernor governor(renderer);
+   governor.setDowngradeFrameCount(2);
+
+   // Frames are not measured until the render thread has applied the level, whatever their load.
+   for (int i = 0; i < 10; ++i)
+      governor.record(frame(governor, 2.0, 2.0));
+   QCOMPARE(governor.level(), 0);
+
+   renderer.processInvocations();
+   governor.record(frame(governor, 2.0, 2.0));
+   governor.record(frame(governor, 2.0, 2.0));
+   QCOMPARE(governor.level(), 1);
+
+   // The same goes for every level the governor switches to.
+   governor.record(frame(governor, 2.0, 2.0));
+   governor.record(frame(governor, 2.0, 2.0));
+   QCOMPARE(governor.level(), 1);
+}
+
+
+void
+QOculusRiftQualityGovernorTest::testDebugDeviceThreadedAllocations()
+{
+   if (!QStereoAllocationCounter::enabled())
+      QSKIP("Allocations are only counted in debug builds.");
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QOculusRiftQualityGovernor governor(renderer);
+   governor.setDowngradeFrameCount(4);
+
+   // Every frame rendered on a thread of its own exceeds its budget.
+   const auto& budget = std::chrono::microseconds(static_cast<qint64>(2e6 * governor.frameBudget()));
+   std::thread([&renderer, &budget]
+   {
+      auto& timing = *renderer.frameTiming();
+      renderer.processInvocations();
+      for (int i = 0; i < 16; ++i)
+      {
+         timing.beginFrame(1.0f);
+         std::this_thread::sleep_for(budget);
+         timing.endFrame();
+      }
+      timing.beginFrame(1.0f);
+   }).join();
+
+   // Once warmed up, neither the statistics nor the governor allocate memory on the render thread.
+   for (const auto& frame : renderer.frameTiming()->frames())
+   {
+      if (frame.index >= 8 && frame.allocations >= 0)
+         QCOMPARE(frame.allocations, qint64(0));
+   }
+   QVERIFY(renderer.frameStatistics()->histogram(QStereoFrameStatistics::Stage::FrameTime).snapshot().count > 0);
+
+   // The frames handed over to the governor are measured on its own thread.
+   QCOMPARE(governor.level(), 0);
+   QTRY_COMPARE(governor.level(), 1);
+}
@@ -23,7 +23,62 @@
  */
 #include "qoculusriftrenderer_test.h"
 #include "QOculusRiftRenderer"
+#include "QStereoCompositorLayer"
+#include "QStereoFrameCapture"
+#include "QStereoFrameStatistics"
+#include "QStereoOffscreenSurface"
+#include "QStereoPosePredictor"
+#include "QStereoRenderPolicy"
+#include "QStereoTaskScheduler"
+#include "QStereoVideoEncoder"
 #include "QStereoWindow"
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+#include <QtGui/QSurfaceFormat>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+
+namespace
+{
+   // A layer that is filled with opaque red.
+   class Layer : public QStereoCompositorLayer
+   {
+   public:
+      explicit Layer(const QSize& resolution) : QStereoCompositorLayer(resolution){}
+   protected:
+      void paintGL() Q_DECL_OVERRIDE
+      {
+         glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+         glClear(GL_COLOR_BUFFER_BIT);
+         glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+      }
+   };
+
+   // A renderer that keeps its paintGL to itself, records the eyes it paints, and can stall the first eye of a frame
+   // past the frame's deadline.
+   class RecordingRenderer : public QOculusRiftRenderer
+   {
+   public:
+      RecordingRenderer() : QOculusRiftRenderer(0, true), stall(false){}
+
+      QVector<QEye> paintedEyes;
+      QQuaternion headOrientation;
+      bool stall;
+   protected:
+      void paintGL(const QStereoEyeParameters& parameters, const float&) Q_DECL_OVERRIDE
+      {
+         paintedEyes.append(parameters.eye());
+         headOrientation = parameters.headOrientation();
+         if (stall)
+         {
+            stall = false;
+            QThread::msleep(3000 / const_display().refreshRate());
+         }
+      }
+   };
+}
 
 
 void
@@ -34,6 +89,13 @@ QOculusRiftRendererTest::testDebugDeviceInitialState()
 
    QCOMPARE(renderer.const_display().isDebugDevice(), true);
    QCOMPARE(renderer.pixelDensity(), 1.0f);
+   QCOMPARE(renderer.sampleCount(), 0u);
+   QCOMPARE(renderer.reconfigurationDelay(), 100);
+   QCOMPARE(renderer.separateEyeTargetsEnabled(), false);
+   QCOMPARE(renderer.reverseDepthEnabled(), false);
+   QCOMPARE(renderer.halfRateEyesEnabled(), false);
+   QCOMPARE(renderer.lateLatchEnabled(), false);
+   QCOMPARE(renderer.lateLatch().isCreated(), false);
 
    QCOMPARE(renderer.chromaticAberrationCorrectionEnabled(), true);
    QCOMPARE(renderer.timewarpEnabled(), true);
@@ -58,6 +120,260 @@ QOculusRiftRendererTest::testDebugDeviceWindow()
 }
 
 
+void
+QOculusRiftRendererTest::testDebugDeviceOffscreenFrames()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QStereoTaskScheduler scheduler(1);
+   renderer.setTaskScheduler(&scheduler);
+
+   // Frames are only captured while there is an encoder to deliver them to.
+   QTemporaryDir directory;
+   QVERIFY(directory.isValid());
+   QStereoVideoEncoder encoder(directory.path() + "/offscreen.y4m");
+   QVERIFY(encoder.open());
+
+   QStereoFrameCapture capture;
+   capture.setEncoder(&encoder);
+   QStereoOffscreenSurface<QOculusRiftRenderer> surface(renderer);
+   surface.setFrameCapture(&capture);
+
+   // A task that is due next frame only runs once the surface has delimited a frame in the scheduler.
+   std::atomic<bool> finished(false);
+   scheduler.submit(QByteArrayLiteral("offscreen task"), [&finished]{ finished = true; }, QStereoTaskScheduler::Deadline::NextFrame);
+
+   constexpr unsigned int FRAME_COUNT = 8;
+   surface.renderFrames(FRAME_COUNT);
+
+   QVERIFY(finished.load());
+   QCOMPARE(renderer.frameTiming()->frameCount(), static_cast<quint64>(FRAME_COUNT));
+   QCOMPARE(capture.capturedFrameCount(), static_cast<quint64>(FRAME_COUNT));
+   QVERIFY(renderer.frameStatistics()->taskHistogram("offscreen task") != nullptr);
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceSeparateEyeTargetFrames()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+
+   QTemporaryDir directory;
+   QVERIFY(directory.isValid());
+   QStereoVideoEncoder encoder(directory.path() + "/separate.y4m");
+   QVERIFY(encoder.open());
+
+   QStereoFrameCapture capture;
+   capture.setEncoder(&encoder);
+   QStereoOffscreenSurface<QOculusRiftRenderer> surface(renderer);
+   surface.setFrameCapture(&capture);
+
+   surface.renderFrames(1);
+   const auto& shared = surface.grabFramebuffer();
+   QVERIFY(!shared.isNull());
+
+   // Eyes with targets of their own are grabbed and captured side by side, exactly like a shared target.
+   renderer.enableSeparateEyeTargets();
+   surface.renderFrames(4);
+   const auto* const left = renderer.framebufferObject(QEye::Left);
+   const auto* const right = renderer.framebufferObject(QEye::Right);
+   QVERIFY(left != nullptr && right != nullptr && left != right);
+
+   const auto& image = surface.grabFramebuffer();
+   QCOMPARE(image.size(), QSize(left->width() + right->width(), std::max(left->height(), right->height())));
+   QCOMPARE(image.size(), shared.size());
+
+   QCOMPARE(capture.capturedFrameCount(), quint64(5));
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceHalfRateEyeLayers()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   renderer.setSampleCount(4);
+   renderer.enableHalfRateEyes();
+
+   Layer layer(QSize(64, 64));
+   renderer.addLayer(layer);
+   QStereoOffscreenSurface<QOculusRiftRenderer> surface(renderer);
+
+   // Each eye is painted every other frame, once both have been painted once. The eye that isn't painted keeps
+   // the resolved image its layer was composited onto, so the layer is in both eyes every frame.
+   surface.renderFrames(2);
+   for (unsigned int i = 0; i < 4; ++i)
+   {
+      surface.renderFrame();
+      const auto& image = surface.grabFramebuffer();
+      QVERIFY(!image.isNull());
+      QCOMPARE(image.pixel(image.width() / 4, image.height() / 2), qRgb(255, 0, 0));
+      QCOMPARE(image.pixel(3 * image.width() / 4, image.height() / 2), qRgb(255, 0, 0));
+   }
+   renderer.removeLayer(layer);
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceMissedDeadline()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   RecordingRenderer renderer;
+   renderer.enableReprojection();
+
+   // A recorded head turn, replayed at the display's refresh rate.
+   QStereoPosePredictor poses;
+   poses.addSample(0.0, QQuaternion(), QVector3D(0.0f, 0.0f, 0.0f));
+   poses.addSample(1.0, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 30.0f), QVector3D(0.1f, 0.0f, 0.0f));
+   renderer.setOffscreenPoses(&poses);
+
+   // Reprojection requires OpenGL 3.2.
+   QSurfaceFormat format;
+   format.setVersion(3, 2);
+   format.setProfile(QSurfaceFormat::CoreProfile);
+   QStereoOffscreenSurface<RecordingRenderer> surface(renderer, format);
+
+   // Both eyes are painted while frames make their deadline, and the second frame is drawn from the pose replayed
+   // one refresh period after the first.
+   surface.renderFrames(2);
+   if (!renderer.reprojectionEnabled())
+      QSKIP("Reprojection is not supported.");
+
+   const auto& period = 1.0 / renderer.const_display().refreshRate();
+   QCOMPARE(renderer.paintedEyes.size(), 4);
+   QVERIFY(qFuzzyCompare(renderer.headOrientation, poses.predict(period).orientation));
+
+   // The first eye stalls past the frame's deadline. It's painted nonetheless, since painting it is what makes the
+   // frame current, whereas the other eye could only be shown a frame late and is synthesized instead.
+   renderer.paintedEyes.clear();
+   renderer.stall = true;
+   surface.renderFrame();
+   QCOMPARE(renderer.paintedEyes.size(), 1);
+   QVERIFY(qFuzzyCompare(renderer.headOrientation, poses.predict(2.0 * period).orientation));
+
+   // The missed deadline costs a single eye in a single frame, and the next frame is painted in full.
+   renderer.paintedEyes.clear();
+   surface.renderFrame();
+   QCOMPARE(renderer.paintedEyes.size(), 2);
+   QVERIFY(qFuzzyCompare(renderer.headOrientation, poses.predict(3.0 * period).orientation));
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceStaticPolicy()
+{
+   using Policy = QStereoRenderPolicy<1, QEye::Right>;
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   RecordingRenderer renderer;
+   QStereoOffscreenSurface<RecordingRenderer, Policy> surface(renderer);
+
+   // Only the policy's eye is painted, although the renderer's paintGL is protected.
+   constexpr unsigned int FRAME_COUNT = 4;
+   surface.renderFrames(FRAME_COUNT);
+   QCOMPARE(renderer.paintedEyes, QVector<QEye>(FRAME_COUNT, QEye::Right));
+   QCOMPARE(renderer.frameTiming()->frameCount(), static_cast<quint64>(FRAME_COUNT));
+   QVERIFY(!surface.grabFramebuffer().isNull());
+
+   // Windows are specialized on the same policy.
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QStereoWindow<RecordingRenderer, Policy> window;
+   QVERIFY(window.renderer().paintedEyes.isEmpty());
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceConfigurationFrameIndex()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QStereoOffscreenSurface<QOculusRiftRenderer> surface(renderer);
+
+   // The initial configuration is applied before the first frame is rendered.
+   surface.renderFrames(2);
+   QCOMPARE(renderer.configurationFrameIndex(), quint64(0));
+
+   // Offscreen, a reconfiguration is never delayed, so it applies from the very next frame.
+   renderer.invokeOnRenderThread([&renderer]{ renderer.setPixelDensity(0.75f); });
+   QCOMPARE(renderer.configurationFrameIndex(), quint64(0));
+   surface.renderFrames(1);
+   QCOMPARE(renderer.configurationFrameIndex(), quint64(2));
+
+   // Settings that are not staged take effect without a reconfiguration.
+   renderer.invokeOnRenderThread([&renderer]{ renderer.enableHalfRateEyes(); });
+   surface.renderFrames(1);
+   QCOMPARE(renderer.configurationFrameIndex(), quint64(2));
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceCoalescedReconfiguration()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QStereoOffscreenSurface<QOculusRiftRenderer> surface(renderer);
+   surface.renderFrames(1);
+   renderer.enableOffscreenStaging();
+   renderer.setReconfigurationDelay(200);
+   const auto initialSize = renderer.framebufferObject()->size();
+
+   // Changes made within the delay of each other are held back, and frames keep the initial configuration.
+   QVector<QSize> sizes;
+   for (const auto& density : {0.9f, 0.8f, 0.7f})
+   {
+      renderer.setPixelDensity(density);
+      surface.renderFrames(1);
+      sizes.append(renderer.framebufferObject()->size());
+      QCOMPARE(renderer.configurationFrameIndex(), std::numeric_limits<quint64>::max());
+   }
+   QCOMPARE(sizes, QVector<QSize>(3, initialSize));
+
+   // Once the last change has settled, a single reconfiguration applies it.
+   QThread::msleep(250);
+   for (int i = 0; i < 3; ++i)
+   {
+      surface.renderFrames(1);
+      const auto& size = renderer.framebufferObject()->size();
+      if (size != sizes.last())
+         sizes.append(size);
+   }
+   QCOMPARE(sizes.size(), 4);
+   QVERIFY(sizes.last().width() < initialSize.width());
+   QCOMPARE(renderer.configurationFrameIndex(), quint64(5));
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceStagedSeparateEyeTargets()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+   QStereoOffscreenSurface<QOculusRiftRenderer> surface(renderer);
+   surface.renderFrames(1);
+   renderer.enableSeparateEyeTargets();
+   surface.renderFrames(1);
+   renderer.enableOffscreenStaging();
+   renderer.setReconfigurationDelay(0);
+
+   const auto leftSize = renderer.framebufferObject(QEye::Left)->size();
+   const auto rightSize = renderer.framebufferObject(QEye::Right)->size();
+
+   // The new framebuffer objects are allocated in one frame, during which both eyes keep their current ones.
+   renderer.setPixelDensity(0.5f);
+   surface.renderFrames(1);
+   QCOMPARE(renderer.framebufferObject(QEye::Left)->size(), leftSize);
+   QCOMPARE(renderer.framebufferObject(QEye::Right)->size(), rightSize);
+   QCOMPARE(renderer.configurationFrameIndex(), std::numeric_limits<quint64>::max());
+
+   // Both eyes then switch to them at the beginning of the same frame.
+   surface.renderFrames(1);
+   QVERIFY(renderer.framebufferObject(QEye::Left)->width() < leftSize.width());
+   QVERIFY(renderer.framebufferObject(QEye::Right)->width() < rightSize.width());
+   QCOMPARE(renderer.configurationFrameIndex(), quint64(3));
+}
+
+
 void
 QOculusRiftRendererTest::testDebugDevicePixelDensity()
 {
@@ -69,6 +385,75 @@ QOculusRiftRendererTest::testDebugDevicePixelDensity()
 
    renderer.setPixelDensity(actual);
    QCOMPARE(renderer.pixelDensity(), expected);
+   QCOMPARE(renderer.pixelDensity(QEye::Left), expected);
+   QCOMPARE(renderer.pixelDensity(QEye::Right), expected);
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceEyePixelDensity()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+
+   // Each eye's pixel density is independent, and the renderer reports the highest of both.
+   renderer.setPixelDensity(QEye::Right, 0.5f);
+   QCOMPARE(renderer.pixelDensity(QEye::Left), 1.0f);
+   QCOMPARE(renderer.pixelDensity(QEye::Right), 0.5f);
+   QCOMPARE(renderer.pixelDensity(), 1.0f);
+
+   renderer.setPixelDensity(QEye::Left, 8.0f);
+   QCOMPARE(renderer.pixelDensity(QEye::Left), QOculusRiftRenderer::maxPixelDensity());
+   QCOMPARE(renderer.pixelDensity(QEye::Right), 0.5f);
+   QCOMPARE(renderer.pixelDensity(), QOculusRiftRenderer::maxPixelDensity());
+
+   renderer.enableSeparateEyeTargets();
+   QCOMPARE(renderer.separateEyeTargetsEnabled(), true);
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceFov()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+
+   const auto& recommended = renderer.const_display().recommendedFov();
+   const auto& maximum = renderer.const_display().maximumFov();
+   QCOMPARE(renderer.fov(QEye::Left).UpTan, recommended[ovrEye_Left].UpTan);
+   QCOMPARE(renderer.fov(QEye::Right).LeftTan, recommended[ovrEye_Right].LeftTan);
+
+   // Each tangent is clamped on its own, and only the eye that was set changes.
+   constexpr float MIN_TANGENT = QOculusRiftRenderer::minFovTangent();
+   renderer.setFov(QEye::Left, {100.0f, 0.0f, MIN_TANGENT + 0.1f, 100.0f});
+   const auto& fov = renderer.fov(QEye::Left);
+   QCOMPARE(fov.UpTan, maximum[ovrEye_Left].UpTan);
+   QCOMPARE(fov.DownTan, MIN_TANGENT);
+   QCOMPARE(fov.LeftTan, MIN_TANGENT + 0.1f);
+   QCOMPARE(fov.RightTan, maximum[ovrEye_Left].RightTan);
+   QCOMPARE(renderer.fov(QEye::Right).UpTan, recommended[ovrEye_Right].UpTan);
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceProjectionSettings()
+{
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+
+   auto& settings = renderer.projectionSettings();
+   QCOMPARE(settings.nearClippingDistance(), QStereoEyeParameters::nearClippingDistance());
+   QCOMPARE(settings.farClippingDistance(), QStereoEyeParameters::farClippingDistance());
+   QCOMPARE(settings.orthoDistance(), QStereoEyeParameters::orthoDistance());
+
+   // Each renderer has projection settings of its own.
+   const auto& far = QStereoEyeParameters::farClippingDistance();
+   settings.setFarClippingDistance(far * 2.0f);
+   QCOMPARE(settings.farClippingDistance(), far * 2.0f);
+   QCOMPARE(QStereoEyeParameters::farClippingDistance(), far);
+
+   renderer.enableReverseDepth();
+   QCOMPARE(renderer.reverseDepthEnabled(), true);
 }
 
 
@@ -92,3 +477,33 @@ QOculusRiftRendererTest::testDebugDevicePixelDensity_data()
    QTest::newRow("Slightly smaller than minimum pixel density") << MIN_PIXEL_DENSITY - 0.05f << MIN_PIXEL_DENSITY;
    QTest::newRow("Slightly larger than maximum pixel density") << MAX_PIXEL_DENSITY + 0.05f << MAX_PIXEL_DENSITY;
 }
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceSampleCount()
+{
+   QFETCH(unsigned int, actual);
+   QFETCH(unsigned int, expected);
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Created a debug device. Certain features may not be available.");
+   QOculusRiftRenderer renderer(0, true);
+
+   renderer.setSampleCount(actual);
+   QCOMPARE(renderer.sampleCount(), expected);
+}
+
+
+void
+QOculusRiftRendererTest::testDebugDeviceSampleCount_data()
+{
+   constexpr unsigned int MAX_SAMPLE_COUNT = QOculusRiftRenderer::maxSampleCount();
+
+   QTest::addColumn<unsigned int>("actual");
+   QTest::addColumn<unsigned int>("expected");
+
+   QTest::newRow("No multisampling") << 0u << 0u;
+   QTest::newRow("Single sample")    << 1u << 1u;
+   QTest::newRow("4x multisampling") << 4u << 4u;
+   QTest::newRow("Maximum sample count") << MAX_SAMPLE_COUNT << MAX_SAMPLE_COUNT;
+   QTest::newRow("Larger than maximum sample count") << MAX_SAMPLE_COUNT + 1 << MAX_SAMPLE_COUNT;
+}
@@ -36,9 +36,24 @@ private slots:
    void testDebugDeviceInitialState();
 
    void testDebugDeviceWindow();
+   void testDebugDeviceOffscreenFrames();
+   void testDebugDeviceConfigurationFrameIndex();
+   void testDebugDeviceCoalescedReconfiguration();
+   void testDebugDeviceStagedSeparateEyeTargets();
+   void testDebugDeviceSeparateEyeTargetFrames();
+   void testDebugDeviceHalfRateEyeLayers();
+   void testDebugDeviceMissedDeadline();
+   void testDebugDeviceStaticPolicy();
 
    void testDebugDevicePixelDensity();
    void testDebugDevicePixelDensity_data();
+
+   void testDebugDeviceEyePixelDensity();
+   void testDebugDeviceFov();
+   void testDebugDeviceProjectionSettings();
+
+   void testDebugDeviceSampleCount();
+   void testDebugDeviceSampleCount_data();
 };
 
 QT_END_NAMESPACE
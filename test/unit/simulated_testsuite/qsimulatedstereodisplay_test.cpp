@@ -0,0 +1,169 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qsimulatedstereodisplay_test.h"
+#include "QSimulatedStereoDisplay"
+
+
+void
+QSimulatedStereoDisplayTest::testInitialState()
+{
+   QSimulatedStereoDisplay display;
+
+   QCOMPARE(display.productName(), QString("Simulated Stereo Display"));
+   QCOMPARE(display.manufacturerName(), QString("QtStereoscopy"));
+
+   QCOMPARE(display.resolution(), QSize(1920, 1080));
+   QCOMPARE(display.halfResolution(), QSize(960, 540));
+   QCOMPARE(display.refreshRate(), 60u);
+   QCOMPARE(display.vsyncEnabled(), true);
+   QCOMPARE(display.fieldOfView(), 90.0f);
+   QCOMPARE(display.time(), 0.0f);
+
+   QCOMPARE(display.eyeTrackingAvailable(), false);
+   QCOMPARE(display.eyeTrackingEnabled(QEye::Left), false);
+   QCOMPARE(display.eyeTrackingEnabled(QEye::Right), false);
+}
+
+
+void
+QSimulatedStereoDisplayTest::testMeasurements()
+{
+   QSimulatedStereoDisplay display(QSize(2160, 1200), 90);
+   QCOMPARE(display.resolution(), QSize(2160, 1200));
+   QCOMPARE(display.aspectRatio(), 1.8f);
+   QCOMPARE(display.refreshRate(), 90u);
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Ignoring a null simulated display refresh rate.");
+   display.setRefreshRate(0);
+   QCOMPARE(display.refreshRate(), 90u);
+
+   display.setInterpupillaryDistance(0.07f);
+   QCOMPARE(display.interpupillaryDistance(), 0.07f);
+   display.setInterpupillaryDistance(-1.0f);
+   QCOMPARE(display.interpupillaryDistance(), 0.0f);
+
+   display.setEyeHeight(1.5f);
+   QCOMPARE(display.eyeHeight(), 1.5f);
+
+   display.setFieldOfView(110.0f);
+   QCOMPARE(display.fieldOfView(), 110.0f);
+   display.setFieldOfView(360.0f);
+   QCOMPARE(display.fieldOfView(), 179.0f);
+}
+
+
+void
+QSimulatedStereoDisplayTest::testTracking()
+{
+   QSimulatedStereoDisplay display;
+   display.setHeadMotion([](const float&)
+   {
+      return QSimulatedStereoDisplay::HeadPose({0.0f, QQuaternion(0.0f, 0.0f, 1.0f, 0.0f), QVector3D(1.0f, 2.0f, 3.0f)});
+   });
+
+   QCOMPARE(display.trackingAvailable(), true);
+   QCOMPARE(display.orientationTrackingEnabled(), true);
+   QCOMPARE(display.headOrientation(), QQuaternion(0.0f, 0.0f, 1.0f, 0.0f));
+   QCOMPARE(display.positionalTrackingEnabled(), true);
+   QCOMPARE(display.headPosition(), QVector3D(1.0f, 2.0f, 3.0f));
+
+   display.enableOrientationTracking(false);
+   QCOMPARE(display.headOrientation(), QQuaternion(1.0, 0.0, 0.0, 0.0));
+
+   display.enablePositionalTracking(false);
+   QCOMPARE(display.headPosition(), QVector3D(0, 0, 0));
+}
+
+
+void
+QSimulatedStereoDisplayTest::testScriptedHeadMotion()
+{
+   QSimulatedStereoDisplay display;
+   display.setHeadMotion([](const float& time)
+   {
+      return QSimulatedStereoDisplay::HeadPose({time, QQuaternion(1.0, 0.0, 0.0, 0.0), QVector3D(time, 0.0f, 0.0f)});
+   });
+
+   display.advance(0.5f);
+   display.advance(0.25f);
+   QCOMPARE(display.time(), 0.75f);
+   QCOMPARE(display.headPose().time, 0.75f);
+   QCOMPARE(display.headPosition(), QVector3D(0.75f, 0.0f, 0.0f));
+
+   display.setTime(2.0f);
+   QCOMPARE(display.headPosition(), QVector3D(2.0f, 0.0f, 0.0f));
+}
+
+
+void
+QSimulatedStereoDisplayTest::testReplayedHeadMotion()
+{
+   const QQuaternion identity(1.0, 0.0, 0.0, 0.0);
+   QSimulatedStereoDisplay display;
+   display.setHeadMotion(QVector<QSimulatedStereoDisplay::HeadPose>
+   {
+      {1.0f, identity, QVector3D(0.0f, 1.0f, 0.0f)},
+      {0.0f, identity, QVector3D(0.0f, 0.0f, 0.0f)},
+   });
+
+   // Samples are sorted by time, and intermediate poses are interpolated.
+   display.setTime(0.5f);
+   QCOMPARE(display.headPosition(), QVector3D(0.0f, 0.5f, 0.0f));
+
+   // Recordings are replayed in a loop.
+   display.setTime(1.25f);
+   QCOMPARE(display.headPosition(), QVector3D(0.0f, 0.25f, 0.0f));
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Could not open the head motion recording 'nonexistent.txt'.");
+   QCOMPARE(display.loadHeadMotion("nonexistent.txt"), false);
+}
+
+
+void
+QSimulatedStereoDisplayTest::testPredictedHeadMotion()
+{
+   QSimulatedStereoDisplay display;
+   display.setHeadMotion([](const float& time)
+   {
+      return QSimulatedStereoDisplay::HeadPose({time, QQuaternion(1.0, 0.0, 0.0, 0.0), QVector3D(time, 0.0f, 0.0f)});
+   });
+   QCOMPARE(display.posePredictor().sampleCount(), 0U);
+
+   // Each step adds a sample, and velocities are estimated from consecutive samples.
+   display.advance(0.01f);
+   display.advance(0.01f);
+   QCOMPARE(display.posePredictor().sampleCount(), 2U);
+
+   const auto& pose = display.predictHeadPose(0.05);
+   QVERIFY(qAbs(pose.position.x() - 0.05f) < 1e-4f);
+   QVERIFY(qAbs(pose.linearVelocity.x() - 1.0f) < 1e-3f);
+
+   // Untracked degrees of freedom are not predicted.
+   display.enablePositionalTracking(false);
+   QCOMPARE(display.predictHeadPose(0.05).position, QVector3D(0.0f, 0.0f, 0.0f));
+
+   // Jumping in time restarts the history.
+   display.setTime(2.0f);
+   QCOMPARE(display.posePredictor().sampleCount(), 1U);
+}
@@ -0,0 +1,81 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qsimulatedstereorenderer_test.h"
+#include "QSimulatedStereoRenderer"
+#include <thread>
+
+
+void
+QSimulatedStereoRendererTest::testInitialState()
+{
+   QSimulatedStereoRenderer renderer;
+
+   QVERIFY(renderer.framebufferObject() == nullptr);
+   QCOMPARE(renderer.const_display().resolution(), QSize(1920, 1080));
+   QCOMPARE(renderer.display().time(), 0.0f);
+   QCOMPARE(renderer.parallelEyePreparationEnabled(), false);
+   QCOMPARE(renderer.projectionSettings().nearClippingDistance(), QStereoEyeParameters::nearClippingDistance());
+}
+
+
+void
+QSimulatedStereoRendererTest::testParallelEyePreparation()
+{
+   QSimulatedStereoRenderer renderer;
+
+   renderer.enableParallelEyePreparation();
+   QCOMPARE(renderer.parallelEyePreparationEnabled(), true);
+
+   renderer.enableParallelEyePreparation(false);
+   QCOMPARE(renderer.parallelEyePreparationEnabled(), false);
+}
+
+
+void
+QSimulatedStereoRendererTest::testInvokeOnRenderThread()
+{
+   QSimulatedStereoRenderer renderer;
+   QVector<int> order;
+
+   // Invocations are deferred until the render thread processes them, then run in order.
+   renderer.invokeOnRenderThread([&order]{ order.append(1); });
+   renderer.invokeOnRenderThread([&order, &renderer]{ order.append(2); renderer.enableReprojection(); });
+   QVERIFY(order.isEmpty());
+   QCOMPARE(renderer.reprojectionEnabled(), false);
+
+   renderer.processInvocations();
+   QCOMPARE(order, QVector<int>({1, 2}));
+   QCOMPARE(renderer.reprojectionEnabled(), true);
+   QVERIFY(renderer.isRenderThread());
+
+   // Once the render thread is known, configuring the renderer from any other thread is reported.
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: QSimulatedStereoRenderer::enableReprojection must be called on the render thread. Use invokeOnRenderThread() instead.");
+   bool isRenderThread = true;
+   std::thread([&renderer, &isRenderThread]
+   {
+      isRenderThread = renderer.isRenderThread();
+      renderer.enableReprojection(false);
+   }).join();
+   QCOMPARE(isRenderThread, false);
+}
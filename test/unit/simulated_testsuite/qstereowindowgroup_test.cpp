@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereowindowgroup_test.h"
+#include "QSimulatedStereoRenderer"
+#include "QStereoWindowGroup"
+#include <QtGui/QOpenGLContext>
+
+
+void
+QStereoWindowGroupTest::testShareContext()
+{
+   QStereoWindowGroup group;
+
+   QVERIFY(group.shareContext().isValid());
+   QVERIFY(group.renderers().isEmpty());
+   QVERIFY(group.frameStatistics().isEmpty());
+}
+
+
+void
+QStereoWindowGroupTest::testAddRenderer()
+{
+   QStereoWindowGroup group;
+   QSimulatedStereoRenderer first;
+   QSimulatedStereoRenderer second;
+
+   group.addRenderer(first);
+   group.addRenderer(second);
+   QCOMPARE(group.renderers().size(), 2);
+   QVERIFY(group.renderers().at(0) == &first);
+   QVERIFY(group.renderers().at(1) == &second);
+
+   // Adding a renderer twice does not duplicate it.
+   group.addRenderer(first);
+   QCOMPARE(group.renderers().size(), 2);
+   QVERIFY(group.renderers().at(0) == &first);
+}
+
+
+void
+QStereoWindowGroupTest::testRemoveRenderer()
+{
+   QStereoWindowGroup group;
+   QSimulatedStereoRenderer first;
+   QSimulatedStereoRenderer second;
+
+   group.addRenderer(first);
+   group.addRenderer(second);
+   group.removeRenderer(first);
+   QCOMPARE(group.renderers().size(), 1);
+   QVERIFY(group.renderers().at(0) == &second);
+
+   // Removing a renderer that is not in the group does nothing.
+   group.removeRenderer(first);
+   QCOMPARE(group.renderers().size(), 1);
+
+   group.removeRenderer(second);
+   QVERIFY(group.renderers().isEmpty());
+}
+
+
+void
+QStereoWindowGroupTest::testDestroyedRenderer()
+{
+   QStereoWindowGroup group;
+   QSimulatedStereoRenderer first;
+   auto* const second = new QSimulatedStereoRenderer;
+
+   group.addRenderer(first);
+   group.addRenderer(*second);
+   delete second;
+   QCOMPARE(group.renderers().size(), 1);
+   QVERIFY(group.renderers().at(0) == &first);
+}
+
+
+void
+QStereoWindowGroupTest::testFrameStatistics()
+{
+   QStereoWindowGroup group;
+   QSimulatedStereoRenderer first;
+   QSimulatedStereoRenderer second;
+
+   group.addRenderer(second);
+   group.addRenderer(first);
+
+   const auto& statistics = group.frameStatistics();
+   QCOMPARE(statistics.size(), 2);
+   QVERIFY(statistics.at(0) == second.frameStatistics());
+   QVERIFY(statistics.at(1) == first.frameStatistics());
+   QVERIFY(statistics.at(0) != nullptr);
+   QVERIFY(statistics.at(0) != statistics.at(1));
+}
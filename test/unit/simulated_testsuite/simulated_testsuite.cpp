@@ -0,0 +1,49 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qsimulatedstereodisplay_test.h"
+#include "qsimulatedstereorenderer_test.h"
+#include "qstereowindowgroup_test.h"
+#include <QtGui/QGuiApplication>
+
+
+int main(int argc, char** argv)
+{
+   // Window groups require a GUI application instance.
+   QGuiApplication application(argc, argv);
+
+   QVector<QObject*> tests =
+   {
+      new QSimulatedStereoDisplayTest,
+      new QSimulatedStereoRendererTest,
+      new QStereoWindowGroupTest,
+   };
+
+   // Run each unit test, breaking the loop when a single one fails.
+   for (auto* const t : tests)
+   {
+      if (QTest::qExec(t, argc, argv))
+         return 1;
+   }
+   return 0;
+}
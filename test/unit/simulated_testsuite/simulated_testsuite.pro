@@ -0,0 +1,15 @@
+include(../../../install/simulated.pri)
+include(../unit.pri)
+
+TARGET = simulated_testsuite
+
+HEADERS +=\
+   qsimulatedstereodisplay_test.h\
+   qsimulatedstereorenderer_test.h\
+   qstereowindowgroup_test.h
+
+SOURCES +=\
+   qsimulatedstereodisplay_test.cpp\
+   qsimulatedstereorenderer_test.cpp\
+   qstereowindowgroup_test.cpp\
+   simulated_testsuite.cpp
@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereocompositorlayer_test.h"
+#include "QStereoCompositorLayer"
+
+
+namespace
+{
+   class Layer : public QStereoCompositorLayer
+   {
+   public:
+      explicit Layer(const QSize& resolution) : QStereoCompositorLayer(resolution){}
+   protected:
+      void paintGL() Q_DECL_OVERRIDE {}
+   };
+}
+
+
+void
+QStereoCompositorLayerTest::testDefaults()
+{
+   const Layer layer(QSize(512, 256));
+
+   // A layer is a head-locked quad one meter wide, one meter in front of the viewer.
+   QCOMPARE(layer.resolution(), QSize(512, 256));
+   QCOMPARE(layer.size(), QSizeF(1.0, 0.5));
+   QCOMPARE(layer.position(), QVector3D(0.0f, 0.0f, -1.0f));
+   QCOMPARE(layer.orientation(), QQuaternion());
+   QVERIFY(layer.isHeadLocked());
+   QVERIFY(layer.isVisible());
+   QCOMPARE(layer.updateInterval(), 0);
+   QVERIFY(layer.framebufferObject() == nullptr);
+}
+
+
+void
+QStereoCompositorLayerTest::testProperties()
+{
+   Layer layer(QSize(256, 256));
+
+   layer.setResolution(QSize(128, 64));
+   layer.setSize(QSizeF(0.4, 0.2));
+   layer.setPosition(QVector3D(0.0f, -0.5f, -2.0f));
+   layer.setHeadLocked(false);
+   layer.setVisible(false);
+   layer.setUpdateInterval(1000);
+
+   QCOMPARE(layer.resolution(), QSize(128, 64));
+   QCOMPARE(layer.size(), QSizeF(0.4, 0.2));
+   QCOMPARE(layer.position(), QVector3D(0.0f, -0.5f, -2.0f));
+   QVERIFY(!layer.isHeadLocked());
+   QVERIFY(!layer.isVisible());
+   QCOMPARE(layer.updateInterval(), 1000);
+
+   // A negative interval is meaningless and disables periodic updates.
+   layer.setUpdateInterval(-1);
+   QCOMPARE(layer.updateInterval(), 0);
+}
+
+
+void
+QStereoCompositorLayerTest::testUpdate()
+{
+   Layer layer(QSize(64, 64));
+
+   // A layer that has never been drawn needs an update.
+   QVERIFY(layer.needsUpdate());
+
+   // A hidden layer is neither drawn nor composited, so it keeps its pending update without a context.
+   layer.setVisible(false);
+   layer.refresh();
+   QVERIFY(layer.needsUpdate());
+   QVERIFY(layer.framebufferObject() == nullptr);
+}
@@ -0,0 +1,86 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoframestatistics_test.h"
+#include "QStereoFrameStatistics"
+
+
+namespace
+{
+   QStereoFrameTiming::Frame frameAt(const double& time)
+   {
+      QStereoFrameTiming::Frame frame;
+      frame.index = 0;
+      frame.beginFrameTime = time;
+      frame.beginEyeTime = {time + 0.001, time + 0.005};
+      frame.endEyeTime = {time + 0.004, time + 0.008};
+      frame.endFrameTime = time + 0.010;
+      frame.swapTime = -1.0;
+      frame.eyeGpuDuration = {0.002, -1.0};
+      frame.predictedLatency = {-1.0, -1.0};
+      frame.droppedFrames = 0;
+      frame.allocations = -1;
+      return frame;
+   }
+}
+
+
+void
+QStereoFrameStatisticsTest::testRecord()
+{
+   using Stage = QStereoFrameStatistics::Stage;
+
+   QStereoFrameStatistics statistics;
+   statistics.record(frameAt(0.0));
+   statistics.record(frameAt(0.016));
+
+   // The first frame has no predecessor to measure an interval from.
+   QCOMPARE(statistics.histogram(Stage::FrameInterval).snapshot().count, quint64(1));
+   QCOMPARE(statistics.histogram(Stage::FrameInterval).snapshot().maximum, 0.016);
+   QCOMPARE(statistics.histogram(Stage::FrameTime).snapshot().maximum, 0.010);
+   QCOMPARE(statistics.histogram(Stage::LeftEyeCpuTime).snapshot().maximum, 0.003);
+   QCOMPARE(statistics.histogram(Stage::RightEyeCpuTime).snapshot().maximum, 0.003);
+   QCOMPARE(statistics.histogram(Stage::LeftEyeGpuTime).snapshot().count, quint64(2));
+   QCOMPARE(statistics.histogram(Stage::RightEyeGpuTime).snapshot().count, quint64(0));
+   QCOMPARE(statistics.histogram(Stage::LeftEyePoseToSubmit).snapshot().maximum, 0.009);
+   QCOMPARE(statistics.histogram(Stage::RightEyePoseToSubmit).snapshot().maximum, 0.005);
+
+   statistics.reset();
+   QCOMPARE(statistics.histogram(Stage::FrameTime).snapshot().count, quint64(0));
+}
+
+
+void
+QStereoFrameStatisticsTest::testExport()
+{
+   QStereoFrameStatistics statistics;
+   statistics.record(frameAt(0.0));
+
+   const auto& csv = statistics.toCsv();
+   QVERIFY(csv.startsWith("stage,count,min,mean,p50,p95,p99,max\n"));
+   QVERIFY(csv.contains("frameTime,1,10.000,10.000,"));
+
+   const auto& json = statistics.toJson();
+   QVERIFY(json.startsWith("{\"frameInterval\":{\"count\":0,"));
+   QVERIFY(json.contains("\"frameTime\":{\"count\":1,\"min\":10.000,\"mean\":10.000,"));
+}
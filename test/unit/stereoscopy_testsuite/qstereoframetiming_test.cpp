@@ -0,0 +1,172 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoframetiming_test.h"
+#include "QStereoAllocationCounter"
+#include "QStereoFrameTiming"
+
+
+namespace
+{
+   void renderFrame(QStereoFrameTiming& timing, const float& frameInterval = 1.0f)
+   {
+      timing.beginFrame(frameInterval);
+      for (const auto& eye : {QEye::Left, QEye::Right})
+      {
+         timing.beginEye(eye, 0.5);
+         timing.endEye(eye);
+      }
+      timing.endFrame();
+      timing.frameSwapped();
+   }
+}
+
+
+void
+QStereoFrameTimingTest::testInitialState()
+{
+   QStereoFrameTiming timing;
+
+   QCOMPARE(timing.enabled(), false);
+   QCOMPARE(timing.capacity(), 120u);
+   QCOMPARE(timing.frames().isEmpty(), true);
+   QCOMPARE(timing.frameCount(), quint64(0));
+   QCOMPARE(timing.droppedFrameCount(), quint64(0));
+}
+
+
+void
+QStereoFrameTimingTest::testDisabled()
+{
+   QStereoFrameTiming timing;
+   renderFrame(timing);
+   renderFrame(timing);
+
+   QCOMPARE(timing.frameCount(), quint64(0));
+   QCOMPARE(timing.frames().isEmpty(), true);
+}
+
+
+void
+QStereoFrameTimingTest::testRecording()
+{
+   QStereoFrameTiming timing;
+   timing.enable();
+
+   unsigned int published = 0;
+   connect(&timing, &QStereoFrameTiming::frameTimingAvailable, [&published](const QStereoFrameTiming::Frame&){ ++published; });
+
+   // A frame is published once the next one begins.
+   renderFrame(timing);
+   QCOMPARE(published, 0u);
+   QCOMPARE(timing.frames().isEmpty(), true);
+
+   renderFrame(timing);
+   QCOMPARE(published, 1u);
+   QCOMPARE(timing.frameCount(), quint64(2));
+
+   const auto& frames = timing.frames();
+   QCOMPARE(frames.size(), 1);
+
+   const auto& frame = frames.first();
+   QCOMPARE(frame.index, quint64(0));
+   QVERIFY(frame.beginFrameTime >= 0.0);
+   for (const auto& e : {0, 1})
+   {
+      QVERIFY(frame.beginEyeTime[e] >= frame.beginFrameTime);
+      QVERIFY(frame.endEyeTime[e] >= frame.beginEyeTime[e]);
+      QVERIFY(frame.endFrameTime >= frame.endEyeTime[e]);
+      QCOMPARE(frame.predictedLatency[e], 0.5);
+
+      // Without an OpenGL context, there are no GPU timer queries.
+      QCOMPARE(frame.eyeGpuDuration[e], -1.0);
+   }
+   QVERIFY(frame.swapTime >= frame.endFrameTime);
+   QCOMPARE(frame.droppedFrames, 0u);
+   QCOMPARE(frame.allocations >= 0, QStereoAllocationCounter::enabled());
+}
+
+
+void
+QStereoFrameTimingTest::testCapacity()
+{
+   QStereoFrameTiming timing;
+   timing.enable();
+   timing.setCapacity(2);
+
+   for (unsigned int i = 0; i < 5; ++i)
+      renderFrame(timing);
+
+   // Only the most recent frames are kept, from the oldest to the newest.
+   const auto& frames = timing.frames();
+   QCOMPARE(frames.size(), 2);
+   QCOMPARE(frames[0].index, quint64(2));
+   QCOMPARE(frames[1].index, quint64(3));
+
+   timing.reset();
+   QCOMPARE(timing.frames().isEmpty(), true);
+   QCOMPARE(timing.frameCount(), quint64(0));
+}
+
+
+void
+QStereoFrameTimingTest::testDroppedFrames()
+{
+   QStereoFrameTiming timing;
+   timing.enable();
+
+   // Frames that begin well within a refresh interval of each other are not dropped.
+   renderFrame(timing, 10.0f);
+   renderFrame(timing, 10.0f);
+   QCOMPARE(timing.droppedFrameCount(), quint64(0));
+
+   // Missing several refresh intervals drops as many frames.
+   timing.reset();
+   renderFrame(timing, 0.01f);
+   QTest::qSleep(60);
+   renderFrame(timing, 0.01f);
+   QVERIFY(timing.droppedFrameCount() >= 3);
+}
+
+
+void
+QStereoFrameTimingTest::testAllocations()
+{
+   if (!QStereoAllocationCounter::enabled())
+      QSKIP("Allocations are only counted in debug builds.");
+
+   QStereoFrameTiming timing;
+   timing.enable();
+
+   // Once the history is allocated, timing a frame must not allocate any memory.
+   for (unsigned int i = 0; i < 3; ++i)
+      renderFrame(timing);
+   QCOMPARE(timing.frames().last().allocations, qint64(0));
+
+   // Allocations made during a frame are counted against it.
+   timing.beginFrame(1.0f);
+   QScopedPointer<int> allocation(new int(0));
+   timing.endFrame();
+   timing.beginFrame(1.0f);
+   QVERIFY(timing.frames().last().allocations >= 1);
+}
@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereohistogram_test.h"
+#include "QStereoHistogram"
+
+
+void
+QStereoHistogramTest::testBuckets()
+{
+   // Every value falls within the bounds of its bucket, and buckets are contiguous.
+   for (quint64 value = 0; value < 100000; value += 7)
+   {
+      const auto& index = QStereoHistogram::bucketIndex(value);
+      QVERIFY(QStereoHistogram::bucketLowerBound(index) <= value);
+      QVERIFY(QStereoHistogram::bucketUpperBound(index) > value);
+   }
+   for (unsigned int i = 0; i + 1 < QStereoHistogram::bucketCount(); ++i)
+      QCOMPARE(QStereoHistogram::bucketUpperBound(i), QStereoHistogram::bucketLowerBound(i + 1));
+
+   // Values beyond the last bucket are clamped to it.
+   QCOMPARE(QStereoHistogram::bucketIndex(~quint64(0)), QStereoHistogram::bucketCount() - 1);
+}
+
+
+void
+QStereoHistogramTest::testEmpty()
+{
+   QStereoHistogram histogram;
+   histogram.record(-1.0);
+
+   const auto& snapshot = histogram.snapshot();
+   QCOMPARE(snapshot.count, quint64(0));
+   QCOMPARE(snapshot.mean(), 0.0);
+   QCOMPARE(snapshot.percentile(99), 0.0);
+}
+
+
+void
+QStereoHistogramTest::testPercentiles()
+{
+   // Record 1 to 100 milliseconds.
+   QStereoHistogram histogram;
+   for (unsigned int i = 1; i <= 100; ++i)
+      histogram.record(1e-3 * i);
+
+   const auto& snapshot = histogram.snapshot();
+   QCOMPARE(snapshot.count, quint64(100));
+   QCOMPARE(snapshot.minimum, 0.001);
+   QCOMPARE(snapshot.maximum, 0.1);
+   QVERIFY(qAbs(snapshot.mean() - 0.0505) < 1e-6);
+
+   // Buckets are at most 1/16th of their magnitude wide.
+   QVERIFY(qAbs(snapshot.percentile(50) - 0.050) < 0.050 / 16);
+   QVERIFY(qAbs(snapshot.percentile(95) - 0.095) < 0.095 / 16);
+   QVERIFY(qAbs(snapshot.percentile(99) - 0.099) < 0.099 / 16);
+   QCOMPARE(snapshot.percentile(0), 0.001);
+   QCOMPARE(snapshot.percentile(100), 0.1);
+}
+
+
+void
+QStereoHistogramTest::testTakeSnapshot()
+{
+   QStereoHistogram histogram;
+   histogram.record(0.01);
+   histogram.record(0.02);
+
+   const auto& snapshot = histogram.takeSnapshot();
+   QCOMPARE(snapshot.count, quint64(2));
+   QCOMPARE(histogram.snapshot().count, quint64(0));
+
+   histogram.record(0.03);
+   QCOMPARE(histogram.snapshot().minimum, 0.03);
+}
@@ -0,0 +1,64 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereolatelatch_test.h"
+#include "QStereoLateLatch"
+
+
+void
+QStereoLateLatchTest::testInitialState()
+{
+   QStereoLateLatch latch;
+
+   QCOMPARE(latch.isCreated(), false);
+   QCOMPARE(latch.isPersistent(), false);
+   QCOMPARE(latch.binding(), GLuint(0));
+   QCOMPARE(QByteArray(QStereoLateLatch::blockName()), QByteArray("QStereoLateLatch"));
+   QCOMPARE(QStereoLateLatch::slotCount(), 3u);
+}
+
+
+void
+QStereoLateLatchTest::testBinding()
+{
+   QStereoLateLatch latch;
+   latch.setBinding(3);
+   QCOMPARE(latch.binding(), GLuint(3));
+}
+
+
+void
+QStereoLateLatchTest::testCreateWithoutContext()
+{
+   QStereoLateLatch latch;
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Late latching requires an OpenGL 3.2 context.");
+   QCOMPARE(latch.create(), false);
+   QCOMPARE(latch.isCreated(), false);
+
+   // Latching and binding without buffers does nothing.
+   latch.beginFrame();
+   latch.latch(QEye::Left, QMatrix4x4());
+   latch.bind(QEye::Left);
+   latch.endFrame();
+}
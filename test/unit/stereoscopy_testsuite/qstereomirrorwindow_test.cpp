@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereomirrorwindow_test.h"
+#include "QStereoMirrorWindow"
+
+
+Q_DECLARE_METATYPE(QStereoMirrorWindow::Source)
+
+
+void
+QStereoMirrorWindowTest::testSourceRegion()
+{
+   // A shared eye buffer holds both eyes side by side.
+   QCOMPARE(QStereoMirrorWindow::sourceRegion(QEye::Left, false), QRectF(0.0, 0.0, 0.5, 1.0));
+   QCOMPARE(QStereoMirrorWindow::sourceRegion(QEye::Right, false), QRectF(0.5, 0.0, 0.5, 1.0));
+
+   // Separate eye buffers are mirrored whole.
+   QCOMPARE(QStereoMirrorWindow::sourceRegion(QEye::Left, true), QRectF(0.0, 0.0, 1.0, 1.0));
+   QCOMPARE(QStereoMirrorWindow::sourceRegion(QEye::Right, true), QRectF(0.0, 0.0, 1.0, 1.0));
+}
+
+
+void
+QStereoMirrorWindowTest::testFittedSize()
+{
+   QFETCH(QStereoMirrorWindow::Source, source);
+   QFETCH(QSize, leftEyeSize);
+   QFETCH(QSize, rightEyeSize);
+   QFETCH(unsigned int, downscaleFactor);
+   QFETCH(QSize, expected);
+
+   QCOMPARE(QStereoMirrorWindow::fittedSize(source, leftEyeSize, rightEyeSize, downscaleFactor), expected);
+}
+
+
+void
+QStereoMirrorWindowTest::testFittedSize_data()
+{
+   using Source = QStereoMirrorWindow::Source;
+
+   QTest::addColumn<Source>("source");
+   QTest::addColumn<QSize>("leftEyeSize");
+   QTest::addColumn<QSize>("rightEyeSize");
+   QTest::addColumn<unsigned int>("downscaleFactor");
+   QTest::addColumn<QSize>("expected");
+
+   QTest::newRow("Both eyes")            << Source::BothEyes << QSize(640, 800) << QSize(640, 800) << 1u << QSize(1280, 800);
+   QTest::newRow("Both eyes, halved")    << Source::BothEyes << QSize(640, 800) << QSize(640, 800) << 2u << QSize(640, 400);
+   QTest::newRow("Left eye, halved")     << Source::LeftEye  << QSize(640, 800) << QSize(320, 400) << 2u << QSize(320, 400);
+   QTest::newRow("Right eye, halved")    << Source::RightEye << QSize(640, 800) << QSize(320, 400) << 2u << QSize(160, 200);
+   QTest::newRow("Unequal eyes")         << Source::BothEyes << QSize(640, 800) << QSize(320, 400) << 1u << QSize(960, 800);
+   QTest::newRow("Odd size, thirded")    << Source::LeftEye  << QSize(641, 801) << QSize(641, 801) << 3u << QSize(213, 267);
+   QTest::newRow("Zero downscale factor") << Source::LeftEye << QSize(640, 800) << QSize(640, 800) << 0u << QSize(640, 800);
+}
@@ -0,0 +1,185 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoposepredictor_test.h"
+#include "QStereoPosePredictor"
+#include <QtCore/QtMath>
+#include <cmath>
+
+
+namespace
+{
+   QStereoPosePredictor::Pose sample(const double& time, const float& yaw, const QVector3D& position = QVector3D(0, 0, 0))
+   {
+      return QStereoPosePredictor::Pose
+      {
+         time,
+         QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, yaw),
+         position,
+         QVector3D(0, 0, 0),
+         QVector3D(0, 0, 0)
+      };
+   }
+
+
+   bool fuzzyCompare(const QQuaternion& a, const QQuaternion& b)
+   {
+      // Both q and -q describe the same orientation.
+      const auto& dot = a.scalar() * b.scalar() + QVector3D::dotProduct(a.vector(), b.vector());
+      return std::abs(dot) > 0.99999f;
+   }
+
+
+   bool fuzzyCompare(const QVector3D& a, const QVector3D& b)
+   {
+      return (a - b).length() < 1e-4f;
+   }
+}
+
+
+void
+QStereoPosePredictorTest::testInitialState()
+{
+   QStereoPosePredictor predictor;
+
+   QCOMPARE(predictor.capacity(), 64u);
+   QCOMPARE(predictor.maximumPredictionInterval(), 0.1);
+   QCOMPARE(predictor.sampleCount(), 0u);
+}
+
+
+void
+QStereoPosePredictorTest::testEmpty()
+{
+   QStereoPosePredictor predictor;
+   const auto& pose = predictor.predict(1.0);
+
+   QCOMPARE(pose.time, 1.0);
+   QVERIFY(fuzzyCompare(pose.orientation, QQuaternion(1.0, 0.0, 0.0, 0.0)));
+   QVERIFY(fuzzyCompare(pose.position, QVector3D(0, 0, 0)));
+}
+
+
+void
+QStereoPosePredictorTest::testOrdering()
+{
+   QStereoPosePredictor predictor;
+   predictor.addSample(sample(1.0, 0.0f));
+   predictor.addSample(sample(2.0, 10.0f));
+
+   // Older samples are discarded, and samples with the same timestamp replace the latest one.
+   predictor.addSample(sample(1.5, 5.0f));
+   QCOMPARE(predictor.sampleCount(), 2u);
+
+   predictor.addSample(sample(2.0, 20.0f));
+   QCOMPARE(predictor.sampleCount(), 2u);
+   QVERIFY(fuzzyCompare(predictor.predict(2.0).orientation, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 20.0f)));
+
+   predictor.clear();
+   QCOMPARE(predictor.sampleCount(), 0u);
+}
+
+
+void
+QStereoPosePredictorTest::testCapacity()
+{
+   QStereoPosePredictor predictor;
+   predictor.setCapacity(4);
+   for (unsigned int i = 0; i < 10; ++i)
+      predictor.addSample(sample(i, 0.0f, QVector3D(i, 0, 0)));
+
+   QCOMPARE(predictor.sampleCount(), 4u);
+
+   // The oldest samples were dropped, so earlier times resolve to the oldest remaining sample.
+   QVERIFY(fuzzyCompare(predictor.predict(0.0).position, QVector3D(6, 0, 0)));
+
+   predictor.setCapacity(2);
+   QCOMPARE(predictor.sampleCount(), 2u);
+
+   predictor.setCapacity(0);
+   QCOMPARE(predictor.capacity(), 2u);
+}
+
+
+void
+QStereoPosePredictorTest::testInterpolation()
+{
+   QStereoPosePredictor predictor;
+   predictor.addSample(sample(1.0, 0.0f, QVector3D(0, 0, 0)));
+   predictor.addSample(sample(2.0, 90.0f, QVector3D(2, 0, 0)));
+   predictor.addSample(sample(3.0, 90.0f, QVector3D(2, 4, 0)));
+
+   const auto& a = predictor.predict(1.5);
+   QVERIFY(fuzzyCompare(a.orientation, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 45.0f)));
+   QVERIFY(fuzzyCompare(a.position, QVector3D(1, 0, 0)));
+
+   const auto& b = predictor.predict(2.25);
+   QVERIFY(fuzzyCompare(b.orientation, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 90.0f)));
+   QVERIFY(fuzzyCompare(b.position, QVector3D(2, 1, 0)));
+}
+
+
+void
+QStereoPosePredictorTest::testExtrapolation()
+{
+   // The head turns at 90 degrees per second around the vertical axis, while moving at 1 m/s.
+   auto s = sample(1.0, 0.0f);
+   s.angularVelocity = QVector3D(0.0f, static_cast<float>(M_PI_2), 0.0f);
+   s.linearVelocity = QVector3D(1, 0, 0);
+
+   QStereoPosePredictor predictor;
+   predictor.addSample(s);
+
+   const auto& a = predictor.predict(1.05);
+   QCOMPARE(a.time, 1.05);
+   QVERIFY(fuzzyCompare(a.orientation, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 4.5f)));
+   QVERIFY(fuzzyCompare(a.position, QVector3D(0.05f, 0, 0)));
+
+   // Predictions further ahead than the maximum prediction interval are clamped.
+   const auto& b = predictor.predict(2.0);
+   QVERIFY(fuzzyCompare(b.orientation, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 9.0f)));
+   QVERIFY(fuzzyCompare(b.position, QVector3D(0.1f, 0, 0)));
+
+   predictor.setMaximumPredictionInterval(1.0);
+   const auto& c = predictor.predict(2.0);
+   QVERIFY(fuzzyCompare(c.orientation, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 90.0f)));
+   QVERIFY(fuzzyCompare(c.position, QVector3D(1, 0, 0)));
+}
+
+
+void
+QStereoPosePredictorTest::testEstimatedVelocity()
+{
+   // Replayed or simulated sources may only provide poses, whose velocities are then estimated.
+   QStereoPosePredictor predictor;
+   predictor.addSample(0.0, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 0.0f), QVector3D(0, 0, 0));
+   predictor.addSample(0.1, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 3.0f), QVector3D(0, 0.2f, 0));
+
+   const auto& latest = predictor.predict(0.1);
+   QVERIFY(fuzzyCompare(latest.angularVelocity, QVector3D(0.0f, qDegreesToRadians(30.0f), 0.0f)));
+   QVERIFY(fuzzyCompare(latest.linearVelocity, QVector3D(0, 2, 0)));
+
+   const auto& predicted = predictor.predict(0.15);
+   QVERIFY(fuzzyCompare(predicted.orientation, QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 4.5f)));
+   QVERIFY(fuzzyCompare(predicted.position, QVector3D(0, 0.3f, 0)));
+}
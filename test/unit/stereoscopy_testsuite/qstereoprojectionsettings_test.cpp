@@ -0,0 +1,92 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoprojectionsettings_test.h"
+#include "QStereoEyeParameters"
+#include "QStereoProjectionSettings"
+#include <thread>
+
+
+void
+QStereoProjectionSettingsTest::testInitialState()
+{
+   QStereoProjectionSettings settings;
+
+   QCOMPARE(settings.nearClippingDistance(), QStereoEyeParameters::nearClippingDistance());
+   QCOMPARE(settings.farClippingDistance(), QStereoEyeParameters::farClippingDistance());
+   QCOMPARE(settings.orthoDistance(), QStereoEyeParameters::orthoDistance());
+}
+
+
+void
+QStereoProjectionSettingsTest::testTakeChanges()
+{
+   QStereoProjectionSettings settings;
+   QStereoProjectionSettings::Snapshot snapshot = {0.0f, 0.0f, 0.0f};
+
+   // New settings are always taken once, after which they're only taken again when they change.
+   QVERIFY(settings.takeChanges(snapshot));
+   QCOMPARE(snapshot.nearClippingDistance, settings.nearClippingDistance());
+   QVERIFY(!settings.takeChanges(snapshot));
+
+   settings.setOrthoDistance(settings.orthoDistance());
+   QVERIFY(!settings.takeChanges(snapshot));
+
+   settings.setNearClippingDistance(0.5f);
+   settings.setOrthoDistance(2.0f);
+   QVERIFY(settings.takeChanges(snapshot));
+   QCOMPARE(snapshot.nearClippingDistance, 0.5f);
+   QCOMPARE(snapshot.farClippingDistance, settings.farClippingDistance());
+   QCOMPARE(snapshot.orthoDistance, 2.0f);
+   QVERIFY(!settings.takeChanges(snapshot));
+}
+
+
+void
+QStereoProjectionSettingsTest::testConcurrentWrites()
+{
+   QStereoProjectionSettings settings;
+   QStereoProjectionSettings::Snapshot snapshot = {0.0f, 0.0f, 0.0f};
+   settings.setNearClippingDistance(0.0f);
+   settings.setFarClippingDistance(0.0f);
+   settings.takeChanges(snapshot);
+
+   // The near distance is always written before the far one, so a snapshot that isn't torn between both
+   // writes never has a far distance beyond the near one.
+   std::thread writer([&settings]
+   {
+      for (int i = 1; i <= 1000; ++i)
+      {
+         settings.setNearClippingDistance(static_cast<float>(i));
+         settings.setFarClippingDistance(static_cast<float>(i));
+      }
+   });
+   auto consistent = true;
+   while (snapshot.farClippingDistance < 1000.0f)
+   {
+      if (settings.takeChanges(snapshot))
+         consistent = consistent && snapshot.farClippingDistance <= snapshot.nearClippingDistance;
+   }
+   writer.join();
+   QVERIFY(consistent);
+}
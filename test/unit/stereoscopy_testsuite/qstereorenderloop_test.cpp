@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereorenderloop_test.h"
+#include "QStereoRenderLoop"
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+
+
+void
+QStereoRenderLoopTest::testInitialState()
+{
+   QStereoRenderLoop loop;
+   QCOMPARE(loop.isRunning(), false);
+   QCOMPARE(loop.frameCount(), quint64(0));
+
+   // Stopping a loop that was never started does nothing.
+   loop.stop();
+   QCOMPARE(loop.isRunning(), false);
+}
+
+
+void
+QStereoRenderLoopTest::testInvalidFrame()
+{
+   QOpenGLContext context;
+   QOffscreenSurface surface;
+   QStereoRenderLoop loop;
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: A render loop requires a frame function.");
+   QCOMPARE(loop.start(context, surface, nullptr), false);
+   QCOMPARE(loop.isRunning(), false);
+   QCOMPARE(context.thread(), QThread::currentThread());
+}
+
+
+void
+QStereoRenderLoopTest::testInvalidContext()
+{
+   QOpenGLContext context;
+   QOffscreenSurface surface;
+   QStereoRenderLoop loop;
+
+   // A context that cannot be made current stops the loop before any frame is rendered, and
+   // is returned to the thread that started the loop.
+   unsigned int frames = 0;
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Could not make a render loop's context current.");
+   QCOMPARE(loop.start(context, surface, [&frames]{ ++frames; }), true);
+   loop.stop();
+
+   QCOMPARE(loop.isRunning(), false);
+   QCOMPARE(loop.frameCount(), quint64(0));
+   QCOMPARE(frames, 0u);
+   QCOMPARE(context.thread(), QThread::currentThread());
+}
@@ -0,0 +1,77 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereorenderpolicy_test.h"
+#include "QStereoRenderPolicy"
+
+
+void
+QStereoRenderPolicyTest::testDefaultPolicy()
+{
+   using Policy = QStereoDynamicRenderPolicy;
+
+   QCOMPARE(Policy::staticDispatch(), false);
+   QCOMPARE(Policy::eyeCount(), 2u);
+   QVERIFY(Policy::eye(0) == QEye::Left);
+   QVERIFY(Policy::eye(1) == QEye::Right);
+   QCOMPARE(Policy::hasFeature(QStereoRenderFeature::AllFeatures), true);
+}
+
+
+void
+QStereoRenderPolicyTest::testEyeOrder()
+{
+   using Stereo = QStereoRenderPolicy<>;
+   using Reversed = QStereoRenderPolicy<2, QEye::Right>;
+   using Mono = QStereoRenderPolicy<1, QEye::Right>;
+
+   // The policy is resolved at compile time.
+   static_assert(Stereo::staticDispatch() && Stereo::eyeCount() == 2, "A default policy draws both eyes.");
+   static_assert(Mono::eyeCount() == 1 && Mono::eye(0) == QEye::Right, "A mono policy draws its first eye only.");
+
+   QVERIFY(Stereo::eye(0) == QEye::Left);
+   QVERIFY(Stereo::eye(1) == QEye::Right);
+   QVERIFY(Reversed::eye(0) == QEye::Right);
+   QVERIFY(Reversed::eye(1) == QEye::Left);
+}
+
+
+void
+QStereoRenderPolicyTest::testFeatures()
+{
+   using Feature = QStereoRenderFeature;
+   using All = QStereoRenderPolicy<>;
+   using Disabled = QStereoRenderPolicy<2, QEye::Left, Feature::NoFeatures>;
+   using Timed = QStereoRenderPolicy<2, QEye::Left, Feature::FrameTiming | Feature::LateLatch>;
+
+   for (const auto& feature : {Feature::FrameTiming, Feature::LateLatch, Feature::FrameCapture, Feature::ResourceLoading, Feature::TaskScheduling})
+   {
+      QCOMPARE(All::hasFeature(feature), true);
+      QCOMPARE(Disabled::hasFeature(feature), false);
+   }
+   QCOMPARE(Timed::hasFeature(Feature::FrameTiming), true);
+   QCOMPARE(Timed::hasFeature(Feature::LateLatch), true);
+   QCOMPARE(Timed::hasFeature(Feature::FrameTiming | Feature::LateLatch), true);
+   QCOMPARE(Timed::hasFeature(Feature::FrameCapture), false);
+   QCOMPARE(Timed::hasFeature(Feature::FrameTiming | Feature::FrameCapture), false);
+}
@@ -0,0 +1,154 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoreprojection_test.h"
+#include "QStereoEyeParameters"
+#include "QStereoReprojection"
+
+
+namespace
+{
+   struct Pose
+   {
+      QQuaternion orientation;
+      QVector3D position;
+   };
+
+   // Fills the eye's parameters the way the renderers do, for an eye offset by half a typical IPD.
+   void setPose(QStereoEyeParameters& parameters, const Pose& pose)
+   {
+      const auto& viewAdjust = QVector3D(0.032f, 0.0f, 0.0f);
+
+      QMatrix4x4 view;
+      view.translate(viewAdjust);
+      view.rotate(pose.orientation.conjugate());
+
+      QMatrix4x4 perspective;
+      perspective.perspective(90.0f, 0.9f, 0.1f, 100.0f);
+
+      parameters.setEye(QEye::Left);
+      parameters.setViewAdjust(viewAdjust);
+      parameters.setHeadOrientation(pose.orientation);
+      parameters.setHeadPosition(pose.position);
+      parameters.setView(view);
+      parameters.setPerspective(perspective);
+   }
+
+   // Projects a point in the world into normalized device coordinates.
+   QVector3D project(const QStereoEyeParameters& parameters, const QVector3D& point)
+   {
+      QMatrix4x4 view = parameters.view();
+      view.translate(-parameters.headPosition());
+
+      const auto& clip = parameters.perspective() * view * QVector4D(point, 1.0f);
+      return clip.toVector3DAffine();
+   }
+}
+
+
+void
+QStereoReprojectionTest::testInitialState()
+{
+   QStereoReprojection reprojection;
+
+   QCOMPARE(reprojection.isCreated(), false);
+   QCOMPARE(reprojection.hasHistory(QEye::Left), false);
+   QCOMPARE(reprojection.hasHistory(QEye::Right), false);
+   QCOMPARE(reprojection.gridResolution(), 64u);
+   QCOMPARE(reprojection.reverseDepth(), false);
+
+   // A grid needs at least one cell.
+   reprojection.setGridResolution(0);
+   QCOMPARE(reprojection.gridResolution(), 1u);
+
+   reprojection.setReverseDepth(true);
+   QCOMPARE(reprojection.reverseDepth(), true);
+}
+
+
+void
+QStereoReprojectionTest::testCreateWithoutContext()
+{
+   QStereoReprojection reprojection;
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Reprojection requires an OpenGL 3.2 context.");
+   QCOMPARE(reprojection.create(), false);
+   QCOMPARE(reprojection.isCreated(), false);
+
+   // Without a history, nothing is synthesized.
+   QStereoEyeParameters parameters;
+   QCOMPARE(reprojection.reproject(parameters), false);
+}
+
+
+void
+QStereoReprojectionTest::testIdentity()
+{
+   QStereoEyeParameters parameters;
+   setPose(parameters, {QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 30.0f), QVector3D(0.1f, 1.7f, -0.2f)});
+
+   const auto& matrix = QStereoReprojection::matrix(parameters, parameters);
+   for (int i = 0; i < 4; ++i)
+   {
+      for (int j = 0; j < 4; ++j)
+         QVERIFY(qAbs(matrix(i, j) - (i == j ? 1.0f : 0.0f)) < 1e-4f);
+   }
+}
+
+
+void
+QStereoReprojectionTest::testReplayedPoses()
+{
+   // A recorded head motion that turns and moves sideways, as a head does when looking around.
+   const Pose poses[] =
+   {
+      {QQuaternion(), QVector3D(0.0f, 0.0f, 0.0f)},
+      {QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 2.0f), QVector3D(0.01f, 0.0f, 0.0f)},
+      {QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 5.0f), QVector3D(0.03f, 0.005f, 0.0f)},
+      {QQuaternion::fromAxisAndAngle(1.0f, 1.0f, 0.0f, 9.0f), QVector3D(0.06f, 0.01f, -0.02f)},
+   };
+   const QVector3D points[] =
+   {
+      QVector3D(0.0f, 0.0f, -2.0f),
+      QVector3D(0.5f, -0.3f, -1.0f),
+      QVector3D(-1.0f, 0.4f, -5.0f),
+   };
+
+   // A point seen in the previous frame must land where the newest pose sees it, which covers both the
+   // rotation and the translation of the head.
+   QStereoEyeParameters from;
+   QStereoEyeParameters to;
+   for (unsigned int i = 1; i < sizeof(poses) / sizeof(poses[0]); ++i)
+   {
+      setPose(from, poses[i - 1]);
+      setPose(to, poses[i]);
+
+      const auto& matrix = QStereoReprojection::matrix(from, to);
+      for (const auto& point : points)
+      {
+         const auto& reprojected = (matrix * QVector4D(project(from, point), 1.0f)).toVector3DAffine();
+         const auto& expected = project(to, point);
+         QVERIFY((reprojected - expected).length() < 1e-3f);
+      }
+   }
+}
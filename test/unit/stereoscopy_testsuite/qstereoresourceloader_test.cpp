@@ -0,0 +1,76 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereoresourceloader_test.h"
+#include "QStereoResourceLoader"
+#include <QtGui/QOpenGLContext>
+
+
+void
+QStereoResourceLoaderTest::testInitialState()
+{
+   QOpenGLContext context;
+   QStereoResourceLoader loader(context, 2);
+
+   QCOMPARE(loader.workerCount(), 2u);
+   QCOMPARE(loader.started(), false);
+   QCOMPARE(loader.pendingJobCount(), 0u);
+
+   // A loader always has at least one worker.
+   QStereoResourceLoader empty(context, 0);
+   QCOMPARE(empty.workerCount(), 1u);
+}
+
+
+void
+QStereoResourceLoaderTest::testInvalidShareContext()
+{
+   QOpenGLContext context;
+   QStereoResourceLoader loader(context);
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: Resource loader workers require a valid share context.");
+   QCOMPARE(loader.start(), false);
+   QCOMPARE(loader.started(), false);
+}
+
+
+void
+QStereoResourceLoaderTest::testQueuedJobs()
+{
+   QOpenGLContext context;
+   QStereoResourceLoader loader(context);
+
+   unsigned int published = 0;
+   connect(&loader, &QStereoResourceLoader::resourceReady, [&published](const quint64&, const GLuint&){ ++published; });
+
+   const auto& first = loader.uploadBuffer(QByteArray(16, '\0'));
+   const auto& second = loader.submit([](QOpenGLContext&){ return GLuint(0); });
+   QVERIFY(second > first);
+   QCOMPARE(loader.pendingJobCount(), 2u);
+
+   // Without a valid share context, jobs remain queued and nothing is published.
+   loader.collect();
+   QCOMPARE(loader.started(), false);
+   QCOMPARE(loader.pendingJobCount(), 2u);
+   QCOMPARE(published, 0u);
+}
@@ -0,0 +1,174 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereotaskscheduler_test.h"
+#include "QStereoFrameStatistics"
+#include "QStereoTaskScheduler"
+#include <atomic>
+#include <thread>
+
+
+void
+QStereoTaskSchedulerTest::testInitialState()
+{
+   using Deadline = QStereoTaskScheduler::Deadline;
+
+   QStereoTaskScheduler scheduler(2);
+   QCOMPARE(scheduler.workerCount(), 2u);
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::CurrentFrame), 0u);
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::NextFrame), 0u);
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::None), 0u);
+
+   // A scheduler always has at least one worker, and unknown tasks are considered finished.
+   QVERIFY(QStereoTaskScheduler().workerCount() > 0);
+   QVERIFY(scheduler.isFinished(0));
+   QVERIFY(QStereoTaskScheduler::globalInstance() != nullptr);
+}
+
+
+void
+QStereoTaskSchedulerTest::testDependencies()
+{
+   QStereoTaskScheduler scheduler(4);
+
+   QMutex mutex;
+   QVector<int> order;
+   const auto& append = [&mutex, &order](const int& value)
+   {
+      return [&mutex, &order, value]{ QMutexLocker locker(&mutex); order.append(value); };
+   };
+
+   // A task never runs before the tasks it depends on have finished.
+   const auto& a = scheduler.submit("a", append(0));
+   const auto& b = scheduler.submit("b", append(1), QStereoTaskScheduler::Deadline::CurrentFrame, {a});
+   const auto& c = scheduler.submit("c", append(2), QStereoTaskScheduler::Deadline::CurrentFrame, {a, b});
+   scheduler.wait(c);
+
+   QVERIFY(scheduler.isFinished(a));
+   QVERIFY(scheduler.isFinished(b));
+   QVERIFY(scheduler.isFinished(c));
+   QCOMPARE(order, QVector<int>({0, 1, 2}));
+}
+
+
+void
+QStereoTaskSchedulerTest::testDeadlines()
+{
+   using Deadline = QStereoTaskScheduler::Deadline;
+   QStereoTaskScheduler scheduler(2);
+
+   // The gate holds back the task that depends on it until it is opened.
+   std::atomic<bool> open(false);
+   const auto& gate = scheduler.submit("gate", [&open]{ while (!open.load()) QThread::yieldCurrentThread(); }, Deadline::None);
+   const auto& next = scheduler.submit("next", []{}, Deadline::NextFrame, {gate});
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::NextFrame), 1u);
+
+   // Tasks that are due next frame become due this frame when it begins.
+   scheduler.beginFrame();
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::NextFrame), 0u);
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::CurrentFrame), 1u);
+   QVERIFY(!scheduler.isFinished(next));
+
+   open = true;
+   scheduler.endFrame();
+   QVERIFY(scheduler.isFinished(next));
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::CurrentFrame), 0u);
+
+   scheduler.wait(gate);
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::None), 0u);
+}
+
+
+void
+QStereoTaskSchedulerTest::testNestedTasks()
+{
+   QStereoTaskScheduler scheduler(4);
+
+   // Tasks spawned by a worker are queued locally and stolen by idle workers.
+   std::atomic<unsigned int> count(0);
+   scheduler.submit("spawn", [&scheduler, &count]
+   {
+      for (unsigned int i = 0; i < 100; ++i)
+         scheduler.submit("increment", [&count]{ ++count; });
+   });
+   scheduler.endFrame();
+   QCOMPARE(count.load(), 100u);
+}
+
+
+void
+QStereoTaskSchedulerTest::testFrameStatistics()
+{
+   QStereoTaskScheduler scheduler(2);
+   QStereoFrameStatistics statistics;
+
+   for (unsigned int i = 0; i < 10; ++i)
+      scheduler.submit("task", []{});
+   scheduler.endFrame(&statistics);
+
+   // Each task's execution time is recorded under its name.
+   QCOMPARE(statistics.taskNames(), QList<QByteArray>({"task"}));
+   QCOMPARE(statistics.taskHistogram("task")->snapshot().count, quint64(10));
+   QVERIFY(statistics.taskHistogram("other") == nullptr);
+   QVERIFY(statistics.toCsv().contains("task:task,10,"));
+
+   statistics.reset();
+   QCOMPARE(statistics.taskHistogram("task")->snapshot().count, quint64(0));
+}
+
+
+void
+QStereoTaskSchedulerTest::testConcurrentFrames()
+{
+   using Deadline = QStereoTaskScheduler::Deadline;
+   QStereoTaskScheduler scheduler(4);
+
+   // Frames begin while tasks that are due next frame are submitted, taken and promoted, which must
+   // neither lose a task nor leave one counted as ready once it has run.
+   const unsigned int taskCount = 10000;
+   std::atomic<unsigned int> count(0);
+   std::atomic<bool> submitted(false);
+   std::thread submitter([&scheduler, &count, &submitted]
+   {
+      for (unsigned int i = 0; i < taskCount; ++i)
+         scheduler.submit("next", [&count]{ ++count; }, Deadline::NextFrame);
+      submitted = true;
+   });
+   while (!submitted.load())
+   {
+      scheduler.beginFrame();
+      scheduler.endFrame();
+   }
+   submitter.join();
+
+   scheduler.beginFrame();
+   scheduler.endFrame();
+   QCOMPARE(count.load(), taskCount);
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::CurrentFrame), 0u);
+   QCOMPARE(scheduler.pendingTaskCount(Deadline::NextFrame), 0u);
+
+   // Workers that went idle still pick up new work.
+   const auto& handle = scheduler.submit("last", [&count]{ ++count; }, Deadline::None);
+   scheduler.wait(handle);
+   QCOMPARE(count.load(), taskCount + 1);
+}
@@ -0,0 +1,171 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereotextrenderer_test.h"
+#include "QStereoTextRenderer"
+#include <QtGui/QFontMetricsF>
+
+
+namespace
+{
+   int
+   coveredPixelCount(const QImage& image)
+   {
+      int count = 0;
+      for (int y = 0; y < image.height(); ++y)
+      {
+         for (int x = 0; x < image.width(); ++x)
+            count += qAlpha(image.pixel(x, y)) > 0 ? 1 : 0;
+      }
+      return count;
+   }
+}
+
+
+void
+QStereoTextRendererTest::testInitialState()
+{
+   const QStereoTextRenderer renderer;
+
+   QCOMPARE(renderer.atlas().size(), QSize(QStereoTextRenderer::atlasSize(), QStereoTextRenderer::atlasSize()));
+   QCOMPARE(renderer.glyphCount(), 0);
+   QCOMPARE(coveredPixelCount(renderer.atlas()), 0);
+   QVERIFY(renderer.boundingRect(0).isEmpty());
+}
+
+
+void
+QStereoTextRendererTest::testLayout()
+{
+   QStereoTextRenderer renderer;
+   const QPointF position(10.0, 20.0);
+
+   // A string is laid out from the start of its baseline, where y increases downwards.
+   const auto& single = renderer.addText("A", position);
+   const auto& bounds = renderer.boundingRect(single);
+   QVERIFY(!bounds.isEmpty());
+   QVERIFY(bounds.top() < position.y());
+   QVERIFY(bounds.left() < position.x() + 1.0);
+
+   // Glyphs follow each other along the baseline, and lines are a line spacing apart.
+   const auto& lineSpacing = QFontMetricsF(renderer.font()).lineSpacing();
+   const auto& row = renderer.boundingRect(renderer.addText("AA", position));
+   const auto& column = renderer.boundingRect(renderer.addText("A\nA", position));
+   QVERIFY(row.width() > bounds.width());
+   QCOMPARE(row.height(), bounds.height());
+   QCOMPARE(column.width(), bounds.width());
+   QCOMPARE(column.height(), bounds.height() + lineSpacing);
+
+   // Moving a string translates its quads.
+   renderer.setPosition(single, position + QPointF(5.0, -5.0));
+   QCOMPARE(renderer.boundingRect(single), bounds.translated(5.0, -5.0));
+
+   // Spaces take up room without drawing anything.
+   QVERIFY(renderer.boundingRect(renderer.addText(" ", position)).isEmpty());
+   const auto& spaced = renderer.boundingRect(renderer.addText("A A", position));
+   QVERIFY(spaced.width() > row.width());
+
+   renderer.removeText(single);
+   QVERIFY(renderer.boundingRect(single).isEmpty());
+}
+
+
+void
+QStereoTextRendererTest::testGlyphCache()
+{
+   QStereoTextRenderer renderer;
+
+   // Each code point is drawn into the atlas once, whichever strings use it.
+   renderer.addText("abc", QPointF());
+   QCOMPARE(renderer.glyphCount(), 3);
+   QVERIFY(coveredPixelCount(renderer.atlas()) > 0);
+
+   renderer.addText("cabbage", QPointF());
+   QCOMPARE(renderer.glyphCount(), 5);
+
+   // A character outside the Basic Multilingual Plane is a single glyph rather than two surrogates.
+   const uint face = 0x1f600;
+   renderer.addText(QString::fromUcs4(&face, 1), QPointF());
+   QCOMPARE(renderer.glyphCount(), 6);
+
+   // Glyphs belong to a font, so changing it starts a new atlas.
+   QFont font(renderer.font());
+   font.setPixelSize(2 * QFontMetricsF(font).height());
+   renderer.setFont(font);
+   QCOMPARE(renderer.glyphCount(), 6);
+}
+
+
+void
+QStereoTextRendererTest::testSetText()
+{
+   QStereoTextRenderer renderer;
+
+   const auto& id = renderer.addText("12:00", QPointF());
+   const auto& bounds = renderer.boundingRect(id);
+   QCOMPARE(renderer.glyphCount(), 4);
+
+   // Updating a string reuses the glyphs that are already cached.
+   renderer.setText(id, "10:02");
+   QCOMPARE(renderer.glyphCount(), 4);
+   renderer.setText(id, "13:00");
+   QCOMPARE(renderer.glyphCount(), 5);
+
+   renderer.setText(id, "12:00");
+   QCOMPARE(renderer.boundingRect(id), bounds);
+
+   // Unknown strings are ignored.
+   renderer.setText(id + 1, "ignored");
+   QCOMPARE(renderer.glyphCount(), 5);
+}
+
+
+void
+QStereoTextRendererTest::testFullAtlas()
+{
+   QFont font;
+   font.setPixelSize(200);
+   QStereoTextRenderer renderer(font);
+
+   // A string with more glyphs than the atlas holds draws as many of them as fit.
+   QString latin;
+   for (uint c = 0x21; c < 0x7f; ++c)
+      latin += QChar(c);
+   for (uint c = 0xc0; c <= 0xff; ++c)
+      latin += QChar(c);
+
+   QTest::ignoreMessage(QtWarningMsg, "[QtStereoscopy] Warning: The glyph atlas cannot hold every glyph in use. Some glyphs will not be drawn.");
+   const auto& full = renderer.addText(latin, QPointF());
+   QVERIFY(renderer.glyphCount() > 0);
+   QVERIFY(renderer.glyphCount() < latin.size());
+
+   // Once that string is removed, the atlas is rebuilt with only the glyphs in use, rather than dropping
+   // new glyphs until the font changes.
+   const QString greek = QString::fromUtf8("\xce\xb1\xce\xb2\xce\xb3\xce\xb4");
+   renderer.removeText(full);
+   const auto& id = renderer.addText(greek, QPointF());
+   QCOMPARE(renderer.glyphCount(), 4);
+
+   QStereoTextRenderer reference(font);
+   QCOMPARE(renderer.boundingRect(id), reference.boundingRect(reference.addText(greek, QPointF())));
+}
@@ -0,0 +1,180 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2014 Jeremy Othieno.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "qstereovideoencoder_test.h"
+#include "QStereoVideoEncoder"
+
+
+namespace
+{
+QStereoFrameCapture::Frame
+uniformFrame(const QSize& size, const uchar& r, const uchar& g, const uchar& b)
+{
+   QByteArray pixels(size.width() * size.height() * 4, Qt::Uninitialized);
+   for (int i = 0; i < pixels.size(); i += 4)
+   {
+      pixels[i + 0] = static_cast<char>(r);
+      pixels[i + 1] = static_cast<char>(g);
+      pixels[i + 2] = static_cast<char>(b);
+      pixels[i + 3] = static_cast<char>(255);
+   }
+   return QStereoFrameCapture::Frame({pixels, size, 0, 0});
+}
+
+
+QByteArray
+convert(const QStereoFrameCapture::Frame& frame, const QSize& size)
+{
+   const auto& planeSize = size.width() * size.height();
+   QByteArray output(planeSize + (planeSize >> 1), Qt::Uninitialized);
+   QStereoVideoEncoder::convertToI420(frame, size, reinterpret_cast<uchar*>(output.data()));
+   return output;
+}
+
+
+// A straightforward conversion the vectorized one is checked against.
+QByteArray
+referenceConversion(const QStereoFrameCapture::Frame& frame, const QSize& size)
+{
+   const auto& width = size.width();
+   const auto& height = size.height();
+   const auto* const pixels = reinterpret_cast<const uchar*>(frame.pixels.constData());
+   const auto& pixel = [&frame, pixels](const int& x, const int& y, const int& channel)
+   {
+      return static_cast<int>(pixels[((frame.size.height() - 1 - y) * frame.size.width() + x) * 4 + channel]);
+   };
+
+   QByteArray output;
+   for (int y = 0; y < height; ++y)
+   {
+      for (int x = 0; x < width; ++x)
+      {
+         const auto& r = pixel(x, y, 0);
+         const auto& g = pixel(x, y, 1);
+         const auto& b = pixel(x, y, 2);
+         output.append(static_cast<char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16));
+      }
+   }
+
+   QByteArray U, V;
+   for (int y = 0; y < height; y += 2)
+   {
+      for (int x = 0; x < width; x += 2)
+      {
+         int average[3];
+         for (int c = 0; c < 3; ++c)
+            average[c] = (pixel(x, y, c) + pixel(x + 1, y, c) + pixel(x, y + 1, c) + pixel(x + 1, y + 1, c) + 2) >> 2;
+
+         const auto& r = average[0];
+         const auto& g = average[1];
+         const auto& b = average[2];
+         U.append(static_cast<char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128));
+         V.append(static_cast<char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128));
+      }
+   }
+   return output + U + V;
+}
+} // namespace
+
+
+void
+QStereoVideoEncoderTest::testStreamHeader()
+{
+   QCOMPARE(QStereoVideoEncoder::streamHeader(QSize(1920, 1080), 75),
+            QByteArray("YUV4MPEG2 W1920 H1080 F75:1 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n"));
+   QCOMPARE(QStereoVideoEncoder::streamHeader(QSize(2, 4), 1),
+            QByteArray("YUV4MPEG2 W2 H4 F1:1 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n"));
+}
+
+
+void
+QStereoVideoEncoderTest::testUniformColors()
+{
+   // The size covers both the vectorized and the scalar paths.
+   const QSize size(20, 4);
+   const auto& planeSize = size.width() * size.height();
+
+   const auto& white = convert(uniformFrame(size, 255, 255, 255), size);
+   QCOMPARE(white, QByteArray(planeSize, static_cast<char>(235)) + QByteArray(planeSize >> 1, static_cast<char>(128)));
+
+   const auto& black = convert(uniformFrame(size, 0, 0, 0), size);
+   QCOMPARE(black, QByteArray(planeSize, static_cast<char>(16)) + QByteArray(planeSize >> 1, static_cast<char>(128)));
+
+   const auto& red = convert(uniformFrame(size, 255, 0, 0), size);
+   QCOMPARE(red, QByteArray(planeSize, static_cast<char>(82)) +
+                 QByteArray(planeSize >> 2, static_cast<char>(90)) +
+                 QByteArray(planeSize >> 2, static_cast<char>(240)));
+}
+
+
+void
+QStereoVideoEncoderTest::testRowFlip()
+{
+   // The bottom row of the read-back is white, so it must end up as the last row of the luma plane.
+   const QSize size(8, 2);
+   auto frame = uniformFrame(size, 0, 0, 0);
+   frame.pixels.replace(0, size.width() * 4, QByteArray(size.width() * 4, static_cast<char>(255)));
+
+   const auto& output = convert(frame, size);
+   QCOMPARE(output.left(size.width()), QByteArray(size.width(), static_cast<char>(16)));
+   QCOMPARE(output.mid(size.width(), size.width()), QByteArray(size.width(), static_cast<char>(235)));
+}
+
+
+void
+QStereoVideoEncoderTest::testOddSize()
+{
+   // An odd-sized frame is cropped to its even size, keeping its top-left corner.
+   const QSize frameSize(7, 5);
+   const QSize size(6, 4);
+   auto frame = uniformFrame(frameSize, 255, 255, 255);
+   for (int y = 0; y < frameSize.height(); ++y)
+   {
+      for (int x = 0; x < frameSize.width(); ++x)
+      {
+         const auto& offset = (y * frameSize.width() + x) * 4;
+         const auto& value = static_cast<char>((x * 31 + y * 17) & 0xFF);
+         frame.pixels[offset + 0] = value;
+         frame.pixels[offset + 1] = static_cast<char>(value ^ 0x5A);
+         frame.pixels[offset + 2] = static_cast<char>(255 - value);
+      }
+   }
+   QCOMPARE(convert(frame, size), referenceConversion(frame, size));
+}
+
+
+void
+QStereoVideoEncoderTest::testReferenceConversion()
+{
+   // The width isn't a multiple of eight, so that both the vectorized and the scalar paths are exercised.
+   const QSize size(38, 6);
+   auto frame = uniformFrame(size, 0, 0, 0);
+
+   quint32 seed = 0x2545F491;
+   for (auto& value : frame.pixels)
+   {
+      seed = seed * 1664525 + 1013904223;
+      value = static_cast<char>(seed >> 24);
+   }
+   QCOMPARE(convert(frame, size), referenceConversion(frame, size));
+}
@@ -0,0 +1,41 @@
+include(../../../install/common.pri)
+include(../unit.pri)
+
+TARGET = stereoscopy_testsuite
+
+HEADERS +=\
+   qstereocompositorlayer_test.h\
+   qstereoframestatistics_test.h\
+   qstereoframetiming_test.h\
+   qstereohistogram_test.h\
+   qstereolatelatch_test.h\
+   qstereomirrorwindow_test.h\
+   qstereoposepredictor_test.h\
+   qstereoprojectionsettings_test.h\
+   qstereorenderloop_test.h\
+   qstereorenderpolicy_test.h\
+   qstereoreprojection_test.h\
+   qstereoresourceloader_test.h\
+   qstereotaskscheduler_test.h\
+   qstereotextrenderer_test.h\
+   qstereotrace_test.h\
+   qstereovideoencoder_test.h
+
+SOURCES +=\
+   qstereocompositorlayer_test.cpp\
+   qstereoframestatistics_test.cpp\
+   qstereoframetiming_test.cpp\
+   qstereohistogram_test.cpp\
+   qstereolatelatch_test.cpp\
+   qstereomirrorwindow_test.cpp\
+   qstereoposepredictor_test.cpp\
+   qstereoprojectionsettings_test.cpp\
+   qstereorenderloop_test.cpp\
+   qstereorenderpolicy_test.cpp\
+   qstereoreprojection_test.cpp\
+   qstereoresourceloader_test.cpp\
+   qstereotaskscheduler_test.cpp\
+   qstereotextrenderer_test.cpp\
+   qstereotrace_test.cpp\
+   qstereovideoencoder_test.cpp\
+   stereoscopy_testsuite.cpp
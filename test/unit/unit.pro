@@ -1,2 +1,2 @@
 TEMPLATE = subdirs
-SUBDIRS = oculusvr_testsuite
+SUBDIRS = stereoscopy_testsuite oculusvr_testsuite simulated_testsuite